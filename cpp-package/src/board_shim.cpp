@@ -70,6 +70,24 @@ void BoardShim::set_log_level (int log_level)
     }
 }
 
+void BoardShim::set_shared_reactor_threads (int num_threads)
+{
+    int res = ::set_shared_reactor_threads (num_threads);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set shared reactor threads", res);
+    }
+}
+
+void BoardShim::set_packet_capture (int mode, std::string file, double rate)
+{
+    int res = ::set_packet_capture (mode, const_cast<char *> (file.c_str ()), rate);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set packet capture", res);
+    }
+}
+
 void BoardShim::log_message (int log_level, const char *format, ...)
 {
     char buffer[1024];
@@ -156,6 +174,18 @@ int BoardShim::get_board_data_count ()
     return data_count;
 }
 
+int BoardShim::get_dropped_data_count ()
+{
+    int data_count = 0;
+    int res = ::get_dropped_data_count (
+        &data_count, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get dropped data count", res);
+    }
+    return data_count;
+}
+
 double **BoardShim::get_board_data (int *num_data_points)
 {
     int num_samples = get_board_data_count ();
@@ -203,6 +233,121 @@ double **BoardShim::get_current_board_data (int num_samples, int *num_data_point
     return output_buf;
 }
 
+double **BoardShim::get_board_data_range (double start_time, double end_time, int *num_data_points)
+{
+    int num_samples = 0;
+    int res = ::get_board_data_range_count (start_time, end_time, &num_samples, board_id,
+        const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get board data range count", res);
+    }
+    int num_data_channels = BoardShim::get_num_rows (get_board_id ());
+    double *buf = new double[num_samples * num_data_channels];
+    res = ::get_board_data_range (start_time, end_time, num_samples, buf, num_data_points,
+        board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] buf;
+        throw BrainFlowException ("failed to get board data range", res);
+    }
+
+    double **output_buf = new double *[num_data_channels];
+    for (int i = 0; i < num_data_channels; i++)
+    {
+        output_buf[i] = new double[*num_data_points];
+    }
+    reshape_data (*num_data_points, buf, output_buf);
+    delete[] buf;
+
+    return output_buf;
+}
+
+double **BoardShim::get_board_data_envelope (
+    double start_time, double end_time, int num_points, int *returned_points)
+{
+    int num_rows = BoardShim::get_num_rows (get_board_id ());
+    double *buf = new double[(size_t)3 * num_rows * num_points];
+    int res = ::get_board_data_envelope (start_time, end_time, num_points, buf,
+        buf + (size_t)num_rows * num_points, buf + (size_t)2 * num_rows * num_points,
+        returned_points, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] buf;
+        throw BrainFlowException ("failed to get board data envelope", res);
+    }
+
+    double **output_buf = new double *[3 * num_rows];
+    for (int i = 0; i < 3 * num_rows; i++)
+    {
+        // each of three parts has returned_points columns
+        const double *part = buf + (size_t)(i / num_rows) * num_rows * num_points;
+        output_buf[i] = new double[*returned_points];
+        memcpy (output_buf[i], part + (size_t)(i % num_rows) * (*returned_points),
+            sizeof (double) * (*returned_points));
+    }
+    delete[] buf;
+
+    return output_buf;
+}
+
+void BoardShim::add_consumer_cursor (char *cursor_name)
+{
+    int res = ::add_consumer_cursor (
+        cursor_name, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to add consumer cursor", res);
+    }
+}
+
+void BoardShim::remove_consumer_cursor (char *cursor_name)
+{
+    int res = ::remove_consumer_cursor (
+        cursor_name, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to remove consumer cursor", res);
+    }
+}
+
+int BoardShim::get_cursor_data_count (char *cursor_name)
+{
+    int data_count = 0;
+    int res = ::get_cursor_data_count (
+        cursor_name, &data_count, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get cursor data count", res);
+    }
+    return data_count;
+}
+
+double **BoardShim::get_cursor_data (char *cursor_name, int *num_data_points, int *lost_samples)
+{
+    int num_samples = get_cursor_data_count (cursor_name);
+    int num_data_channels = BoardShim::get_num_rows (get_board_id ());
+    // new packages may arrive between calls, they will be returned by the next read
+    double *buf = new double[(size_t)num_samples * num_data_channels];
+    int res = ::get_cursor_data (cursor_name, num_samples, buf, num_data_points, lost_samples,
+        board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] buf;
+        throw BrainFlowException ("failed to get cursor data", res);
+    }
+
+    double **output_buf = new double *[num_data_channels];
+    for (int i = 0; i < num_data_channels; i++)
+    {
+        output_buf[i] = new double[*num_data_points];
+    }
+    reshape_data (*num_data_points, buf, output_buf);
+    delete[] buf;
+
+    return output_buf;
+}
+
 std::string BoardShim::config_board (char *config)
 {
     int response_len = 0;
@@ -217,6 +362,30 @@ std::string BoardShim::config_board (char *config)
     return resp;
 }
 
+void BoardShim::set_acquisition_thread_settings (char *json_settings)
+{
+    int res = ::set_acquisition_thread_settings (
+        json_settings, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set acquisition thread settings", res);
+    }
+}
+
+std::string BoardShim::get_acquisition_thread_settings ()
+{
+    int len = 0;
+    char settings[8192];
+    int res = ::get_acquisition_thread_settings (
+        settings, &len, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get acquisition thread settings", res);
+    }
+    std::string result ((const char *)settings, len);
+    return result;
+}
+
 void BoardShim::insert_marker (double value)
 {
     int res = ::insert_marker (value, board_id, const_cast<char *> (serialized_params.c_str ()));
@@ -226,6 +395,65 @@ void BoardShim::insert_marker (double value)
     }
 }
 
+void BoardShim::set_buffer_spill_file (char *spill_file, int hot_buffer_size)
+{
+    int res = ::set_buffer_spill_file (
+        spill_file, hot_buffer_size, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set buffer spill file", res);
+    }
+}
+
+void BoardShim::set_buffer_storage_mode (int storage_mode)
+{
+    int res = ::set_buffer_storage_mode (
+        storage_mode, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set buffer storage mode", res);
+    }
+}
+
+void BoardShim::set_buffer_summary (bool enabled)
+{
+    int res = ::set_buffer_summary (
+        (int)enabled, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set buffer summary", res);
+    }
+}
+
+void BoardShim::set_spatial_filter (double *filter, int num_channels)
+{
+    int res = ::set_spatial_filter (
+        filter, num_channels, board_id, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set spatial filter", res);
+    }
+}
+
+void BoardShim::set_common_average_reference (bool enabled)
+{
+    if (!enabled)
+    {
+        set_spatial_filter (NULL, 0);
+        return;
+    }
+    int num_channels = 0;
+    int *channels = BoardShim::get_eeg_channels (board_id, &num_channels);
+    delete[] channels;
+    // x - mean (x) for each channel
+    std::vector<double> filter ((size_t)num_channels * num_channels, -1.0 / num_channels);
+    for (int i = 0; i < num_channels; i++)
+    {
+        filter[(size_t)i * num_channels + i] += 1.0;
+    }
+    set_spatial_filter (filter.data (), num_channels);
+}
+
 // for better user experience and consistency accross bindings we return 2d array from user api, we
 // can not do it directly in low level api because some languages can not pass multidim array to C++
 void BoardShim::reshape_data (int num_data_points, double *linear_buffer, double **output_buf)
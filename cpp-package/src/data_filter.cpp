@@ -3,6 +3,7 @@
 #include "brainflow_constants.h"
 #include "data_filter.h"
 #include "data_handler.h"
+#include "scratch_arena.h"
 
 
 void DataFilter::perform_lowpass (double *data, int data_len, int sampling_rate, double cutoff,
@@ -143,10 +144,10 @@ double *DataFilter::get_window (int window_function, int window_len)
 
 std::complex<double> *DataFilter::perform_fft (double *data, int data_len, int window)
 {
-    if ((data_len & (data_len - 1)) || (data_len <= 0))
+    if (data_len <= 0)
     {
         throw BrainFlowException (
-            "data len is not power of 2", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+            "data len must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
     std::complex<double> *output = new std::complex<double>[data_len / 2 + 1];
     double *temp_re = new double[data_len / 2 + 1];
@@ -184,10 +185,10 @@ void DataFilter::detrend (double *data, int data_len, int detrend_operation)
 std::pair<double *, double *> DataFilter::get_psd (
     double *data, int data_len, int sampling_rate, int window)
 {
-    if ((data_len & (data_len - 1)) || (data_len <= 0))
+    if (data_len <= 0)
     {
         throw BrainFlowException (
-            "data len is not power of 2", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+            "data len must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
     double *ampl = new double[data_len / 2 + 1];
     double *freq = new double[data_len / 2 + 1];
@@ -204,10 +205,10 @@ std::pair<double *, double *> DataFilter::get_psd (
 std::pair<double *, double *> DataFilter::get_psd_welch (
     double *data, int data_len, int nfft, int overlap, int sampling_rate, int window)
 {
-    if ((nfft & (nfft - 1)) || (nfft <= 0))
+    if (nfft <= 0)
     {
         throw BrainFlowException (
-            "nfft is not power of 2", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+            "nfft must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
     double *ampl = new double[nfft / 2 + 1];
     double *freq = new double[nfft / 2 + 1];
@@ -221,6 +222,53 @@ std::pair<double *, double *> DataFilter::get_psd_welch (
     return std::make_pair (ampl, freq);
 }
 
+std::pair<double *, double *> DataFilter::get_psd_multitaper (
+    double *data, int data_len, int sampling_rate, double nw, int num_tapers)
+{
+    if (data_len <= 0)
+    {
+        throw BrainFlowException (
+            "data len must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    double *ampl = new double[data_len / 2 + 1];
+    double *freq = new double[data_len / 2 + 1];
+    int res = ::get_psd_multitaper (data, data_len, sampling_rate, nw, num_tapers, ampl, freq);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] ampl;
+        delete[] freq;
+        throw BrainFlowException ("failed to get psd multitaper", res);
+    }
+    return std::make_pair (ampl, freq);
+}
+
+std::pair<double *, double *> DataFilter::get_multichannel_psd_multitaper (double **data, int cols,
+    int *channels, int channels_len, int sampling_rate, double nw, int num_tapers)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols <= 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *ampl = new double[channels_len * (cols / 2 + 1)];
+    double *freq = new double[cols / 2 + 1];
+    int res = ::get_multichannel_psd_multitaper (
+        data_1d, channels_len, cols, sampling_rate, nw, num_tapers, ampl, freq);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] ampl;
+        delete[] freq;
+        throw BrainFlowException ("failed to get psd multitaper", res);
+    }
+    return std::make_pair (ampl, freq);
+}
+
 std::pair<double *, double *> DataFilter::get_avg_band_powers (
     double **data, int cols, int *channels, int channels_len, int sampling_rate, bool apply_filters)
 {
@@ -229,7 +277,8 @@ std::pair<double *, double *> DataFilter::get_avg_band_powers (
         throw BrainFlowException (
             "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
-    double *data_1d = new double[cols * channels_len];
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
     double *avg_bands = new double[5];
     double *stddev_bands = new double[5];
     // init by zeros to make valgrind happy
@@ -251,13 +300,209 @@ std::pair<double *, double *> DataFilter::get_avg_band_powers (
     {
         delete[] avg_bands;
         delete[] stddev_bands;
-        delete[] data_1d;
         throw BrainFlowException ("failed to get_avg_band_powers", res);
     }
-    delete[] data_1d;
     return std::make_pair (avg_bands, stddev_bands);
 }
 
+int DataFilter::create_spectrogram (
+    int num_channels, int nfft, int hop, int sampling_rate, int window, bool log_power)
+{
+    int spectrogram_id = 0;
+    int res = ::create_spectrogram (
+        num_channels, nfft, hop, sampling_rate, window, (int)log_power, &spectrogram_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create spectrogram", res);
+    }
+    return spectrogram_id;
+}
+
+double *DataFilter::update_spectrogram (int spectrogram_id, double **data, int cols,
+    int *channels, int channels_len, int *num_columns, int *num_bins)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols < 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    int max_columns = 0;
+    int res = ::get_spectrogram_output_shape (spectrogram_id, cols, &max_columns, num_bins);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to update spectrogram", res);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            data_1d[j + cols * i] = data[channels[i]][j];
+        }
+    }
+    double *output = new double[max_columns * channels_len * (*num_bins)];
+    res = ::update_spectrogram (
+        spectrogram_id, data_1d, channels_len, cols, max_columns, output, num_columns);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] output;
+        throw BrainFlowException ("failed to update spectrogram", res);
+    }
+    return output;
+}
+
+void DataFilter::release_spectrogram (int spectrogram_id)
+{
+    int res = ::release_spectrogram (spectrogram_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release spectrogram", res);
+    }
+}
+
+int DataFilter::create_hilbert_filter (int num_channels, int num_taps)
+{
+    int filter_id = 0;
+    int res = ::create_hilbert_filter (num_channels, num_taps, &filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create hilbert filter", res);
+    }
+    return filter_id;
+}
+
+std::pair<double *, double *> DataFilter::update_hilbert_filter (
+    int filter_id, double **data, int cols, int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols < 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *envelope = new double[cols * channels_len];
+    double *phase = new double[cols * channels_len];
+    int res = ::update_hilbert_filter (filter_id, data_1d, channels_len, cols, envelope, phase);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] envelope;
+        delete[] phase;
+        throw BrainFlowException ("failed to update hilbert filter", res);
+    }
+    return std::make_pair (envelope, phase);
+}
+
+void DataFilter::release_hilbert_filter (int filter_id)
+{
+    int res = ::release_hilbert_filter (filter_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release hilbert filter", res);
+    }
+}
+
+int DataFilter::create_ssvep_detector (int num_channels, int sampling_rate, double *target_freqs,
+    int num_targets, int num_harmonics, int window_len)
+{
+    int detector_id = 0;
+    int res = ::create_ssvep_detector (num_channels, sampling_rate, target_freqs, num_targets,
+        num_harmonics, window_len, &detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create ssvep detector", res);
+    }
+    return detector_id;
+}
+
+void DataFilter::update_ssvep_detector (int detector_id, double **data, int cols, int *channels,
+    int channels_len, double *scores)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols < 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    int res = ::update_ssvep_detector (detector_id, data_1d, channels_len, cols, scores);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to update ssvep detector", res);
+    }
+}
+
+void DataFilter::release_ssvep_detector (int detector_id)
+{
+    int res = ::release_ssvep_detector (detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release ssvep detector", res);
+    }
+}
+
+int DataFilter::create_artifact_detector (int num_channels, int sampling_rate, int window_len,
+    double max_peak_to_peak, double min_std, double max_std, double line_freq,
+    double max_line_noise_ratio, bool interpolate)
+{
+    int detector_id = 0;
+    int res = ::create_artifact_detector (num_channels, sampling_rate, window_len,
+        max_peak_to_peak, min_std, max_std, line_freq, max_line_noise_ratio, (int)interpolate,
+        &detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create artifact detector", res);
+    }
+    return detector_id;
+}
+
+int *DataFilter::update_artifact_detector (
+    int detector_id, double **data, int cols, int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols < 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    int *flags = new int[cols * channels_len];
+    int res = ::update_artifact_detector (detector_id, data_1d, channels_len, cols, flags);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] flags;
+        throw BrainFlowException ("failed to update artifact detector", res);
+    }
+    // copy back interpolated datapoints
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data[channels[i]], data_1d + i * cols, sizeof (double) * cols);
+    }
+    return flags;
+}
+
+void DataFilter::release_artifact_detector (int detector_id)
+{
+    int res = ::release_artifact_detector (detector_id);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to release artifact detector", res);
+    }
+}
+
 double DataFilter::get_band_power (
     std::pair<double *, double *> psd, int data_len, double freq_start, double freq_end)
 {
@@ -270,12 +515,232 @@ double DataFilter::get_band_power (
     return band_power;
 }
 
+double *DataFilter::get_band_powers (std::pair<double *, double *> psd, int data_len,
+    double *freq_starts, double *freq_ends, int num_bands)
+{
+    if (num_bands < 1)
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    double *band_powers = new double[num_bands];
+    int res = ::get_band_powers (
+        psd.first, psd.second, data_len, freq_starts, freq_ends, num_bands, band_powers);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] band_powers;
+        throw BrainFlowException ("failed to get band powers", res);
+    }
+    return band_powers;
+}
+
+double *DataFilter::get_multichannel_band_powers (double **ampls, int num_channels, double *freq,
+    int data_len, double *freq_starts, double *freq_ends, int num_bands)
+{
+    if ((ampls == NULL) || (num_channels < 1) || (num_bands < 1) || (data_len < 2))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *ampls_1d = scratch.alloc<double> (num_channels * data_len);
+    for (int i = 0; i < num_channels; i++)
+    {
+        memcpy (ampls_1d + i * data_len, ampls[i], sizeof (double) * data_len);
+    }
+    double *band_powers = new double[num_channels * num_bands];
+    int res = ::get_multichannel_band_powers (ampls_1d, num_channels, freq, data_len, freq_starts,
+        freq_ends, num_bands, band_powers);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] band_powers;
+        throw BrainFlowException ("failed to get band powers", res);
+    }
+    return band_powers;
+}
+
+double *DataFilter::apply_spatial_filter (double *filter, int num_outputs, double **data, int cols,
+    int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (num_outputs < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *output = new double[num_outputs * cols];
+    int res = ::apply_spatial_filter (filter, num_outputs, data_1d, channels_len, cols, output);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] output;
+        throw BrainFlowException ("failed to apply spatial filter", res);
+    }
+    return output;
+}
+
+void DataFilter::perform_common_average_reference (
+    double **data, int cols, int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    int res = ::perform_common_average_reference (data_1d, channels_len, cols);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to perform common average reference", res);
+    }
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data[channels[i]], data_1d + i * cols, sizeof (double) * cols);
+    }
+}
+
+std::pair<double *, double *> DataFilter::get_epochs (double **data, int cols, int marker_channel,
+    int *channels, int channels_len, int pre_samples, int post_samples, bool apply_baseline,
+    int *num_epochs)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols < 1) ||
+        (num_epochs == NULL))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    // copy only marker row and selected channels, marker row goes first
+    int num_rows = channels_len + 1;
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * num_rows);
+    int *rows = new int[channels_len];
+    memcpy (data_1d, data[marker_channel], sizeof (double) * cols);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + (i + 1) * cols, data[channels[i]], sizeof (double) * cols);
+        rows[i] = i + 1;
+    }
+    int max_epochs = 0;
+    int res = ::get_num_epochs (data_1d, num_rows, cols, 0, pre_samples, post_samples, &max_epochs);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] rows;
+        throw BrainFlowException ("failed to get epochs", res);
+    }
+    double *epochs = new double[max_epochs * channels_len * (pre_samples + post_samples)];
+    double *markers = new double[max_epochs];
+    res = ::get_epochs (data_1d, num_rows, cols, 0, rows, channels_len, pre_samples, post_samples,
+        (int)apply_baseline, max_epochs, epochs, markers, num_epochs);
+    delete[] rows;
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] epochs;
+        delete[] markers;
+        throw BrainFlowException ("failed to get epochs", res);
+    }
+    return std::make_pair (epochs, markers);
+}
+
+std::pair<std::complex<double> *, double *> DataFilter::get_csd_welch (double **data, int cols,
+    int *channels, int channels_len, int nfft, int overlap, int sampling_rate, int window)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (nfft < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    int matrices_len = (nfft / 2 + 1) * channels_len * channels_len;
+    double *re = new double[matrices_len];
+    double *im = new double[matrices_len];
+    double *freq = new double[nfft / 2 + 1];
+    int res = ::get_csd_welch (
+        data_1d, channels_len, cols, nfft, overlap, sampling_rate, window, re, im, freq);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] re;
+        delete[] im;
+        delete[] freq;
+        throw BrainFlowException ("failed to get_csd_welch", res);
+    }
+    std::complex<double> *csd = new std::complex<double>[matrices_len];
+    for (int i = 0; i < matrices_len; i++)
+    {
+        csd[i] = std::complex<double> (re[i], im[i]);
+    }
+    delete[] re;
+    delete[] im;
+    return std::make_pair (csd, freq);
+}
+
+double *DataFilter::get_coherence (double **data, int cols, int *channels, int channels_len,
+    int nfft, int overlap, int sampling_rate, int window, double freq_start, double freq_end)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *output = new double[channels_len * channels_len];
+    int res = ::get_coherence (data_1d, channels_len, cols, nfft, overlap, sampling_rate, window,
+        freq_start, freq_end, output);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] output;
+        throw BrainFlowException ("failed to get coherence", res);
+    }
+    return output;
+}
+
+double *DataFilter::get_covariance_matrix (double **data, int cols, int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *output = new double[channels_len * channels_len];
+    int res = ::get_covariance_matrix (data_1d, channels_len, cols, output);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] output;
+        throw BrainFlowException ("failed to get covariance matrix", res);
+    }
+    return output;
+}
+
 double *DataFilter::perform_ifft (std::complex<double> *data, int data_len)
 {
-    if ((data_len & (data_len - 1)) || (data_len <= 0))
+    if (data_len <= 0)
     {
         throw BrainFlowException (
-            "data len is not power of 2", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+            "data len must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
     }
     double *output = new double[data_len];
     double *temp_re = new double[data_len / 2 + 1];
@@ -297,6 +762,52 @@ double *DataFilter::perform_ifft (std::complex<double> *data, int data_len)
     return output;
 }
 
+std::pair<double *, double *> DataFilter::perform_hilbert_transform (double *data, int data_len)
+{
+    if (data_len <= 0)
+    {
+        throw BrainFlowException (
+            "data len must be positive", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    double *envelope = new double[data_len];
+    double *phase = new double[data_len];
+    int res = ::perform_hilbert_transform (data, data_len, envelope, phase);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] envelope;
+        delete[] phase;
+        throw BrainFlowException ("failed to perform hilbert transform", res);
+    }
+    return std::make_pair (envelope, phase);
+}
+
+std::pair<double *, double *> DataFilter::perform_multichannel_hilbert_transform (
+    double **data, int cols, int *channels, int channels_len)
+{
+    if ((data == NULL) || (channels == NULL) || (channels_len < 1) || (cols <= 0))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> (cols * channels_len);
+    for (int i = 0; i < channels_len; i++)
+    {
+        memcpy (data_1d + i * cols, data[channels[i]], sizeof (double) * cols);
+    }
+    double *envelope = new double[cols * channels_len];
+    double *phase = new double[cols * channels_len];
+    int res =
+        ::perform_multichannel_hilbert_transform (data_1d, channels_len, cols, envelope, phase);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] envelope;
+        delete[] phase;
+        throw BrainFlowException ("failed to perform hilbert transform", res);
+    }
+    return std::make_pair (envelope, phase);
+}
+
 int DataFilter::get_nearest_power_of_two (int value)
 {
     int output = 0;
@@ -335,6 +846,47 @@ double **DataFilter::read_file (int *num_rows, int *num_cols, char *file_name)
     return output_buf;
 }
 
+void DataFilter::create_file_summary (char *file_name, char *summary_file)
+{
+    int res = ::create_file_summary (file_name, summary_file);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to create file summary", res);
+    }
+}
+
+double **DataFilter::get_file_envelope (char *summary_file, int start_sample, int end_sample,
+    int num_points, int *num_rows, int *returned_points)
+{
+    int num_samples = 0;
+    int res = get_file_summary_info (summary_file, num_rows, &num_samples);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to read file summary", res);
+    }
+    size_t part_len = (size_t)(*num_rows) * num_points;
+    double *buf = new double[3 * part_len];
+    res = ::get_file_envelope (summary_file, start_sample, end_sample, num_points, buf,
+        buf + part_len, buf + 2 * part_len, returned_points);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] buf;
+        throw BrainFlowException ("failed to get file envelope", res);
+    }
+    double **output_buf = new double *[3 * (*num_rows)];
+    for (int i = 0; i < 3 * (*num_rows); i++)
+    {
+        // each of three parts has returned_points columns
+        const double *part = buf + (size_t)(i / (*num_rows)) * part_len;
+        output_buf[i] = new double[*returned_points];
+        memcpy (output_buf[i], part + (size_t)(i % (*num_rows)) * (*returned_points),
+            sizeof (double) * (*returned_points));
+    }
+    delete[] buf;
+
+    return output_buf;
+}
+
 void DataFilter::write_file (
     double **data, int num_rows, int num_cols, char *file_name, char *file_mode)
 {
@@ -386,6 +938,26 @@ void DataFilter::set_log_level (int log_level)
     }
 }
 
+void DataFilter::set_num_threads (int num_threads)
+{
+    int res = ::set_num_threads (num_threads);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to set number of threads", res);
+    }
+}
+
+int DataFilter::get_num_threads ()
+{
+    int num_threads = 0;
+    int res = ::get_num_threads (&num_threads);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get number of threads", res);
+    }
+    return num_threads;
+}
+
 void DataFilter::enable_data_logger ()
 {
     DataFilter::set_log_level ((int)LogLevels::LEVEL_INFO);
@@ -36,6 +36,20 @@ public:
     static void set_log_level (int log_level);
     /// write user defined string to BrainFlow logger
     static void log_message (int log_level, const char *format, ...);
+    /**
+     * read sockets of network boards on num_threads shared threads instead of a thread per session, linux only
+     * @param num_threads 0 to disable, boards which are already streaming keep their readers
+     * @throw BrainFlowException If called while sessions are streaming via reactor exit code is STREAM_ALREADY_RUN_ERROR
+     */
+    static void set_shared_reactor_threads (int num_threads);
+    /**
+     * record raw bytes received from serial ports and udp sockets or replay them instead of device, applied to sessions prepared after this call
+     * @param mode one of PacketCaptureModes
+     * @param file capture file, if session opens several transports they use file, file.1, file.2 and so on
+     * @param rate replay speed relative to recorded timestamps, 0 to replay as fast as possible
+     * @throw BrainFlowException If arguments are invalid exit code is INVALID_ARGUMENTS_ERROR
+     */
+    static void set_packet_capture (int mode, std::string file = "", double rate = 0.0);
 
     /**
      * get sampling rate for this board
@@ -193,11 +207,74 @@ public:
     int get_board_id ();
     /// get number of packages in ringbuffer
     int get_board_data_count ();
+    /// get number of packages dropped because ringbuffer with spill file couldnt store them
+    int get_dropped_data_count ();
     /// get all collected data and flush it from internal buffer
     double **get_board_data (int *num_data_points);
+    /**
+     * get data with timestamps in [start_time, end_time), doesnt remove it from ringbuffer
+     * @param start_time unix timestamp in seconds, the same as in timestamp channel
+     * @param end_time unix timestamp in seconds, not included
+     */
+    double **get_board_data_range (double start_time, double end_time, int *num_data_points);
+    /**
+     * get min, max and mean of each channel for num_points equal parts of [start_time, end_time) to draw long recordings
+     * @param num_points max number of points, usually width of the plot in pixels
+     * @param returned_points number of points, less than num_points if there are fewer packages in range
+     * @return 3 * num_rows rows: mins of all rows, then maxes, then means
+     */
+    double **get_board_data_envelope (
+        double start_time, double end_time, int num_points, int *returned_points);
+    /**
+     * register named read position, each cursor gets all packages regardless of get_board_data and other cursors
+     * @param cursor_name unique name of consumer, cursor is kept across start_stream calls
+     */
+    void add_consumer_cursor (char *cursor_name);
+    /// unregister cursor created by add_consumer_cursor
+    void remove_consumer_cursor (char *cursor_name);
+    /// get number of packages which were not read by this cursor yet
+    int get_cursor_data_count (char *cursor_name);
+    /**
+     * get packages added after the last read by this cursor, doesnt affect other consumers
+     * @param lost_samples number of packages overwritten in ringbuffer before this cursor read them
+     */
+    double **get_cursor_data (char *cursor_name, int *num_data_points, int *lost_samples);
     /// send string to a board, use it carefully and only if you understand what you are doing
     std::string config_board (char *config);
+    /**
+     * pin acquisition thread to cpus and set its scheduling, applied on next start_stream
+     * @param json_settings json like {"cpus": [2, 3], "policy": "fifo", "priority": 50, "nice": -5, "name": "eeg"}, all fields are optional, policy is one of other, fifo, rr
+     * @throw BrainFlowException If settings are invalid exit code is INVALID_ARGUMENTS_ERROR
+     */
+    void set_acquisition_thread_settings (char *json_settings);
+    /// json with requested and actually applied settings of acquisition thread and errors of applying them
+    std::string get_acquisition_thread_settings ();
     /// insert marker in data stream
     void insert_marker (double value);
+    /**
+     * keep only hot_buffer_size latest packages in RAM and move older ones to spill file,
+     * should be called before start_stream, allows buffer_size to exceed one day of data
+     * @param spill_file path to temporary file, it is removed in release_session, empty string disables spilling
+     * @param hot_buffer_size number of packages kept in RAM
+     */
+    void set_buffer_spill_file (char *spill_file, int hot_buffer_size);
+    /**
+     * store channels in ringbuffer as float32 or raw ADC counts to save memory, should be called before start_stream
+     * @param storage_mode value from BufferStorageModes, timestamps and markers are always stored as doubles
+     */
+    void set_buffer_storage_mode (int storage_mode);
+    /**
+     * keep min/max/mean pyramid to make get_board_data_envelope independent of range length, should be called before start_stream
+     * @param enabled true to build the pyramid
+     */
+    void set_buffer_summary (bool enabled);
+    /**
+     * apply spatial filter to eeg channels of each package during acquisition, should be called before start_stream
+     * @param filter num_channels x num_channels row major matrix, num_channels should be equal to number of eeg channels, NULL with 0 disables filtering
+     * @param num_channels number of eeg channels
+     */
+    void set_spatial_filter (double *filter, int num_channels);
+    /// apply common average reference to eeg channels during acquisition, should be called before start_stream
+    void set_common_average_reference (bool enabled);
     // clang-format on
 };
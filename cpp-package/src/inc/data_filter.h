@@ -19,6 +19,10 @@ public:
     static void enable_dev_data_logger ();
 
     static void set_log_file (char *log_file);
+    /// set number of threads for multichannel methods, 0 means number of cores, 1 disables them
+    static void set_num_threads (int num_threads);
+    /// get number of threads used by multichannel methods
+    static int get_num_threads ();
     /// perform low pass filter in-place
     static void perform_lowpass (double *data, int data_len, int sampling_rate, double cutoff,
         int order, int filter_type, double ripple);
@@ -63,7 +67,7 @@ public:
     /**
      * perform direct fft
      * @param data input array
-     * @param data_len must be power of 2
+     * @param data_len any positive value, sizes with prime factors 2, 3 and 5 are the fastest
      * @param window window function
      * @return complex array with size data_len / 2 + 1, it holds only positive im values
      */
@@ -71,10 +75,27 @@ public:
     /**
      * perform inverse fft
      * @param data complex array from perform_fft
-     * @param data_len len of original array, must be power of 2
+     * @param data_len len of original array
      * @return restored data
      */
     static double *perform_ifft (std::complex<double> *data, int data_len);
+    /**
+     * calculate envelope and instantaneous phase using hilbert transform
+     * @param data input array
+     * @param data_len any positive value
+     * @return pair of envelope and phase arrays of size data_len, phase is in radians
+     */
+    static std::pair<double *, double *> perform_hilbert_transform (double *data, int data_len);
+    /**
+     * calculate envelope and instantaneous phase for several channels
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @return pair of envelope and phase arrays of size channels_len x cols
+     */
+    static std::pair<double *, double *> perform_multichannel_hilbert_transform (
+        double **data, int cols, int *channels, int channels_len);
     /**
      * calculate nearest power of 2
      * @param value input value
@@ -84,7 +105,7 @@ public:
     /**
      * calculate PSD
      * @param data input array
-     * @param data_len must be power of 2
+     * @param data_len any positive value
      * @param sampling_rate sampling rate
      * @param window window function
      * @return pair of amplitude and freq arrays of size data_len / 2 + 1
@@ -100,6 +121,31 @@ public:
     static void detrend (double *data, int data_len, int detrend_operation);
     static std::pair<double *, double *> get_psd_welch (
         double *data, int data_len, int nfft, int overlap, int sampling_rate, int window);
+    /**
+     * calculate PSD using multitaper method, DPSS tapers are cached between calls
+     * @param data input array
+     * @param data_len any positive value
+     * @param sampling_rate sampling rate
+     * @param nw time-halfbandwidth product, must be less than data_len / 2
+     * @param num_tapers number of tapers, usually 2 * nw - 1
+     * @return pair of amplitude and freq arrays of size data_len / 2 + 1
+     */
+    static std::pair<double *, double *> get_psd_multitaper (
+        double *data, int data_len, int sampling_rate, double nw, int num_tapers);
+    /**
+     * calculate PSD using multitaper method for several channels
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @param sampling_rate sampling rate
+     * @param nw time-halfbandwidth product, must be less than cols / 2
+     * @param num_tapers number of tapers, usually 2 * nw - 1
+     * @return pair of arrays, first of them - channels_len x (cols / 2 + 1) amplitudes, second -
+     * frequencies of size cols / 2 + 1
+     */
+    static std::pair<double *, double *> get_multichannel_psd_multitaper (double **data, int cols,
+        int *channels, int channels_len, int sampling_rate, double nw, int num_tapers);
     /**
      * calculate band power
      * @param psd psd calculated using get_psd
@@ -110,6 +156,110 @@ public:
      */
     static double get_band_power (
         std::pair<double *, double *> psd, int data_len, double freq_start, double freq_end);
+    /**
+     * calculate band powers for several bands at once
+     * @param psd psd calculated using get_psd
+     * @param data_len len of ampl and freq arrays: N / 2 + 1 where N is FFT size
+     * @param freq_starts lowest frequencies of bands
+     * @param freq_ends highest frequencies of bands
+     * @param num_bands number of bands
+     * @return array of size num_bands with band powers
+     */
+    static double *get_band_powers (std::pair<double *, double *> psd, int data_len,
+        double *freq_starts, double *freq_ends, int num_bands);
+    /**
+     * calculate band powers for several channels and bands at once
+     * @param ampls array of num_channels psd amplitudes, each of them has data_len elements
+     * @param num_channels number of channels
+     * @param freq frequencies from get_psd, the same for all channels
+     * @param data_len len of ampl and freq arrays: N / 2 + 1 where N is FFT size
+     * @param freq_starts lowest frequencies of bands
+     * @param freq_ends highest frequencies of bands
+     * @param num_bands number of bands
+     * @return array of size num_channels * num_bands, band powers of channel i start at i *
+     * num_bands
+     */
+    static double *get_multichannel_band_powers (double **ampls, int num_channels, double *freq,
+        int data_len, double *freq_starts, double *freq_ends, int num_bands);
+    /**
+     * apply spatial filter (re-referencing, laplacian, CSP projection) to several channels
+     * @param filter num_outputs x channels_len matrix in row major order
+     * @param num_outputs number of rows in filter matrix
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @return num_outputs x cols filtered data
+     */
+    static double *apply_spatial_filter (double *filter, int num_outputs, double **data, int cols,
+        int *channels, int channels_len);
+    /**
+     * perform common average reference inplace
+     * @param data input 2d array, selected rows will be modified
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     */
+    static void perform_common_average_reference (
+        double **data, int cols, int *channels, int channels_len);
+    /**
+     * cut epochs around markers
+     * @param data input 2d array from get_board_data
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param marker_channel row with markers, epochs are created for each non zero value
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @param pre_samples number of datapoints before marker
+     * @param post_samples number of datapoints starting from marker
+     * @param apply_baseline set to true to subtract mean of pre_samples datapoints
+     * @param num_epochs number of found epochs, markers without enough data around are skipped
+     * @return pair of arrays, first of them - num_epochs x channels_len x (pre_samples +
+     * post_samples) datapoints, second - marker values of size num_epochs
+     */
+    static std::pair<double *, double *> get_epochs (double **data, int cols, int marker_channel,
+        int *channels, int channels_len, int pre_samples, int post_samples, bool apply_baseline,
+        int *num_epochs);
+    /**
+     * calculate cross spectral density matrices using Welch method
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @param nfft size of FFT
+     * @param overlap overlap of FFT Windows, must be between 0 and nfft - 1
+     * @param sampling_rate sampling rate
+     * @param window window function
+     * @return pair of arrays, first of them - (nfft / 2 + 1) x channels_len x channels_len
+     * complex matrices, second - frequencies of size nfft / 2 + 1
+     */
+    static std::pair<std::complex<double> *, double *> get_csd_welch (double **data, int cols,
+        int *channels, int channels_len, int nfft, int overlap, int sampling_rate, int window);
+    /**
+     * calculate magnitude squared coherence between channels averaged over the band
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @param nfft size of FFT
+     * @param overlap overlap of FFT Windows, must be between 0 and nfft - 1
+     * @param sampling_rate sampling rate
+     * @param window window function
+     * @param freq_start lowest frequency
+     * @param freq_end highest frequency
+     * @return channels_len x channels_len matrix
+     */
+    static double *get_coherence (double **data, int cols, int *channels, int channels_len,
+        int nfft, int overlap, int sampling_rate, int window, double freq_start, double freq_end);
+    /**
+     * calculate spatial covariance matrix
+     * @param data input 2d array
+     * @param cols number of cols in 2d array - number of datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array
+     * @return channels_len x channels_len matrix
+     */
+    static double *get_covariance_matrix (
+        double **data, int cols, int *channels, int channels_len);
     /**
      * calculate avg and stddev of BandPowers across all channels
      * @param data input 2d array
@@ -122,12 +272,124 @@ public:
      */
     static std::pair<double *, double *> get_avg_band_powers (double **data, int cols,
         int *channels, int channels_len, int sampling_rate, bool apply_filters);
+    /**
+     * create streaming spectrogram which keeps fft plan and window between updates
+     * @param num_channels number of channels which will be passed to update_spectrogram
+     * @param nfft size of fft window, any positive value
+     * @param hop number of new datapoints between columns
+     * @param sampling_rate sampling rate
+     * @param window window function
+     * @param log_power set to true to get psd in decibels
+     * @return id of spectrogram
+     */
+    static int create_spectrogram (
+        int num_channels, int nfft, int hop, int sampling_rate, int window, bool log_power);
+    /**
+     * add new datapoints to spectrogram
+     * @param spectrogram_id id from create_spectrogram
+     * @param data input 2d array
+     * @param cols number of new datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array, must match num_channels from create_spectrogram
+     * @param num_columns number of emitted columns
+     * @param num_bins number of psd values per channel, nfft / 2 + 1
+     * @return array of num_columns x channels_len x num_bins psd values
+     */
+    static double *update_spectrogram (int spectrogram_id, double **data, int cols, int *channels,
+        int channels_len, int *num_columns, int *num_bins);
+    /// release spectrogram
+    static void release_spectrogram (int spectrogram_id);
+    /**
+     * create streaming hilbert transform based on FIR filter
+     * @param num_channels number of channels which will be passed to update_hilbert_filter
+     * @param num_taps odd number of taps, output is delayed by (num_taps - 1) / 2 datapoints
+     * @return id of hilbert filter
+     */
+    static int create_hilbert_filter (int num_channels, int num_taps);
+    /**
+     * add new datapoints to hilbert filter
+     * @param filter_id id from create_hilbert_filter
+     * @param data input 2d array
+     * @param cols number of new datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array, should match num_channels
+     * @return pair of envelope and phase arrays of size channels_len x cols
+     */
+    static std::pair<double *, double *> update_hilbert_filter (
+        int filter_id, double **data, int cols, int *channels, int channels_len);
+    /// release hilbert filter
+    static void release_hilbert_filter (int filter_id);
+    /**
+     * create streaming ssvep detector based on sliding Goertzel filters
+     * @param num_channels number of channels which will be passed to update_ssvep_detector
+     * @param sampling_rate sampling rate
+     * @param target_freqs stimulus frequencies
+     * @param num_targets len of target_freqs array
+     * @param num_harmonics number of harmonics for each target, 1 means only base frequency
+     * @param window_len number of last datapoints used for scores
+     * @return id of ssvep detector
+     */
+    static int create_ssvep_detector (int num_channels, int sampling_rate, double *target_freqs,
+        int num_targets, int num_harmonics, int window_len);
+    /**
+     * add new datapoints to ssvep detector
+     * @param detector_id id from create_ssvep_detector
+     * @param data input 2d array
+     * @param cols number of new datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array, should match num_channels
+     * @param scores output array of size num_targets, fraction of signal energy for each target
+     */
+    static void update_ssvep_detector (int detector_id, double **data, int cols, int *channels,
+        int channels_len, double *scores);
+    /// release ssvep detector
+    static void release_ssvep_detector (int detector_id);
+    /**
+     * create streaming artifact detector, thresholds <= 0 disable corresponding checks
+     * @param num_channels number of channels which will be passed to update_artifact_detector
+     * @param sampling_rate sampling rate
+     * @param window_len number of last datapoints used for statistics
+     * @param max_peak_to_peak max peak to peak amplitude in the window
+     * @param min_std min standard deviation in the window, lower values are flatline
+     * @param max_std max standard deviation in the window
+     * @param line_freq line frequency, 50 or 60 Hz
+     * @param max_line_noise_ratio max ratio of line noise power to variance
+     * @param interpolate set to true to replace flagged datapoints by mean of good channels
+     * @return id of artifact detector
+     */
+    static int create_artifact_detector (int num_channels, int sampling_rate, int window_len,
+        double max_peak_to_peak, double min_std, double max_std, double line_freq,
+        double max_line_noise_ratio, bool interpolate);
+    /**
+     * add new datapoints to artifact detector, if interpolation is enabled data is modified
+     * @param detector_id id from create_artifact_detector
+     * @param data input 2d array
+     * @param cols number of new datapoints
+     * @param channels array of rows which should be used
+     * @param channels_len len of channels array, should match num_channels
+     * @return channels_len x cols array of flags, use ArtifactTypes enum to check bits
+     */
+    static int *update_artifact_detector (
+        int detector_id, double **data, int cols, int *channels, int channels_len);
+    /// release artifact detector
+    static void release_artifact_detector (int detector_id);
 
     /// write file, in file data will be transposed
     static void write_file (
         double **data, int num_rows, int num_cols, char *file_name, char *file_mode);
     /// read data from file, data will be transposed to original format
     static double **read_file (int *num_rows, int *num_cols, char *file_name);
+    /// one pass over file from write_file to build min/max/mean pyramid used by get_file_envelope
+    static void create_file_summary (char *file_name, char *summary_file);
+    /**
+     * get min, max and mean of each row for num_points equal parts of [start_sample, end_sample)
+     * @param summary_file file from create_file_summary
+     * @param num_rows number of rows in original file
+     * @param returned_points number of points, less than num_points if there are fewer samples
+     * @return 3 * num_rows rows: mins of all rows, then maxes, then means
+     */
+    static double **get_file_envelope (char *summary_file, int start_sample, int end_sample,
+        int num_points, int *num_rows, int *returned_points);
 
 private:
     static void set_log_level (int log_level);
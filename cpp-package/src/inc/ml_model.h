@@ -5,6 +5,7 @@
 // include it here to allow user include only this single file
 #include "brainflow_constants.h"
 #include "brainflow_exception.h"
+#include "brainflow_input_params.h"
 #include "brainflow_model_params.h"
 #include "ml_module.h"
 
@@ -37,6 +38,16 @@ public:
     void prepare ();
     /// calculate metric from data
     double predict (double *data, int data_len);
+    /// calculate feature vector from raw data like get_avg_band_powers and metric from it
+    double predict_from_raw (
+        double **data, int cols, int *channels, int num_channels, int sampling_rate);
+    /// calculate metric in background for the latest window_size samples of board session
+    void start_metric_stream (int board_id, struct BrainFlowInputParams input_params,
+        int *channels, int num_channels, int window_size, int interval_ms);
+    /// get and remove oldest scores from metric stream, returns number of scores
+    int get_metric_stream_scores (double *scores, double *timestamps, int max_scores);
+    /// stop metric stream, also stopped by release
+    void stop_metric_stream ();
     /// release classifier
     void release ();
     // clang-format on
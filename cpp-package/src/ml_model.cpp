@@ -1,10 +1,16 @@
+#include <string.h>
+
 #include "ml_model.h"
 #include "brainflow_constants.h"
 #include "json.hpp"
 #include "ml_module.h"
+#include "scratch_arena.h"
 
 using json = nlohmann::json;
 
+// from board_shim.cpp
+std::string params_to_string (struct BrainFlowInputParams params);
+
 
 void MLModel::set_log_file (char *log_file)
 {
@@ -51,6 +57,67 @@ double MLModel::predict (double *data, int data_len)
     return output;
 }
 
+double MLModel::predict_from_raw (
+    double **data, int cols, int *channels, int num_channels, int sampling_rate)
+{
+    if ((data == NULL) || (channels == NULL) || (num_channels < 1) || (cols < 1))
+    {
+        throw BrainFlowException (
+            "Invalid params", (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR);
+    }
+    // only selected channels are copied
+    ScratchScope scratch;
+    double *data_1d = scratch.alloc<double> ((size_t)cols * num_channels);
+    int *rows = scratch.alloc<int> (num_channels);
+    for (int i = 0; i < num_channels; i++)
+    {
+        memcpy (data_1d + (size_t)i * cols, data[channels[i]], sizeof (double) * cols);
+        rows[i] = i;
+    }
+    double output = 0.0;
+    int res = ::predict_from_raw (data_1d, num_channels, cols, sampling_rate, rows, num_channels,
+        &output, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to predict from raw data", res);
+    }
+    return output;
+}
+
+void MLModel::start_metric_stream (int board_id, struct BrainFlowInputParams input_params,
+    int *channels, int num_channels, int window_size, int interval_ms)
+{
+    std::string serialized_input_params = params_to_string (input_params);
+    int res = ::start_metric_stream (board_id,
+        const_cast<char *> (serialized_input_params.c_str ()), channels, num_channels, window_size,
+        interval_ms, const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to start metric stream", res);
+    }
+}
+
+int MLModel::get_metric_stream_scores (double *scores, double *timestamps, int max_scores)
+{
+    int num_scores = 0;
+    int res = ::get_metric_stream_scores (max_scores, scores, timestamps, &num_scores,
+        const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to get metric stream scores", res);
+    }
+    return num_scores;
+}
+
+void MLModel::stop_metric_stream ()
+{
+    int res = ::stop_metric_stream (const_cast<char *> (serialized_params.c_str ()));
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        throw BrainFlowException ("failed to stop metric stream", res);
+    }
+}
+
 void MLModel::release ()
 {
     int res = ::release (const_cast<char *> (serialized_params.c_str ()));
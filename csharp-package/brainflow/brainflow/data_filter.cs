@@ -307,7 +307,7 @@ namespace brainflow
         /// </summary>
         /// <param name="data">data for fft</param>
         /// <param name="start_pos">start pos</param>
-        /// <param name="end_pos">end pos, end_pos - start_pos must be a power of 2</param>
+        /// <param name="end_pos">end pos</param>
         /// <param name="window">window function</param>
         /// <returns>complex array of size N / 2 + 1 of fft data</returns>
         public static Complex[] perform_fft(double[] data, int start_pos, int end_pos, int window)
@@ -317,10 +317,6 @@ namespace brainflow
                 throw new BrainFlowException ((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
             }
             int len = end_pos - start_pos;
-            if ((len & (len - 1)) != 0)
-            {
-                throw new BrainFlowException ((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
-            }
             double[] data_to_process = new double[len];
             Array.Copy (data, start_pos, data_to_process, 0, len);
             double[] temp_re = new double[len / 2 + 1];
@@ -343,10 +339,24 @@ namespace brainflow
         /// perform inverse fft
         /// </summary>
         /// <param name="data">data from perform_fft</param>
-        /// <returns>restored data</returns>
+        /// <returns>restored data, even number of datapoints</returns>
         public static double[] perform_ifft(Complex[] data)
         {
-            int len = (data.Length - 1) * 2;
+            return perform_ifft (data, (data.Length - 1) * 2);
+        }
+
+        /// <summary>
+        /// perform inverse fft
+        /// </summary>
+        /// <param name="data">data from perform_fft</param>
+        /// <param name="len">len of original data, should be provided for odd lengths</param>
+        /// <returns>restored data</returns>
+        public static double[] perform_ifft(Complex[] data, int len)
+        {
+            if (len / 2 + 1 != data.Length)
+            {
+                throw new BrainFlowException ((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
+            }
             double[] temp_re = new double[data.Length];
             double[] temp_im = new double[data.Length];
             double[] output = new double[len];
@@ -460,7 +470,7 @@ namespace brainflow
         /// </summary>
         /// <param name="data">data for PSD</param>
         /// <param name="start_pos">start pos</param>
-        /// <param name="end_pos">end pos, end_pos - start_pos must be a power of 2</param>
+        /// <param name="end_pos">end pos</param>
         /// <param name="sampling_rate">sampling rate</param>
         /// <param name="window">window function</param>
         /// <returns>Tuple of ampls and freqs arrays of size N / 2 + 1</returns>
@@ -471,10 +481,6 @@ namespace brainflow
                 throw new BrainFlowException((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
             }
             int len = end_pos - start_pos;
-            if ((len & (len - 1)) != 0)
-            {
-                throw new BrainFlowException((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
-            }
             double[] data_to_process = new double[len];
             Array.Copy(data, start_pos, data_to_process, 0, len);
             double[] temp_ampls = new double[len / 2 + 1];
@@ -500,7 +506,7 @@ namespace brainflow
         /// <returns>Tuple of ampls and freqs arrays</returns>
         public static Tuple<double[], double[]> get_psd_welch(double[] data, int nfft, int overlap, int sampling_rate, int window)
         {
-            if ((nfft & (nfft - 1)) != 0)
+            if (nfft <= 0)
             {
                 throw new BrainFlowException((int)CustomExitCodes.INVALID_ARGUMENTS_ERROR);
             }
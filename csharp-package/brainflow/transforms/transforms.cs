@@ -45,10 +45,9 @@ namespace test
                 Console.WriteLine ("[{0}]", string.Join (", ", restored_data));
 
                 // demo for fft
-                // end_pos - start_pos must be a power of 2
-                Complex[] fft_data = DataFilter.perform_fft (unprocessed_data.GetRow (eeg_channels[i]), 0, 64, (int)WindowFunctions.HAMMING);
-                // len of fft_data is N / 2 + 1
-                double[] restored_fft_data = DataFilter.perform_ifft (fft_data);
+                // len of fft_data is N / 2 + 1, so perform_ifft needs N for odd lengths
+                Complex[] fft_data = DataFilter.perform_fft (unprocessed_data.GetRow (eeg_channels[i]), 0, 63, (int)WindowFunctions.HAMMING);
+                double[] restored_fft_data = DataFilter.perform_ifft (fft_data, 63);
                 Console.WriteLine ("Restored fft data:");
                 Console.WriteLine ("[{0}]", string.Join (", ", restored_fft_data));
             }
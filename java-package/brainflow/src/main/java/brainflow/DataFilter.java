@@ -364,7 +364,7 @@ public class DataFilter
      * 
      * @param data      data for fft transform
      * @param start_pos starting position to calc fft
-     * @param end_pos   end position to calc fft, total_len must be a power of two
+     * @param end_pos   end position to calc fft
      * @param window    window function
      * @return array of complex values with size N / 2 + 1
      */
@@ -377,11 +377,6 @@ public class DataFilter
         // I didnt find a way to pass an offset using pointers, copy array
         double[] data_to_process = Arrays.copyOfRange (data, start_pos, end_pos);
         int len = data_to_process.length;
-        if ((len & (len - 1)) != 0)
-        {
-            throw new BrainFlowError ("end_pos - start_pos must be a power of 2",
-                    ExitCode.INVALID_ARGUMENTS_ERROR.get_code ());
-        }
         double[][] complex_array = new double[2][];
         complex_array[0] = new double[len / 2 + 1];
         complex_array[1] = new double[len / 2 + 1];
@@ -397,12 +392,27 @@ public class DataFilter
      * perform inverse fft
      * 
      * @param data data from fft transform(array of complex values)
-     * @return restored data
+     * @return restored data, even number of datapoints
      */
     public static double[] perform_ifft (Complex[] data) throws BrainFlowError
     {
+        return perform_ifft (data, (data.length - 1) * 2);
+    }
+
+    /**
+     * perform inverse fft
+     * 
+     * @param data data from fft transform(array of complex values)
+     * @param len  len of original data, should be provided for odd lengths
+     * @return restored data
+     */
+    public static double[] perform_ifft (Complex[] data, int len) throws BrainFlowError
+    {
+        if (len / 2 + 1 != data.length)
+        {
+            throw new BrainFlowError ("Invalid data size", ExitCode.INVALID_ARGUMENTS_ERROR.get_code ());
+        }
         double[][] complex_array = TransformUtils.createRealImaginaryArray (data);
-        int len = (data.length - 1) * 2;
         double[] output = new double[len];
         int ec = instance.perform_ifft (complex_array[0], complex_array[1], len, output);
         if (ec != ExitCode.STATUS_OK.get_code ())
@@ -454,8 +464,7 @@ public class DataFilter
      * 
      * @param data          data to process
      * @param start_pos     starting position to calc PSD
-     * @param end_pos       end position to calc PSD, total_len must be a power of
-     *                      two
+     * @param end_pos       end position to calc PSD
      * @param sampling_rate sampling rate
      * @param window        window function
      * @return pair of ampl and freq arrays with len N / 2 + 1
@@ -470,11 +479,6 @@ public class DataFilter
         // I didnt find a way to pass an offset using pointers, copy array
         double[] data_to_process = Arrays.copyOfRange (data, start_pos, end_pos);
         int len = data_to_process.length;
-        if ((len & (len - 1)) != 0)
-        {
-            throw new BrainFlowError ("end_pos - start_pos must be a power of 2",
-                    ExitCode.INVALID_ARGUMENTS_ERROR.get_code ());
-        }
         double[] ampls = new double[len / 2 + 1];
         double[] freqs = new double[len / 2 + 1];
         int ec = instance.get_psd (data_to_process, len, sampling_rate, window, ampls, freqs);
@@ -490,7 +494,7 @@ public class DataFilter
      * get PSD using Welch Method
      * 
      * @param data          data to process
-     * @param nfft          size of FFT, must be power of two
+     * @param nfft          size of FFT
      * @param overlap       overlap between FFT Windows, must be between 0 and nfft
      * @param sampling_rate sampling rate
      * @param window        window function
@@ -499,9 +503,9 @@ public class DataFilter
     public static Pair<double[], double[]> get_psd_welch (double[] data, int nfft, int overlap, int sampling_rate,
             int window) throws BrainFlowError
     {
-        if ((nfft & (nfft - 1)) != 0)
+        if (nfft <= 0)
         {
-            throw new BrainFlowError ("nfft must be a power of 2", ExitCode.INVALID_ARGUMENTS_ERROR.get_code ());
+            throw new BrainFlowError ("nfft must be positive", ExitCode.INVALID_ARGUMENTS_ERROR.get_code ());
         }
         double[] ampls = new double[nfft / 2 + 1];
         double[] freqs = new double[nfft / 2 + 1];
@@ -61,11 +61,10 @@ public class Transforms
             System.out.println ("Restored data after wavelet:");
             System.out.println (Arrays.toString (restored_data));
 
-            // demo for fft works only for power of 2
-            // len of fft_data is N / 2 + 1
-            Complex[] fft_data = DataFilter.perform_fft (data[eeg_channels[i]], 0, 64,
+            // demo for fft, len of fft_data is N / 2 + 1, so perform_ifft needs N for odd lengths
+            Complex[] fft_data = DataFilter.perform_fft (data[eeg_channels[i]], 0, 63,
                     WindowFunctions.NO_WINDOW.get_code ());
-            double[] restored_fft_data = DataFilter.perform_ifft (fft_data);
+            double[] restored_fft_data = DataFilter.perform_ifft (fft_data, 63);
             System.out.println ("Restored data after fft:");
             System.out.println (Arrays.toString (restored_fft_data));
         }
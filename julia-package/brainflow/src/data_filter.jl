@@ -168,31 +168,27 @@ end
 
 @brainflow_rethrow function perform_fft(data, window::Integer)
 
-    function is_power_of_two(value)
-        (value != 0) && (value & (value - 1) == 0)
-    end
-
-    if !is_power_of_two(length(data))
-        throw(BrainFlowError(string("Data Len must be power of two ", INVALID_ARGUMENTS_ERROR), Integer(INVALID_ARGUMENTS_ERROR)))
-    end
-
-    temp_re = Vector{Float64}(undef, Integer(length(data) / 2) + 1)
-    temp_im = Vector{Float64}(undef, Integer(length(data) / 2) + 1)
-    res = Vector{Complex}(undef, Integer(length(data) / 2) + 1)
+    temp_re = Vector{Float64}(undef, div(length(data), 2) + 1)
+    temp_im = Vector{Float64}(undef, div(length(data), 2) + 1)
+    res = Vector{Complex}(undef, div(length(data), 2) + 1)
 
     ccall((:perform_fft, DATA_HANDLER_INTERFACE), Cint, (Ptr{Float64}, Cint, Cint, Ptr{Float64}, Ptr{Float64}),
             data, length(data), Int32(window), temp_re, temp_im)
-    for i in 1:Integer(length(data) / 2) + 1
+    for i in 1:div(length(data), 2) + 1
         res[i] = Complex(temp_re[i], temp_im[i])
     end
     return res
 end
 
-@brainflow_rethrow function perform_ifft(data)
+# data_len is len of original data, it should be provided for odd lengths
+@brainflow_rethrow function perform_ifft(data, data_len::Integer = 2 * (length(data) - 1))
 
+    if div(data_len, 2) + 1 != length(data)
+        throw(BrainFlowError("data_len doesnt match fft data", Integer(INVALID_ARGUMENTS_ERROR)))
+    end
     temp_re = Vector{Float64}(undef, length(data))
     temp_im = Vector{Float64}(undef, length(data))
-    res = Vector{Float64}(undef, 2 * (length(data) - 1))
+    res = Vector{Float64}(undef, data_len)
 
     for i in 1:length(data)
         temp_re[i] = data[i].re
@@ -220,16 +216,8 @@ end
 
 @brainflow_rethrow function get_psd(data, sampling_rate::Integer, window::Integer)
 
-    function is_power_of_two(value)
-        (value != 0) && (value & (value - 1) == 0)
-    end
-
-    if !is_power_of_two(length(data))
-        throw(BrainFlowError(string("Data Len must be power of two ", INVALID_ARGUMENTS_ERROR), Integer(INVALID_ARGUMENTS_ERROR)))
-    end
-
-    temp_ampls = Vector{Float64}(undef, Integer(length(data) / 2) + 1)
-    temp_freqs = Vector{Float64}(undef, Integer(length(data) / 2) + 1)
+    temp_ampls = Vector{Float64}(undef, div(length(data), 2) + 1)
+    temp_freqs = Vector{Float64}(undef, div(length(data), 2) + 1)
 
     ccall((:get_psd, DATA_HANDLER_INTERFACE), Cint, (Ptr{Float64}, Cint, Cint, Cint, Ptr{Float64}, Ptr{Float64}),
             data, length(data), Int32(sampling_rate), Int32(window), temp_ampls, temp_freqs)
@@ -238,16 +226,8 @@ end
 
 @brainflow_rethrow function get_psd_welch(data, nfft::Integer, overlap::Integer, sampling_rate::Integer, window::Integer)
 
-    function is_power_of_two(value)
-        (value != 0) && (value & (value - 1) == 0)
-    end
-
-    if !is_power_of_two(nfft)
-        throw(BrainFlowError(string("nfft must be power of two ", INVALID_ARGUMENTS_ERROR), Integer(INVALID_ARGUMENTS_ERROR)))
-    end
-
-    temp_ampls = Vector{Float64}(undef, Integer(nfft / 2) + 1)
-    temp_freqs = Vector{Float64}(undef, Integer(nfft / 2) + 1)
+    temp_ampls = Vector{Float64}(undef, div(nfft, 2) + 1)
+    temp_freqs = Vector{Float64}(undef, div(nfft, 2) + 1)
 
     ccall((:get_psd_welch, DATA_HANDLER_INTERFACE), Cint, (Ptr{Float64}, Cint, Cint, Cint, Cint, Cint, Ptr{Float64}, Ptr{Float64}),
             data, length(data), Int32(nfft), Int32(overlap), Int32(sampling_rate), Int32(window), temp_ampls, temp_freqs)
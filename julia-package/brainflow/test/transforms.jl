@@ -23,7 +23,7 @@ wavelet_data = BrainFlow.perform_wavelet_transform(data_first_channel, "db4", 2)
 restored_wavelet_data = BrainFlow.perform_inverse_wavelet_transform(wavelet_data, length(data_first_channel), "db4", 2)
 
 fft_data = BrainFlow.perform_fft(data_first_channel, BrainFlow.NO_WINDOW)
-restored_fft_data = BrainFlow.perform_ifft(fft_data)
+restored_fft_data = BrainFlow.perform_ifft(fft_data, length(data_first_channel))
 
 println("Original Data")
 println(data_first_channel)
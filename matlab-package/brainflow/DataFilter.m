@@ -184,26 +184,29 @@ classdef DataFilter
             % perform fft
             task_name = 'perform_fft';
             n = size(data, 2);
-            if(bitand(n, n - 1) ~= 0)
-                error('For FFT shape must be power of 2!');
-            end
             temp_input = libpointer('doublePtr', data);
             lib_name = DataFilter.load_lib();
-            temp_re = libpointer('doublePtr', zeros(1, int32(n / 2 + 1)));
-            temp_im = libpointer('doublePtr', zeros(1, int32(n / 2 + 1)));
+            temp_re = libpointer('doublePtr', zeros(1, int32(floor(n / 2) + 1)));
+            temp_im = libpointer('doublePtr', zeros(1, int32(floor(n / 2) + 1)));
             exit_code = calllib(lib_name, task_name, temp_input, n, window, temp_re, temp_im);
             DataFilter.check_ec(exit_code, task_name);
             fft_data = complex(temp_re.Value, temp_im.Value);
         end
 
-        function data = perform_ifft(fft_data)
-            % perform inverse fft
+        function data = perform_ifft(fft_data, data_len)
+            % perform inverse fft, data_len is len of original data, it should be provided for odd lengths
             task_name = 'perform_ifft';
+            if nargin < 2
+                data_len = 2 * (size(fft_data, 2) - 1);
+            end
+            if floor(data_len / 2) + 1 ~= size(fft_data, 2)
+                error('data_len doesnt match fft data');
+            end
             real_data = real(fft_data);
             imag_data = imag(fft_data);
             real_input = libpointer('doublePtr', real_data);
             imag_input = libpointer('doublePtr', imag_data);
-            output_len = 2 *(size(fft_data, 2) - 1);
+            output_len = data_len;
             output = libpointer('doublePtr', zeros(1, output_len));
             lib_name = DataFilter.load_lib();
             exit_code = calllib(lib_name, task_name, real_input, imag_input, output_len, output);
@@ -231,13 +234,10 @@ classdef DataFilter
             % calculate PSD
             task_name = 'get_psd';
             n = size(data, 2);
-            if(bitand(n, n - 1) ~= 0)
-                error('For FFT shape must be power of 2!');
-            end
             temp_input = libpointer('doublePtr', data);
             lib_name = DataFilter.load_lib();
-            temp_ampls = libpointer('doublePtr', zeros(1, int32(n / 2 + 1)));
-            temp_freqs = libpointer('doublePtr', zeros(1, int32(n / 2 + 1)));
+            temp_ampls = libpointer('doublePtr', zeros(1, int32(floor(n / 2) + 1)));
+            temp_freqs = libpointer('doublePtr', zeros(1, int32(floor(n / 2) + 1)));
             exit_code = calllib(lib_name, task_name, temp_input, n, sampling_rate, window, temp_ampls, temp_freqs);
             DataFilter.check_ec(exit_code, task_name);
             ampls = temp_ampls.Value;
@@ -247,13 +247,10 @@ classdef DataFilter
         function [ampls, freqs] = get_psd_welch(data, nfft, overlap, sampling_rate, window)
             % calculate PSD using welch method
             task_name = 'get_psd_welch';
-            if(bitand(nfft, nfft - 1) ~= 0)
-                error('nfft must be power of 2!');
-            end
             temp_input = libpointer('doublePtr', data);
             lib_name = DataFilter.load_lib();
-            temp_ampls = libpointer('doublePtr', zeros(1, int32(nfft / 2 + 1)));
-            temp_freqs = libpointer('doublePtr', zeros(1, int32(nfft / 2 + 1)));
+            temp_ampls = libpointer('doublePtr', zeros(1, int32(floor(nfft / 2) + 1)));
+            temp_freqs = libpointer('doublePtr', zeros(1, int32(floor(nfft / 2) + 1)));
             exit_code = calllib(lib_name, task_name, temp_input, size(data, 2), nfft, overlap, sampling_rate, window, temp_ampls, temp_freqs);
             DataFilter.check_ec(exit_code, task_name);
             ampls = temp_ampls.Value;
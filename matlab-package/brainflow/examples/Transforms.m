@@ -19,4 +19,4 @@ original_data = data(first_eeg_channel, :);
 restored_data = DataFilter.perform_inverse_wavelet_transform(wavelet_data, wavelet_lenghts, size(original_data, 2), 'db4', 2);
 % fft for first eeg channel %
 fft_data = DataFilter.perform_fft(original_data, int32(WindowFunctions.NO_WINDOW));
-restored_fft_data = DataFilter.perform_ifft(fft_data);
\ No newline at end of file
+restored_fft_data = DataFilter.perform_ifft(fft_data, size(original_data, 2));
\ No newline at end of file
@@ -630,7 +630,7 @@ class DataFilter(object):
     def perform_fft(cls, data: NDArray[Float64], window: int) -> NDArray[Complex128]:
         """perform direct fft
 
-        :param data: data for fft, len of data must be a power of 2
+        :param data: data for fft, any length is supported
         :type data: NDArray[Float64]
         :param window: window function
         :type window: int
@@ -638,13 +638,6 @@ class DataFilter(object):
         :rtype: NDArray[Complex128]
         """
 
-        def is_power_of_two(n):
-            return (n != 0) and (n & (n - 1) == 0)
-
-        if (not is_power_of_two(data.shape[0])):
-            raise BrainFlowError('data len is not power of 2: %d' % data.shape[0],
-                                 BrainflowExitCodes.INVALID_ARGUMENTS_ERROR.value)
-
         temp_re = numpy.zeros(int(data.shape[0] / 2 + 1)).astype(numpy.float64)
         temp_im = numpy.zeros(int(data.shape[0] / 2 + 1)).astype(numpy.float64)
         res = DataHandlerDLL.get_instance().perform_fft(data, data.shape[0], window, temp_re, temp_im)
@@ -661,7 +654,7 @@ class DataFilter(object):
     def get_psd(cls, data: NDArray[Float64], sampling_rate: int, window: int) -> Tuple:
         """calculate PSD
 
-        :param data: data to calc psd, len of data must be a power of 2
+        :param data: data to calc psd, any length is supported
         :type data: NDArray[Float64]
         :param sampling_rate: sampling rate
         :type sampling_rate: int
@@ -671,13 +664,6 @@ class DataFilter(object):
         :rtype: tuple
         """
 
-        def is_power_of_two(n):
-            return (n != 0) and (n & (n - 1) == 0)
-
-        if (not is_power_of_two(data.shape[0])):
-            raise BrainFlowError('data len is not power of 2: %d' % data.shape[0],
-                                 BrainflowExitCodes.INVALID_ARGUMENTS_ERROR.value)
-
         ampls = numpy.zeros(int(data.shape[0] / 2 + 1)).astype(numpy.float64)
         freqs = numpy.zeros(int(data.shape[0] / 2 + 1)).astype(numpy.float64)
         res = DataHandlerDLL.get_instance().get_psd(data, data.shape[0], sampling_rate, window, ampls, freqs)
@@ -692,7 +678,7 @@ class DataFilter(object):
 
         :param data: data to calc psd
         :type data: NDArray[Float64]
-        :param nfft: FFT Window size, must be power of 2
+        :param nfft: FFT Window size, any positive value
         :type nfft: int
         :param overlap: overlap of FFT Windows, must be between 0 and nfft
         :type overlap: int
@@ -704,12 +690,6 @@ class DataFilter(object):
         :rtype: tuple
         """
 
-        def is_power_of_two(n):
-            return (n != 0) and (n & (n - 1) == 0)
-
-        if (not is_power_of_two(nfft)):
-            raise BrainFlowError('nfft is not power of 2: %d' % nfft, BrainflowExitCodes.INVALID_ARGUMENTS_ERROR.value)
-
         ampls = numpy.zeros(int(nfft / 2 + 1)).astype(numpy.float64)
         freqs = numpy.zeros(int(nfft / 2 + 1)).astype(numpy.float64)
         res = DataHandlerDLL.get_instance().get_psd_welch(data, data.shape[0], nfft, overlap, sampling_rate, window,
@@ -789,20 +769,26 @@ class DataFilter(object):
         return avg_bands, stddev_bands
 
     @classmethod
-    def perform_ifft(cls, data: NDArray[Complex128]) -> NDArray[Float64]:
+    def perform_ifft(cls, data: NDArray[Complex128], data_len: int = None) -> NDArray[Float64]:
         """perform inverse fft
 
         :param data: data from fft
         :type data: NDArray[Complex128]
+        :param data_len: len of original data, by default 2 * (len(data) - 1), should be provided for odd lengths
+        :type data_len: int
         :return: restored data
         :rtype: NDArray[Float64]
         """
+        if data_len is None:
+            data_len = 2 * (data.shape[0] - 1)
+        if data_len // 2 + 1 != data.shape[0]:
+            raise BrainFlowError('data_len doesnt match fft data', BrainflowExitCodes.INVALID_ARGUMENTS_ERROR.value)
         temp_re = numpy.zeros(data.shape[0]).astype(numpy.float64)
         temp_im = numpy.zeros(data.shape[0]).astype(numpy.float64)
         for i in range(data.shape[0]):
             temp_re[i] = data[i].real
             temp_im[i] = data[i].imag
-        output = numpy.zeros(2 * (data.shape[0] - 1)).astype(numpy.float64)
+        output = numpy.zeros(data_len).astype(numpy.float64)
 
         res = DataHandlerDLL.get_instance().perform_ifft(temp_re, temp_im, output.shape[0], output)
         if res != BrainflowExitCodes.STATUS_OK.value:
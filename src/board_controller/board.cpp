@@ -1,3 +1,4 @@
+#include <limits.h>
 #include <string>
 #include <vector>
 
@@ -6,11 +7,14 @@
 #include "custom_cast.h"
 #include "file_streamer.h"
 #include "multicast_streamer.h"
+#include "packet_capture.h"
 #include "stub_streamer.h"
 
 #include "spdlog/sinks/null_sink.h"
 
 #define LOGGER_NAME "board_logger"
+// summary pyramid uses bigger blocks for long buffers to stay within this limit
+#define MAX_SUMMARY_BYTES (64 * 1024 * 1024)
 
 #ifdef __ANDROID__
 #include "spdlog/sinks/android_sink.h"
@@ -70,7 +74,8 @@ int Board::set_log_file (char *log_file)
 
 int Board::prepare_for_acquisition (int buffer_size, char *streamer_params)
 {
-    if (buffer_size <= 0 || buffer_size > MAX_CAPTURE_SAMPLES)
+    // with spill file only hot part of the buffer is kept in RAM, size is limited by disk space
+    if (buffer_size <= 0 || (spill_file.empty () && buffer_size > MAX_CAPTURE_SAMPLES))
     {
         safe_logger (spdlog::level::err, "invalid array size");
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
@@ -113,14 +118,37 @@ int Board::prepare_for_acquisition (int buffer_size, char *streamer_params)
         return res;
     }
 
-    db = new DataBuffer ((int)board_descr["num_rows"], buffer_size);
+    res = prepare_spatial_filter ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+
+    std::vector<int> row_types;
+    std::vector<double> row_scales;
+    get_buffer_layout (row_types, row_scales);
+    db = new DataBuffer ((int)board_descr["num_rows"], buffer_size, hot_buffer_size,
+        spill_file.c_str (), row_types.data (), row_scales.data ());
     if (!db->is_ready ())
     {
         safe_logger (spdlog::level::err, "unable to prepare buffer with size {}", buffer_size);
+        if (!spill_file.empty ())
+        {
+            safe_logger (spdlog::level::err, "unable to create spill file {}", spill_file);
+        }
         delete db;
         db = NULL;
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
+    is_drop_logged = false;
+    if (summary_enabled)
+    {
+        db->enable_summary (MAX_SUMMARY_BYTES);
+    }
+    for (auto it = cursor_names.begin (); it != cursor_names.end (); ++it)
+    {
+        db->add_cursor (*it);
+    }
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -148,9 +176,15 @@ void Board::push_package (double *package)
     }
     lock.unlock ();
 
-    if (db != NULL)
+    if (!spatial_filter_rows.empty ())
+    {
+        apply_spatial_filter (package);
+    }
+    if ((db != NULL) && (!db->add_data (package)) && (!is_drop_logged))
     {
-        db->add_data (package);
+        is_drop_logged = true;
+        safe_logger (spdlog::level::warn,
+            "ringbuffer drops packages, spill file doesnt keep up or is blocked by long reads");
     }
     if (streamer != NULL)
     {
@@ -158,6 +192,49 @@ void Board::push_package (double *package)
     }
 }
 
+int Board::prepare_spatial_filter ()
+{
+    spatial_filter_rows.clear ();
+    if (spatial_filter.empty ())
+    {
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    std::vector<int> eeg_channels;
+    if (board_descr.find ("eeg_channels") != board_descr.end ())
+    {
+        eeg_channels = board_descr["eeg_channels"].get<std::vector<int>> ();
+    }
+    if (spatial_filter.size () != eeg_channels.size () * eeg_channels.size ())
+    {
+        safe_logger (spdlog::level::err, "spatial filter doesnt match {} eeg channels",
+            eeg_channels.size ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    acquisition_spatial_filter = spatial_filter;
+    spatial_filter_rows = eeg_channels;
+    spatial_filter_input.resize (eeg_channels.size ());
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void Board::apply_spatial_filter (double *package)
+{
+    size_t num_channels = spatial_filter_rows.size ();
+    for (size_t i = 0; i < num_channels; i++)
+    {
+        spatial_filter_input[i] = package[spatial_filter_rows[i]];
+    }
+    for (size_t i = 0; i < num_channels; i++)
+    {
+        const double *weights = acquisition_spatial_filter.data () + i * num_channels;
+        double value = 0.0;
+        for (size_t k = 0; k < num_channels; k++)
+        {
+            value += weights[k] * spatial_filter_input[k];
+        }
+        package[spatial_filter_rows[i]] = value;
+    }
+}
+
 int Board::insert_marker (double value)
 {
     if (std::fabs (value) < std::numeric_limits<double>::epsilon ())
@@ -171,6 +248,267 @@ int Board::insert_marker (double value)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::set_buffer_spill_file (std::string spill_file, int hot_buffer_size)
+{
+#ifdef _WIN32
+    if (!spill_file.empty ())
+    {
+        safe_logger (spdlog::level::err, "spill file is not supported on Windows");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+#endif
+    if ((!spill_file.empty ()) && (hot_buffer_size <= 0))
+    {
+        safe_logger (spdlog::level::err, "hot buffer size should be positive");
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+    this->spill_file = spill_file;
+    this->hot_buffer_size = hot_buffer_size;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_buffer_storage_mode (int storage_mode)
+{
+    if ((storage_mode < (int)BufferStorageModes::FLOAT64) ||
+        (storage_mode > (int)BufferStorageModes::INT32_RAW))
+    {
+        safe_logger (spdlog::level::err, "unsupported storage mode {}", storage_mode);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    this->storage_mode = storage_mode;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+bool Board::start_shared_reading (int socket_fd, std::function<void ()> read_package)
+{
+    SocketReactor *shared_reactor = SocketReactor::get_instance ();
+    if (shared_reactor == NULL)
+    {
+        return false;
+    }
+    if (thread_settings.is_custom ())
+    {
+        safe_logger (spdlog::level::debug, "thread settings are set, reactor is not used");
+        return false;
+    }
+    // socket is never readable, data comes from replay file
+    if (PacketCapture::get_mode () == (int)PacketCaptureModes::REPLAY)
+    {
+        safe_logger (spdlog::level::debug, "packets are replayed, reactor is not used");
+        return false;
+    }
+    int res = shared_reactor->add_socket (socket_fd, read_package);
+    if (res != (int)SocketReactorReturnCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::warn, "failed to add socket to reactor: {}", res);
+        return false;
+    }
+    safe_logger (spdlog::level::debug, "socket is read by shared reactor");
+    reactor = shared_reactor;
+    reactor_socket = socket_fd;
+    return true;
+}
+
+bool Board::stop_shared_reading ()
+{
+    if (reactor == NULL)
+    {
+        return false;
+    }
+    reactor->remove_socket (reactor_socket);
+    reactor = NULL;
+    reactor_socket = -1;
+    return true;
+}
+
+int Board::set_buffer_summary (int enabled)
+{
+    summary_enabled = (enabled != 0);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_spatial_filter (const double *filter, int num_channels)
+{
+    if ((num_channels < 0) || ((num_channels > 0) && (filter == NULL)))
+    {
+        safe_logger (spdlog::level::err, "invalid spatial filter");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    spatial_filter.assign (filter, filter + (size_t)num_channels * num_channels);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::set_acquisition_thread_settings (std::string json_settings)
+{
+    ThreadSettings settings;
+    try
+    {
+        json config = json::parse (json_settings);
+        if (config.contains ("cpus"))
+        {
+            settings.cpus = config["cpus"].get<std::vector<int>> ();
+        }
+        if (config.contains ("policy"))
+        {
+            std::string policy = config["policy"];
+            settings.policy = ThreadSettings::policy_from_string (policy);
+            if (settings.policy == (int)ThreadPolicies::DEFAULT)
+            {
+                safe_logger (spdlog::level::err, "policy should be one of other, fifo, rr");
+                return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+            }
+        }
+        if (config.contains ("priority"))
+        {
+            settings.priority = config["priority"];
+        }
+        if (config.contains ("nice"))
+        {
+            settings.set_nice = true;
+            settings.nice = config["nice"];
+        }
+        if (config.contains ("name"))
+        {
+            settings.name = config["name"].get<std::string> ();
+        }
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, "invalid thread settings: {}", e.what ());
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::string error = settings.validate ();
+    if (!error.empty ())
+    {
+        safe_logger (spdlog::level::err, error);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    thread_settings = settings;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+static json thread_settings_to_json (const ThreadSettings &settings)
+{
+    json result;
+    result["cpus"] = settings.cpus;
+    result["policy"] = ThreadSettings::policy_to_string (settings.policy);
+    result["priority"] = settings.priority;
+    if (settings.set_nice)
+    {
+        result["nice"] = settings.nice;
+    }
+    result["name"] = settings.name;
+    if (settings.thread_id >= 0)
+    {
+        result["thread_id"] = settings.thread_id;
+    }
+    return result;
+}
+
+int Board::get_acquisition_thread_settings (std::string &result)
+{
+    json settings;
+    settings["requested"] = thread_settings_to_json (thread_settings);
+    {
+        std::lock_guard<std::mutex> guard (thread_settings_mutex);
+        // null until acquisition thread is started
+        settings["applied"] = nullptr;
+        if (thread_settings_applied)
+        {
+            settings["applied"] = thread_settings_to_json (applied_thread_settings);
+        }
+        settings["errors"] = thread_settings_errors;
+    }
+    result = settings.dump ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+std::thread Board::create_acquisition_thread (std::function<void ()> body)
+{
+    ThreadSettings settings = thread_settings;
+    if (settings.name.empty ())
+    {
+        std::string board_name = board_descr.value ("name", int_to_string (board_id));
+        settings.name = ("bf_" + board_name).substr (0, 15);
+    }
+    {
+        std::lock_guard<std::mutex> guard (thread_settings_mutex);
+        thread_settings_applied = false;
+        thread_settings_errors.clear ();
+    }
+    return std::thread ([this, settings, body] {
+        std::vector<std::string> errors;
+        settings.apply (errors);
+        for (size_t i = 0; i < errors.size (); i++)
+        {
+            safe_logger (spdlog::level::warn, "acquisition thread: {}", errors[i]);
+        }
+        {
+            std::lock_guard<std::mutex> guard (thread_settings_mutex);
+            applied_thread_settings = ThreadSettings::get_current ();
+            thread_settings_errors = errors;
+            thread_settings_applied = true;
+        }
+        body ();
+    });
+}
+
+void Board::set_raw_scale (const char *channel_type, double scale)
+{
+    try
+    {
+        json descr = brainflow_boards_json["boards"][int_to_string (board_id)];
+        for (int row : descr[channel_type])
+        {
+            raw_scales[row] = scale;
+        }
+    }
+    catch (json::exception &e)
+    {
+        safe_logger (spdlog::level::err, e.what ());
+    }
+}
+
+void Board::get_buffer_layout (std::vector<int> &row_types, std::vector<double> &row_scales)
+{
+    int num_rows = (int)board_descr["num_rows"];
+    row_scales.assign (num_rows, 0.0);
+    if (storage_mode == (int)BufferStorageModes::FLOAT64)
+    {
+        row_types.assign (num_rows, (int)BufferStorageModes::FLOAT64);
+        return;
+    }
+    row_types.assign (num_rows, (int)BufferStorageModes::FLOAT32);
+    // timestamps need double precision, markers and other channels can hold arbitrary values
+    std::vector<std::string> double_fields {"timestamp_channel", "marker_channel"};
+    for (std::string field : double_fields)
+    {
+        if (board_descr.find (field) != board_descr.end ())
+        {
+            row_types[(int)board_descr[field]] = (int)BufferStorageModes::FLOAT64;
+        }
+    }
+    if (board_descr.find ("other_channels") != board_descr.end ())
+    {
+        for (int row : board_descr["other_channels"])
+        {
+            row_types[row] = (int)BufferStorageModes::FLOAT64;
+        }
+    }
+    if (storage_mode == (int)BufferStorageModes::INT32_RAW)
+    {
+        if (raw_scales.empty ())
+        {
+            safe_logger (spdlog::level::warn, "raw ADC values are not available, use float32");
+        }
+        for (auto it = raw_scales.begin (); it != raw_scales.end (); ++it)
+        {
+            row_types[it->first] = (int)BufferStorageModes::INT32_RAW;
+            row_scales[it->first] = it->second;
+        }
+    }
+}
+
 void Board::free_packages ()
 {
     if (db != NULL)
@@ -275,7 +613,7 @@ int Board::get_current_board_data (int num_samples, double *data_buf, int *retur
     }
     int num_rows = (int)board_descr["num_rows"];
 
-    double *buf = new double[num_samples * num_rows];
+    double *buf = new double[(size_t)num_samples * num_rows];
     int num_data_points = (int)db->get_current_data (num_samples, buf);
     reshape_data (num_data_points, buf, data_buf);
     delete[] buf;
@@ -283,6 +621,82 @@ int Board::get_current_board_data (int num_samples, double *data_buf, int *retur
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::add_consumer_cursor (std::string name)
+{
+    if ((name.empty ()) || (!cursor_names.insert (name).second))
+    {
+        safe_logger (spdlog::level::err, "cursor name {} is empty or already used", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (db)
+    {
+        db->add_cursor (name);
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::remove_consumer_cursor (std::string name)
+{
+    if (cursor_names.erase (name) == 0)
+    {
+        safe_logger (spdlog::level::err, "cursor {} is not found", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (db)
+    {
+        db->remove_cursor (name);
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_cursor_data_count (std::string name, int *result)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    size_t count = 0;
+    if ((!result) || (!db->get_cursor_data_count (name, &count)))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *result = (int)count;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_cursor_data (std::string name, int max_samples, double *data_buf,
+    int *returned_samples, int *lost_samples)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!data_buf) || (!returned_samples) || (!lost_samples) || (max_samples < 0))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = (int)board_descr["num_rows"];
+
+    double *buf = new double[(size_t)max_samples * num_rows];
+    size_t count = 0;
+    size_t lost = 0;
+    if (!db->get_cursor_data (name, max_samples, buf, &count, &lost))
+    {
+        delete[] buf;
+        safe_logger (spdlog::level::err, "cursor {} is not found", name);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (lost > 0)
+    {
+        safe_logger (spdlog::level::warn, "cursor {} was overrun, {} samples lost", name, lost);
+    }
+    reshape_data ((int)count, buf, data_buf);
+    delete[] buf;
+    *returned_samples = (int)count;
+    *lost_samples = (int)std::min (lost, (size_t)INT_MAX);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int Board::get_board_data_count (int *result)
 {
     if (!db)
@@ -298,6 +712,21 @@ int Board::get_board_data_count (int *result)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::get_dropped_data_count (int *result)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if (!result)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    *result = (int)db->get_dropped_count ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int Board::get_board_data (int data_count, double *data_buf)
 {
     if (!db)
@@ -309,13 +738,71 @@ int Board::get_board_data (int data_count, double *data_buf)
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
     int num_rows = (int)board_descr["num_rows"];
-    double *buf = new double[data_count * num_rows];
+    double *buf = new double[(size_t)data_count * num_rows];
     int num_data_points = (int)db->get_data (data_count, buf);
     reshape_data (num_data_points, buf, data_buf);
     delete[] buf;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int Board::get_board_data_range (
+    double start_time, double end_time, int num_samples, double *data_buf, int *returned_samples)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!data_buf) || (!returned_samples) || (num_samples < 0) || (end_time < start_time))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_rows = (int)board_descr["num_rows"];
+    int timestamp_channel = (int)board_descr["timestamp_channel"];
+
+    double *buf = new double[(size_t)num_samples * num_rows];
+    int num_data_points =
+        (int)db->get_data_range (timestamp_channel, start_time, end_time, num_samples, buf);
+    reshape_data (num_data_points, buf, data_buf);
+    delete[] buf;
+    *returned_samples = num_data_points;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_board_data_range_count (double start_time, double end_time, int *result)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!result) || (end_time < start_time))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int timestamp_channel = (int)board_descr["timestamp_channel"];
+    *result = (int)db->get_data_range (
+        timestamp_channel, start_time, end_time, (size_t)INT_MAX, NULL);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int Board::get_board_data_envelope (double start_time, double end_time, int num_points,
+    double *min_buf, double *max_buf, double *mean_buf, int *returned_points)
+{
+    if (!db)
+    {
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    if ((!min_buf) || (!max_buf) || (!mean_buf) || (!returned_points) || (num_points <= 0) ||
+        (end_time < start_time))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int timestamp_channel = (int)board_descr["timestamp_channel"];
+    // output is already row major, without summary all packages in range are scanned
+    *returned_points = (int)db->get_data_envelope (
+        timestamp_channel, start_time, end_time, num_points, min_buf, max_buf, mean_buf);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 void Board::reshape_data (int data_count, const double *buf, double *output_buf)
 {
     int num_rows = (int)board_descr["num_rows"];
@@ -324,7 +811,7 @@ void Board::reshape_data (int data_count, const double *buf, double *output_buf)
     {
         for (int j = 0; j < num_rows; j++)
         {
-            output_buf[j * data_count + i] = buf[i * num_rows + j];
+            output_buf[(size_t)j * data_count + i] = buf[(size_t)i * num_rows + j];
         }
     }
 }
@@ -34,6 +34,7 @@
 #include "gforce_pro.h"
 #include "ironbci.h"
 #include "notion_osc.h"
+#include "packet_capture.h"
 #include "playback_file_board.h"
 #include "streaming_board.h"
 #include "synthetic_board.h"
@@ -219,6 +220,143 @@ int insert_marker (double value, int board_id, char *json_brainflow_input_params
     return board_it->second->insert_marker (value);
 }
 
+int set_buffer_spill_file (
+    char *spill_file, int hot_buffer_size, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (spill_file == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->set_buffer_spill_file (spill_file, hot_buffer_size);
+}
+
+int set_buffer_storage_mode (int storage_mode, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->set_buffer_storage_mode (storage_mode);
+}
+
+int set_buffer_summary (int enabled, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->set_buffer_summary (enabled);
+}
+
+int set_spatial_filter (
+    double *filter, int num_channels, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->set_spatial_filter (filter, num_channels);
+}
+
+int add_consumer_cursor (char *cursor_name, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->add_consumer_cursor (cursor_name);
+}
+
+int remove_consumer_cursor (char *cursor_name, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->remove_consumer_cursor (cursor_name);
+}
+
+int get_cursor_data_count (
+    char *cursor_name, int *result, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_cursor_data_count (cursor_name, result);
+}
+
+int get_cursor_data (char *cursor_name, int max_samples, double *data_buf, int *returned_samples,
+    int *lost_samples, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (cursor_name == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_cursor_data (
+        cursor_name, max_samples, data_buf, returned_samples, lost_samples);
+}
+
 int release_session (int board_id, char *json_brainflow_input_params)
 {
     std::lock_guard<std::mutex> lock (mutex);
@@ -264,6 +402,20 @@ int get_board_data_count (int *result, int board_id, char *json_brainflow_input_
     return board_it->second->get_board_data_count (result);
 }
 
+int get_dropped_data_count (int *result, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_dropped_data_count (result);
+}
+
 int get_board_data (
     int data_count, double *data_buf, int board_id, char *json_brainflow_input_params)
 {
@@ -279,6 +431,139 @@ int get_board_data (
     return board_it->second->get_board_data (data_count, data_buf);
 }
 
+int get_board_data_range (double start_time, double end_time, int num_samples, double *data_buf,
+    int *returned_samples, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_board_data_range (
+        start_time, end_time, num_samples, data_buf, returned_samples);
+}
+
+int get_board_data_range_count (double start_time, double end_time, int *result, int board_id,
+    char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_board_data_range_count (start_time, end_time, result);
+}
+
+int get_board_data_envelope (double start_time, double end_time, int num_points, double *min_buf,
+    double *max_buf, double *mean_buf, int *returned_points, int board_id,
+    char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->get_board_data_envelope (
+        start_time, end_time, num_points, min_buf, max_buf, mean_buf, returned_points);
+}
+
+int set_acquisition_thread_settings (
+    char *json_settings, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if (json_settings == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    return board_it->second->set_acquisition_thread_settings (json_settings);
+}
+
+int get_acquisition_thread_settings (
+    char *result, int *result_len, int board_id, char *json_brainflow_input_params)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    if ((result == NULL) || (result_len == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::pair<int, struct BrainFlowInputParams> key;
+    int res = check_board_session (board_id, json_brainflow_input_params, key, false);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto board_it = boards.find (key);
+    std::string settings = "";
+    res = board_it->second->get_acquisition_thread_settings (settings);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        *result_len = (int)settings.length ();
+        strcpy (result, settings.c_str ());
+    }
+    return res;
+}
+
+int set_shared_reactor_threads (int num_threads)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    int res = SocketReactor::set_num_threads (num_threads);
+    switch (res)
+    {
+        case (int)SocketReactorReturnCodes::STATUS_OK:
+            Board::board_logger->info ("shared reactor threads: {}", num_threads);
+            return (int)BrainFlowExitCodes::STATUS_OK;
+        case (int)SocketReactorReturnCodes::INVALID_ARGUMENT_ERROR:
+            Board::board_logger->error ("number of reactor threads should be >= 0");
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        case (int)SocketReactorReturnCodes::SOCKETS_REGISTERED_ERROR:
+            Board::board_logger->error ("stop streaming before changing reactor threads");
+            return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+        case (int)SocketReactorReturnCodes::NOT_SUPPORTED_ERROR:
+            Board::board_logger->error ("shared reactor is not supported on this platform");
+            return (int)BrainFlowExitCodes::UNSUPPORTED_BOARD_ERROR;
+        default:
+            Board::board_logger->error ("failed to create shared reactor threads");
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+}
+
+int set_packet_capture (int mode, char *file, double rate)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    std::string file_name = (file == NULL) ? "" : file;
+    int res = PacketCapture::set_mode (mode, file_name, rate);
+    if (res != (int)PacketCaptureReturnCodes::STATUS_OK)
+    {
+        Board::board_logger->error (
+            "mode should be one of PacketCaptureModes, file should not be empty, rate >= 0");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    Board::board_logger->info (
+        "packet capture mode: {}, file: {}, rate: {}", mode, file_name, rate);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int set_log_level (int log_level)
 {
     std::lock_guard<std::mutex> lock (mutex);
@@ -78,7 +78,7 @@ int FreeEEG32::start_stream (int buffer_size, char *streamer_params)
     serial->flush_buffer ();
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
     is_streaming = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -2,16 +2,24 @@
 
 #include <cmath>
 #include <deque>
+#include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "board_controller.h"
 #include "brainflow_boards.h"
 #include "brainflow_constants.h"
 #include "brainflow_input_params.h"
 #include "data_buffer.h"
+#include "socket_reactor.h"
 #include "spinlock.h"
 #include "streamer.h"
+#include "thread_settings.h"
 
 #include "spdlog/spdlog.h"
 
@@ -37,6 +45,13 @@ public:
         skip_logs = false;
         db = NULL;
         streamer = NULL;
+        hot_buffer_size = 0;
+        storage_mode = (int)BufferStorageModes::FLOAT64;
+        summary_enabled = false;
+        is_drop_logged = false;
+        reactor = NULL;
+        reactor_socket = -1;
+        thread_settings_applied = false;
         this->board_id = board_id;
         this->params = params;
     }
@@ -48,8 +63,35 @@ public:
 
     int get_current_board_data (int num_samples, double *data_buf, int *returned_samples);
     int get_board_data_count (int *result);
+    // packages which were dropped because tiered ringbuffer couldnt store them
+    int get_dropped_data_count (int *result);
     int get_board_data (int data_count, double *data_buf);
+    int get_board_data_range (double start_time, double end_time, int num_samples,
+        double *data_buf, int *returned_samples);
+    int get_board_data_range_count (double start_time, double end_time, int *result);
+    int get_board_data_envelope (double start_time, double end_time, int num_points,
+        double *min_buf, double *max_buf, double *mean_buf, int *returned_points);
     int insert_marker (double value);
+    // named read positions in ringbuffer, each consumer gets all packages independently
+    int add_consumer_cursor (std::string name);
+    int remove_consumer_cursor (std::string name);
+    int get_cursor_data_count (std::string name, int *result);
+    int get_cursor_data (std::string name, int max_samples, double *data_buf,
+        int *returned_samples, int *lost_samples);
+    // applied on next start_stream, empty spill_file disables spilling
+    int set_buffer_spill_file (std::string spill_file, int hot_buffer_size);
+    // applied on next start_stream, one of BufferStorageModes
+    int set_buffer_storage_mode (int storage_mode);
+    // applied on next start_stream, keeps min/max/mean pyramid for get_board_data_envelope
+    int set_buffer_summary (int enabled);
+    // applied on next start_stream, running stream keeps its copy of the previous filter, filter
+    // is num_channels x num_channels matrix over eeg channels, each package is replaced by
+    // filter x package before it goes to buffer and streamer, num_channels 0 disables filtering
+    int set_spatial_filter (const double *filter, int num_channels);
+    // applied on next start_stream, json with optional cpus, policy, priority, nice and name
+    int set_acquisition_thread_settings (std::string json_settings);
+    // requested and actual settings of acquisition thread and errors of applying them as json
+    int get_acquisition_thread_settings (std::string &result);
 
     // Board::board_logger should not be called from destructors, to ensure that there are safe log
     // methods Board::board_logger still available but should be used only outside destructors
@@ -87,13 +129,50 @@ protected:
     json board_descr;
     SpinLock lock;
     std::deque<double> marker_queue;
+    std::string spill_file;
+    int hot_buffer_size;
+    int storage_mode;
+    bool summary_enabled;
+    bool is_drop_logged;
+    // requested by set_spatial_filter, acquisition thread uses only the copy below
+    std::vector<double> spatial_filter;
+    // copy of spatial filter, rows of eeg channels and their values before filtering, set in
+    // prepare_for_acquisition before acquisition thread starts
+    std::vector<double> acquisition_spatial_filter;
+    std::vector<int> spatial_filter_rows;
+    std::vector<double> spatial_filter_input;
+    // cursors are registered again in the new buffer on each start_stream
+    std::set<std::string> cursor_names;
+    // reactor which reads socket of this board instead of streaming thread
+    SocketReactor *reactor;
+    int reactor_socket;
+    ThreadSettings thread_settings;
+    // written by acquisition thread
+    std::mutex thread_settings_mutex;
+    bool thread_settings_applied;
+    ThreadSettings applied_thread_settings;
+    std::vector<std::string> thread_settings_errors;
+    // row -> scale for boards which provide raw ADC values, used in INT32_RAW storage mode
+    std::map<int, double> raw_scales;
 
     int prepare_for_acquisition (int buffer_size, char *streamer_params);
     void free_packages ();
     void push_package (double *package);
+    // registers read_package in shared reactor if it is enabled, read_package is called when
+    // socket is readable and should read one message, false means board needs its own thread
+    bool start_shared_reading (int socket_fd, std::function<void ()> read_package);
+    // false if board reads data in its own thread which should be joined
+    bool stop_shared_reading ();
+    // acquisition threads should be created here to apply thread settings before body is called
+    std::thread create_acquisition_thread (std::function<void ()> body);
+    // value of channels with this type is ADC count * scale
+    void set_raw_scale (const char *channel_type, double scale);
 
 private:
     int prepare_streamer (char *streamer_params);
+    void get_buffer_layout (std::vector<int> &row_types, std::vector<double> &row_scales);
+    int prepare_spatial_filter ();
+    void apply_spatial_filter (double *package);
     // reshapes data from DataBuffer format where all channels are mixed to linear buffer
     void reshape_data (int data_count, const double *buf, double *output_buf);
 };
@@ -24,14 +24,54 @@ extern "C"
         int *returned_samples, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION get_board_data_count (
         int *result, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_dropped_data_count (
+        int *result, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION get_board_data (
         int data_count, double *data_buf, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_range (double start_time,
+        double end_time, int num_samples, double *data_buf, int *returned_samples, int board_id,
+        char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_range_count (double start_time,
+        double end_time, int *result, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_board_data_envelope (double start_time,
+        double end_time, int num_points, double *min_buf, double *max_buf, double *mean_buf,
+        int *returned_points, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION config_board (char *config, char *response,
         int *response_len, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION is_prepared (
         int *prepared, int board_id, char *json_brainflow_input_params);
     SHARED_EXPORT int CALLING_CONVENTION insert_marker (
         double marker_value, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_buffer_spill_file (char *spill_file,
+        int hot_buffer_size, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_buffer_storage_mode (
+        int storage_mode, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_buffer_summary (
+        int enabled, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION set_spatial_filter (double *filter, int num_channels,
+        int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION add_consumer_cursor (
+        char *cursor_name, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION remove_consumer_cursor (
+        char *cursor_name, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_cursor_data_count (
+        char *cursor_name, int *result, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_cursor_data (char *cursor_name, int max_samples,
+        double *data_buf, int *returned_samples, int *lost_samples, int board_id,
+        char *json_brainflow_input_params);
+    // json_settings: {"cpus": [2, 3], "policy": "fifo", "priority": 50, "nice": -5, "name": "eeg"},
+    // all fields are optional, applied to acquisition thread on next start_stream
+    SHARED_EXPORT int CALLING_CONVENTION set_acquisition_thread_settings (
+        char *json_settings, int board_id, char *json_brainflow_input_params);
+    SHARED_EXPORT int CALLING_CONVENTION get_acquisition_thread_settings (
+        char *result, int *result_len, int board_id, char *json_brainflow_input_params);
+    // 0 threads(default) disables shared reactor, network boards started after this call are
+    // read by these threads instead of a thread per session, linux only
+    SHARED_EXPORT int CALLING_CONVENTION set_shared_reactor_threads (int num_threads);
+    // mode is one of PacketCaptureModes, applied to serial ports and udp sockets of sessions
+    // prepared after this call, each of them uses its own file: file, file.1, file.2...
+    // rate is replay speed relative to recorded timestamps, 0 replays as fast as possible
+    SHARED_EXPORT int CALLING_CONVENTION set_packet_capture (int mode, char *file, double rate);
 
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level (int log_level);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <thread>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
@@ -17,8 +18,10 @@ private:
     std::thread streaming_thread;
 
     MultiCastClient *client;
+    std::vector<double> package;
 
     void read_thread ();
+    void read_package ();
 
 public:
     StreamingBoard (struct BrainFlowInputParams params);
@@ -110,7 +110,7 @@ int IronBCI::start_stream (int buffer_size, char *streamer_params)
         return send_res;
     }
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
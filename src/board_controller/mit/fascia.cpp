@@ -80,8 +80,13 @@ int Fascia::start_stream (int buffer_size, char *streamer_params)
 
     // no command to start streaming, its on all the time, just create thread to read it
     // if you add command, send it here
+    package.assign ((int)board_descr["num_rows"], 0.0);
+    recv_buffer.assign (Fascia::transaction_size, 0);
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    if (!start_shared_reading (socket->get_socket_fd (), [this] { this->read_package (); }))
+    {
+        streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
+    }
     // wait for data to ensure that everything is okay(its optional)
     std::unique_lock<std::mutex> lk (m);
     auto sec = std::chrono::seconds (1);
@@ -107,7 +112,10 @@ int Fascia::stop_stream ()
     {
         keep_alive = false;
         is_streaming = false;
-        streaming_thread.join ();
+        if (!stop_shared_reading ())
+        {
+            streaming_thread.join ();
+        }
         state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
         // no command to stop, if you add to firmware send it here
         return (int)BrainFlowExitCodes::STATUS_OK;
@@ -135,91 +143,87 @@ int Fascia::release_session ()
 
 void Fascia::read_thread ()
 {
-    int res;
-    unsigned char b[Fascia::transaction_size];
-    int num_rows = board_descr["num_rows"];
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    while (keep_alive)
     {
-        package[i] = 0.0;
+        read_package ();
     }
-    std::vector<int> eeg_channels = board_descr["eeg_channels"];
+}
 
-    while (keep_alive)
+void Fascia::read_package ()
+{
+    int res;
+    unsigned char *b = recv_buffer.data ();
+    res = socket->recv (b, Fascia::transaction_size);
+    // log socket error
+    if (res == -1)
     {
-        res = socket->recv (b, Fascia::transaction_size);
-        // log socket error
-        if (res == -1)
-        {
 #ifdef _WIN32
-            safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
+        safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
 #else
-            safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
+        safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
 #endif
-        }
-        // log amount of bytes read
-        if (res != Fascia::transaction_size)
-        {
-            safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
-                Fascia::transaction_size, res);
-            continue;
-        }
-        else
+    }
+    // log amount of bytes read
+    if (res != Fascia::transaction_size)
+    {
+        safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
+            Fascia::transaction_size, res);
+        return;
+    }
+    else
+    {
+        // inform main thread that first package was received
+        if (state != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            // inform main thread that first package was received
-            if (state != (int)BrainFlowExitCodes::STATUS_OK)
+            safe_logger (spdlog::level::info,
+                "received first package with {} bytes streaming is started", res);
             {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
-                {
-                    std::lock_guard<std::mutex> lk (m);
-                    state = (int)BrainFlowExitCodes::STATUS_OK;
-                }
-                cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
+                std::lock_guard<std::mutex> lk (m);
+                state = (int)BrainFlowExitCodes::STATUS_OK;
             }
+            cv.notify_one ();
+            safe_logger (spdlog::level::debug, "start streaming");
         }
+    }
 
-        // start parsing
-        for (int cur_package = 0; cur_package < Fascia::num_packages; cur_package++)
+    // start parsing
+    for (int cur_package = 0; cur_package < Fascia::num_packages; cur_package++)
+    {
+        int offset = cur_package * Fascia::package_size;
+        int32_t package_num = 0;
+        memcpy (&package_num, b + offset, 4);
+        package[board_descr["package_num_channel"].get<int> ()] = (double)package_num;
+        int32_t valid = 0;
+        memcpy (&valid, b + 4 + offset, 4);
+        package[board_descr["other_channels"][0].get<int> ()] = (double)valid;
+        for (int i = 2, counter = 0; i < 10; i++, counter++)
         {
-            int offset = cur_package * Fascia::package_size;
-            int32_t package_num = 0;
-            memcpy (&package_num, b + offset, 4);
-            package[board_descr["package_num_channel"].get<int> ()] = (double)package_num;
-            int32_t valid = 0;
-            memcpy (&valid, b + 4 + offset, 4);
-            package[board_descr["other_channels"][0].get<int> ()] = (double)valid;
-            for (int i = 2, counter = 0; i < 10; i++, counter++)
-            {
-                float val;
-                // sends data in volts
-                memcpy (&val, b + offset + 8 + (i - 2) * 4, 4);
-                package[board_descr["eeg_channels"][counter].get<int> ()] = 1000000.0 * val;
-            }
-            for (int i = 10, counter = 0; i < 13; i++, counter++)
-            {
-                package[board_descr["accel_channels"][counter].get<int> ()] =
-                    accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
-            }
-            for (int i = 13, counter = 0; i < 16; i++, counter++)
-            {
-                package[board_descr["gyro_channels"][counter].get<int> ()] =
-                    accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
-            }
-
-            int32_t eda, temperature, timestamp, ppg;
-            memcpy (&eda, b + offset + 52, 4);
-            memcpy (&temperature, b + offset + 56, 4);
-            memcpy (&ppg, b + offset + 60, 4);
-            memcpy (&timestamp, b + offset + 64, 4);
-            package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
-            package[board_descr["temperature_channels"][0].get<int> ()] = (double)temperature;
-            package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg;
-            package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
-
-            push_package (package);
+            float val;
+            // sends data in volts
+            memcpy (&val, b + offset + 8 + (i - 2) * 4, 4);
+            package[board_descr["eeg_channels"][counter].get<int> ()] = 1000000.0 * val;
+        }
+        for (int i = 10, counter = 0; i < 13; i++, counter++)
+        {
+            package[board_descr["accel_channels"][counter].get<int> ()] =
+                accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
+        }
+        for (int i = 13, counter = 0; i < 16; i++, counter++)
+        {
+            package[board_descr["gyro_channels"][counter].get<int> ()] =
+                accel_scale * cast_16bit_to_int32 (b + offset + 40 + (i - 10) * 2);
         }
+
+        int32_t eda, temperature, timestamp, ppg;
+        memcpy (&eda, b + offset + 52, 4);
+        memcpy (&temperature, b + offset + 56, 4);
+        memcpy (&ppg, b + offset + 60, 4);
+        memcpy (&timestamp, b + offset + 64, 4);
+        package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
+        package[board_descr["temperature_channels"][0].get<int> ()] = (double)temperature;
+        package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg;
+        package[board_descr["timestamp_channel"].get<int> ()] = get_timestamp ();
+
+        push_package (package.data ());
     }
-    delete[] package;
 }
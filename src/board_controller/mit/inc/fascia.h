@@ -4,6 +4,7 @@
 #include <math.h>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
@@ -27,8 +28,11 @@ private:
     std::mutex m;
     std::condition_variable cv;
     volatile int state;
+    std::vector<double> package;
+    std::vector<unsigned char> recv_buffer;
 
     void read_thread ();
+    void read_package ();
 
 public:
     Fascia (struct BrainFlowInputParams params);
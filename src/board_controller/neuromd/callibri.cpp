@@ -162,7 +162,7 @@ int Callibri::start_stream (int buffer_size, char *streamer_params)
     }
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
     is_streaming = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
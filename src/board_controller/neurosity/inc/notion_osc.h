@@ -4,6 +4,7 @@
 #include <math.h>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
@@ -25,7 +26,10 @@ private:
     std::mutex m;
     std::condition_variable cv;
     volatile int state;
+    std::vector<double> package;
+    std::vector<unsigned char> recv_buffer;
     void read_thread ();
+    void read_package ();
 
     void handle_packet (double *package, const OSCPP::Server::Packet &packet);
 
@@ -76,8 +76,14 @@ int NotionOSC::start_stream (int buffer_size, char *streamer_params)
         return res;
     }
 
+    constexpr int max_package_size = 8192;
+    recv_buffer.assign (max_package_size, 0);
+    package.assign ((int)board_descr["num_rows"], 0.0);
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    if (!start_shared_reading (socket->get_socket_fd (), [this] { this->read_package (); }))
+    {
+        streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
+    }
     // wait for data to ensure that everything is okay
     std::unique_lock<std::mutex> lk (this->m);
     auto sec = std::chrono::seconds (1);
@@ -99,7 +105,10 @@ int NotionOSC::stop_stream ()
     if (keep_alive)
     {
         keep_alive = false;
-        streaming_thread.join ();
+        if (!stop_shared_reading ())
+        {
+            streaming_thread.join ();
+        }
         state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
@@ -131,52 +140,43 @@ int NotionOSC::release_session ()
 
 void NotionOSC::read_thread ()
 {
-    int res;
-    constexpr int max_package_size = 8192;
-    unsigned char b[max_package_size];
-    int num_rows = board_descr["num_rows"];
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    while (keep_alive)
     {
-        package[i] = 0.0;
+        read_package ();
     }
+}
 
-    while (keep_alive)
+void NotionOSC::read_package ()
+{
+    int res = socket->recv (recv_buffer.data (), (int)recv_buffer.size ());
+    if (res == -1)
     {
-        res = socket->recv (b, max_package_size);
-        if (res == -1)
-        {
 #ifdef _WIN32
-            safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
+        safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
 #else
-            safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
+        safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
 #endif
-            continue;
-        }
-        else
+        return;
+    }
+    if (state != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (
+            spdlog::level::info, "received first package with {} bytes streaming is started", res);
         {
-            if (state != (int)BrainFlowExitCodes::STATUS_OK)
-            {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
-                {
-                    std::lock_guard<std::mutex> lk (m);
-                    state = (int)BrainFlowExitCodes::STATUS_OK;
-                }
-                cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
-            }
-            try
-            {
-                handle_packet (package, OSCPP::Server::Packet (b, res));
-            }
-            catch (...)
-            {
-                // do nothing
-            }
+            std::lock_guard<std::mutex> lk (m);
+            state = (int)BrainFlowExitCodes::STATUS_OK;
         }
+        cv.notify_one ();
+        safe_logger (spdlog::level::debug, "start streaming");
+    }
+    try
+    {
+        handle_packet (package.data (), OSCPP::Server::Packet (recv_buffer.data (), res));
+    }
+    catch (...)
+    {
+        // do nothing
     }
-    delete[] package;
 }
 
 void NotionOSC::handle_packet (double *package, const OSCPP::Server::Packet &packet)
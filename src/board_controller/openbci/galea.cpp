@@ -24,6 +24,21 @@ Galea::Galea (struct BrainFlowInputParams params) : Board ((int)BoardIds::GALEA_
     initialized = false;
     state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
     time_delay = 0.0;
+    // the same order as in read_thread: 8 eeg channels from main board, then emg channels and 2
+    // eeg channels from sister board
+    for (int i = 0; i < 16; i++)
+    {
+        double scale = emg_scale;
+        if (i < 8)
+        {
+            scale = eeg_scale_main_board;
+        }
+        else if ((i == 9) || (i == 14))
+        {
+            scale = eeg_scale_sister_board;
+        }
+        raw_scales[i + 1] = scale;
+    }
 }
 
 Galea::~Galea ()
@@ -198,8 +213,13 @@ int Galea::start_stream (int buffer_size, char *streamer_params)
         return (int)BrainFlowExitCodes::BOARD_WRITE_ERROR;
     }
 
+    package.assign ((int)board_descr["num_rows"], 0.0);
+    recv_buffer.assign (Galea::transaction_size, 0);
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    if (!start_shared_reading (socket->get_socket_fd (), [this] { this->read_package (); }))
+    {
+        streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
+    }
     // wait for data to ensure that everything is okay
     std::unique_lock<std::mutex> lk (this->m);
     auto sec = std::chrono::seconds (1);
@@ -224,7 +244,10 @@ int Galea::stop_stream ()
     {
         keep_alive = false;
         is_streaming = false;
-        streaming_thread.join ();
+        if (!stop_shared_reading ())
+        {
+            streaming_thread.join ();
+        }
         this->state = (int)BrainFlowExitCodes::SYNC_TIMEOUT_ERROR;
         int res = socket->send ("s", 1);
         if (res != 1)
@@ -291,113 +314,106 @@ int Galea::release_session ()
 
 void Galea::read_thread ()
 {
-    int res;
-    unsigned char b[Galea::transaction_size];
-    constexpr int offset_last_package = Galea::package_size * (Galea::num_packages - 1);
-    for (int i = 0; i < Galea::transaction_size; i++)
-    {
-        b[i] = 0;
-    }
-    int num_rows = board_descr["num_rows"];
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    while (keep_alive)
     {
-        package[i] = 0.0;
+        read_package ();
     }
+}
 
-    while (keep_alive)
+void Galea::read_package ()
+{
+    int res;
+    unsigned char *b = recv_buffer.data ();
+    constexpr int offset_last_package = Galea::package_size * (Galea::num_packages - 1);
+    res = socket->recv (b, Galea::transaction_size);
+    double recv_time = get_timestamp () - time_delay;
+    if (res == -1)
     {
-        res = socket->recv (b, Galea::transaction_size);
-        double recv_time = get_timestamp () - time_delay;
-        if (res == -1)
-        {
 #ifdef _WIN32
-            safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
+        safe_logger (spdlog::level::err, "WSAGetLastError is {}", WSAGetLastError ());
 #else
-            safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
+        safe_logger (spdlog::level::err, "errno {} message {}", errno, strerror (errno));
 #endif
-        }
-        if (res != Galea::transaction_size)
+    }
+    if (res != Galea::transaction_size)
+    {
+        safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
+            Galea::transaction_size, res);
+        if (res > 0)
         {
-            safe_logger (spdlog::level::trace, "unable to read {} bytes, read {}",
-                Galea::transaction_size, res);
-            if (res > 0)
-            {
-                // more likely its a string received, try to print it
-                b[res] = '\0';
-                safe_logger (spdlog::level::warn, "Received: {}", b);
-            }
-            continue;
+            // more likely its a string received, try to print it
+            b[res] = '\0';
+            safe_logger (spdlog::level::warn, "Received: {}", b);
         }
-        else
+        return;
+    }
+    else
+    {
+        // inform main thread that everything is ok and first package was received
+        if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            // inform main thread that everything is ok and first package was received
-            if (this->state != (int)BrainFlowExitCodes::STATUS_OK)
+            safe_logger (spdlog::level::info,
+                "received first package with {} bytes streaming is started", res);
             {
-                safe_logger (spdlog::level::info,
-                    "received first package with {} bytes streaming is started", res);
-                {
-                    std::lock_guard<std::mutex> lk (this->m);
-                    this->state = (int)BrainFlowExitCodes::STATUS_OK;
-                }
-                this->cv.notify_one ();
-                safe_logger (spdlog::level::debug, "start streaming");
+                std::lock_guard<std::mutex> lk (this->m);
+                this->state = (int)BrainFlowExitCodes::STATUS_OK;
             }
+            this->cv.notify_one ();
+            safe_logger (spdlog::level::debug, "start streaming");
         }
+    }
 
-        for (int cur_package = 0; cur_package < Galea::num_packages; cur_package++)
+    for (int cur_package = 0; cur_package < Galea::num_packages; cur_package++)
+    {
+        int offset = cur_package * package_size;
+        // package num
+        package[board_descr["package_num_channel"].get<int> ()] = (double)b[0 + offset];
+        // eeg and emg
+        for (int i = 4, tmp_counter = 0; i < 20; i++, tmp_counter++)
         {
-            int offset = cur_package * package_size;
-            // package num
-            package[board_descr["package_num_channel"].get<int> ()] = (double)b[0 + offset];
-            // eeg and emg
-            for (int i = 4, tmp_counter = 0; i < 20; i++, tmp_counter++)
-            {
-                // put them directly after package num in brainflow
-                if (tmp_counter < 8)
-                    package[i - 3] = eeg_scale_main_board *
-                        (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                else if ((tmp_counter == 9) || (tmp_counter == 14))
-                    package[i - 3] = eeg_scale_sister_board *
-                        (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-                else
-                    package[i - 3] =
-                        emg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
-            }
-            uint16_t temperature;
-            int32_t ppg_ir;
-            int32_t ppg_red;
-            float eda;
-            memcpy (&temperature, b + 54 + offset, 2);
-            memcpy (&eda, b + 1 + offset, 4);
-            memcpy (&ppg_red, b + 56 + offset, 4);
-            memcpy (&ppg_ir, b + 60 + offset, 4);
-            // ppg
-            package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg_red;
-            package[board_descr["ppg_channels"][1].get<int> ()] = (double)ppg_ir;
-            // eda
-            package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
-            // temperature
-            package[board_descr["temperature_channels"][0].get<int> ()] = temperature / 100.0;
-            // battery
-            package[board_descr["battery_channel"].get<int> ()] = (double)b[53 + offset];
+            // put them directly after package num in brainflow
+            if (tmp_counter < 8)
+                package[i - 3] = eeg_scale_main_board *
+                    (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+            else if ((tmp_counter == 9) || (tmp_counter == 14))
+                package[i - 3] = eeg_scale_sister_board *
+                    (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+            else
+                package[i - 3] =
+                    emg_scale * (double)cast_24bit_to_int32 (b + offset + 5 + 3 * (i - 4));
+        }
+        uint16_t temperature;
+        int32_t ppg_ir;
+        int32_t ppg_red;
+        float eda;
+        memcpy (&temperature, b + 54 + offset, 2);
+        memcpy (&eda, b + 1 + offset, 4);
+        memcpy (&ppg_red, b + 56 + offset, 4);
+        memcpy (&ppg_ir, b + 60 + offset, 4);
+        // ppg
+        package[board_descr["ppg_channels"][0].get<int> ()] = (double)ppg_red;
+        package[board_descr["ppg_channels"][1].get<int> ()] = (double)ppg_ir;
+        // eda
+        package[board_descr["eda_channels"][0].get<int> ()] = (double)eda;
+        // temperature
+        package[board_descr["temperature_channels"][0].get<int> ()] = temperature / 100.0;
+        // battery
+        package[board_descr["battery_channel"].get<int> ()] = (double)b[53 + offset];
 
-            double timestamp_device_cur;
-            memcpy (&timestamp_device_cur, b + 64 + offset, 8);
-            double timestamp_device_last;
-            memcpy (&timestamp_device_last, b + 64 + offset_last_package, 8);
-            timestamp_device_cur /= 1e6; // convert usec to sec
-            timestamp_device_last /= 1e6;
-            double time_delta = timestamp_device_last - timestamp_device_cur;
+        double timestamp_device_cur;
+        memcpy (&timestamp_device_cur, b + 64 + offset, 8);
+        double timestamp_device_last;
+        memcpy (&timestamp_device_last, b + 64 + offset_last_package, 8);
+        timestamp_device_cur /= 1e6; // convert usec to sec
+        timestamp_device_last /= 1e6;
+        double time_delta = timestamp_device_last - timestamp_device_cur;
 
-            // workaround micros() overflow issue in firmware
-            double timestamp = (time_delta < 0) ? recv_time : recv_time - time_delta;
-            package[board_descr["timestamp_channel"].get<int> ()] = timestamp;
+        // workaround micros() overflow issue in firmware
+        double timestamp = (time_delta < 0) ? recv_time : recv_time - time_delta;
+        package[board_descr["timestamp_channel"].get<int> ()] = timestamp;
 
-            push_package (package);
-        }
+        push_package (package.data ());
     }
-    delete[] package;
 }
 
 int Galea::calc_delay ()
@@ -63,7 +63,8 @@ int GanglionWifi::start_stream (int buffer_size, char *streamer_params)
         if (res == (int)BrainFlowExitCodes::STATUS_OK)
         {
             keep_alive = true;
-            streaming_thread = std::thread ([this] { this->read_thread_impedance (); });
+            streaming_thread =
+                create_acquisition_thread ([this] { this->read_thread_impedance (); });
             return (int)BrainFlowExitCodes::STATUS_OK;
         }
         else
@@ -90,7 +91,7 @@ int GanglionWifi::start_stream (int buffer_size, char *streamer_params)
         http_release (request);
 
         keep_alive = true;
-        streaming_thread = std::thread ([this] { this->read_thread (); });
+        streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
     return (int)BrainFlowExitCodes::STATUS_OK;
@@ -19,5 +19,6 @@ public:
     Cyton (struct BrainFlowInputParams params)
         : OpenBCISerialBoard (params, (int)BoardIds::CYTON_BOARD)
     {
+        set_raw_scale ("eeg_channels", eeg_scale);
     }
 };
@@ -19,5 +19,6 @@ public:
     CytonDaisy (struct BrainFlowInputParams params)
         : OpenBCISerialBoard (params, (int)BoardIds::CYTON_DAISY_BOARD)
     {
+        set_raw_scale ("eeg_channels", eeg_scale);
     }
 };
@@ -20,6 +20,7 @@ public:
     CytonDaisyWifi (struct BrainFlowInputParams params)
         : OpenBCIWifiShieldBoard (params, (int)BoardIds::CYTON_DAISY_WIFI_BOARD)
     {
+        set_raw_scale ("eeg_channels", eeg_scale);
     }
 
     int prepare_session ();
@@ -20,6 +20,7 @@ public:
     CytonWifi (struct BrainFlowInputParams params)
         : OpenBCIWifiShieldBoard (params, (int)BoardIds::CYTON_WIFI_BOARD)
     {
+        set_raw_scale ("eeg_channels", eeg_scale);
     }
 
     int prepare_session ();
@@ -4,6 +4,7 @@
 #include <math.h>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "board.h"
 #include "board_controller.h"
@@ -32,7 +33,10 @@ private:
     std::condition_variable cv;
     volatile int state;
     volatile double time_delay;
+    std::vector<double> package;
+    std::vector<unsigned char> recv_buffer;
     void read_thread ();
+    void read_package ();
     int calc_delay ();
 
 public:
@@ -249,7 +249,7 @@ int OpenBCISerialBoard::start_stream (int buffer_size, char *streamer_params)
         return send_res;
     }
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
     is_streaming = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
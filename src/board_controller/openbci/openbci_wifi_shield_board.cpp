@@ -248,7 +248,7 @@ int OpenBCIWifiShieldBoard::start_stream (int buffer_size, char *streamer_params
     http_release (request);
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
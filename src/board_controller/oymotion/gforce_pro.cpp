@@ -132,7 +132,7 @@ int GforcePro::start_stream (int buffer_size, char *streamer_params)
     }
 
     keep_alive = true;
-    streaming_thread = std::thread ([this] { read_thread (); });
+    streaming_thread = create_acquisition_thread ([this] { read_thread (); });
 
     // wait for data to ensure that everything is okay
     std::unique_lock<std::mutex> lk (m);
@@ -87,8 +87,13 @@ int StreamingBoard::start_stream (int buffer_size, char *streamer_params)
         return res;
     }
 
+    // format for incomming package is determined by original board
+    package.assign ((int)board_descr["num_rows"], 0.0);
     keep_alive = true;
-    streaming_thread = std::thread ([this] { this->read_thread (); });
+    if (!start_shared_reading (client->get_socket_fd (), [this] { this->read_package (); }))
+    {
+        streaming_thread = create_acquisition_thread ([this] { this->read_thread (); });
+    }
     is_streaming = true;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -99,7 +104,10 @@ int StreamingBoard::stop_stream ()
     {
         keep_alive = false;
         is_streaming = false;
-        streaming_thread.join ();
+        if (!stop_shared_reading ())
+        {
+            streaming_thread.join ();
+        }
         return (int)BrainFlowExitCodes::STATUS_OK;
     }
     else
@@ -129,25 +137,21 @@ int StreamingBoard::release_session ()
 
 void StreamingBoard::read_thread ()
 {
-    // format for incomming package is determined by original board
-    int num_rows = board_descr["num_rows"];
-    int bytes_per_recv = sizeof (double) * num_rows;
-    double *package = new double[num_rows];
-    for (int i = 0; i < num_rows; i++)
+    while (keep_alive)
     {
-        package[i] = 0.0;
+        read_package ();
     }
+}
 
-    while (keep_alive)
+void StreamingBoard::read_package ()
+{
+    int bytes_per_recv = (int)(sizeof (double) * package.size ());
+    int res = client->recv (package.data (), bytes_per_recv);
+    if (res != bytes_per_recv)
     {
-        int res = client->recv (package, bytes_per_recv);
-        if (res != bytes_per_recv)
-        {
-            safe_logger (
-                spdlog::level::trace, "unable to read {} bytes, read {}", bytes_per_recv, res);
-            continue;
-        }
-        push_package (package);
+        safe_logger (
+            spdlog::level::trace, "unable to read {} bytes, read {}", bytes_per_recv, res);
+        return;
     }
-    delete[] package;
+    push_package (package.data ());
 }
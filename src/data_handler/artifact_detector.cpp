@@ -0,0 +1,214 @@
+#include <math.h>
+
+#include "artifact_detector.h"
+#include "brainflow_constants.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+ArtifactDetector::ArtifactDetector (int num_channels, int sampling_rate, int window_len,
+    const ArtifactThresholds &thresholds, bool interpolate)
+{
+    this->num_channels = num_channels;
+    this->window_len = window_len;
+    this->thresholds = thresholds;
+    this->interpolate = interpolate;
+    double w = 2.0 * M_PI * thresholds.line_freq / (double)sampling_rate;
+    rot_re = cos (w);
+    rot_im = -sin (w);
+    rot_n_re = cos (w * window_len);
+    rot_n_im = -sin (w * window_len);
+
+    history.resize ((size_t)num_channels * window_len, 0.0);
+    max_queue.resize ((size_t)num_channels * window_len, 0);
+    min_queue.resize ((size_t)num_channels * window_len, 0);
+    max_head.resize (num_channels, 0);
+    max_size.resize (num_channels, 0);
+    min_head.resize (num_channels, 0);
+    min_size.resize (num_channels, 0);
+    mean.resize (num_channels, 0.0);
+    m2.resize (num_channels, 0.0);
+    line_re.resize (num_channels, 0.0);
+    line_im.resize (num_channels, 0.0);
+    last_good.resize (num_channels, 0.0);
+    num_samples = 0;
+    samples_since_refresh = 0;
+}
+
+void ArtifactDetector::update (double *data, int data_len, int *flags)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    for (int i = 0; i < data_len; i++)
+    {
+        double good_sum = 0.0;
+        int good_count = 0;
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            double x = data[(size_t)channel * data_len + i];
+            int flag = add_sample (channel, x);
+            flags[(size_t)channel * data_len + i] = flag;
+            if (flag == (int)ArtifactTypes::NO_ARTIFACT)
+            {
+                good_sum += x;
+                good_count++;
+                last_good[channel] = x;
+            }
+        }
+        num_samples++;
+        samples_since_refresh++;
+        if (samples_since_refresh == window_len)
+        {
+            refresh ();
+        }
+        if (!interpolate)
+        {
+            continue;
+        }
+        // statistics are calculated for raw data, replacement affects only output
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            if (flags[(size_t)channel * data_len + i] != (int)ArtifactTypes::NO_ARTIFACT)
+            {
+                data[(size_t)channel * data_len + i] =
+                    (good_count > 0) ? good_sum / good_count : last_good[channel];
+            }
+        }
+    }
+}
+
+int ArtifactDetector::add_sample (int channel, double x)
+{
+    double *ring = history.data () + (size_t)channel * window_len;
+    int64_t *max_q = max_queue.data () + (size_t)channel * window_len;
+    int64_t *min_q = min_queue.data () + (size_t)channel * window_len;
+    int64_t t = num_samples;
+    int pos = (int)(t % window_len);
+    bool is_full = (t >= window_len);
+    double x_old = ring[pos];
+
+    // drop indices which leave the window, compare with values which stay in the window
+    while ((max_size[channel] > 0) && (max_q[max_head[channel]] <= t - window_len))
+    {
+        max_head[channel] = (max_head[channel] + 1) % window_len;
+        max_size[channel]--;
+    }
+    while ((min_size[channel] > 0) && (min_q[min_head[channel]] <= t - window_len))
+    {
+        min_head[channel] = (min_head[channel] + 1) % window_len;
+        min_size[channel]--;
+    }
+    while (max_size[channel] > 0)
+    {
+        int back = (max_head[channel] + max_size[channel] - 1) % window_len;
+        if (ring[max_q[back] % window_len] > x)
+        {
+            break;
+        }
+        max_size[channel]--;
+    }
+    while (min_size[channel] > 0)
+    {
+        int back = (min_head[channel] + min_size[channel] - 1) % window_len;
+        if (ring[min_q[back] % window_len] < x)
+        {
+            break;
+        }
+        min_size[channel]--;
+    }
+    ring[pos] = x;
+    max_q[(max_head[channel] + max_size[channel]) % window_len] = t;
+    max_size[channel]++;
+    min_q[(min_head[channel] + min_size[channel]) % window_len] = t;
+    min_size[channel]++;
+
+    // sliding Welford update
+    if (is_full)
+    {
+        double new_mean = mean[channel] + (x - x_old) / window_len;
+        m2[channel] += (x - x_old) * (x - new_mean + x_old - mean[channel]);
+        mean[channel] = new_mean;
+    }
+    else
+    {
+        double delta = x - mean[channel];
+        mean[channel] += delta / (double)(t + 1);
+        m2[channel] += delta * (x - mean[channel]);
+    }
+    // sliding dft at line frequency, x_old is zero while window is not full
+    double re = line_re[channel] * rot_re - line_im[channel] * rot_im;
+    double im = line_re[channel] * rot_im + line_im[channel] * rot_re;
+    line_re[channel] = re + x - x_old * rot_n_re;
+    line_im[channel] = im - x_old * rot_n_im;
+
+    if (t < window_len - 1)
+    {
+        return (int)ArtifactTypes::NO_ARTIFACT;
+    }
+    int flag = (int)ArtifactTypes::NO_ARTIFACT;
+    double peak_to_peak =
+        ring[max_q[max_head[channel]] % window_len] - ring[min_q[min_head[channel]] % window_len];
+    double variance = (m2[channel] > 0) ? m2[channel] / window_len : 0.0;
+    double stddev = sqrt (variance);
+    if ((thresholds.max_peak_to_peak > 0) && (peak_to_peak > thresholds.max_peak_to_peak))
+    {
+        flag |= (int)ArtifactTypes::AMPLITUDE;
+    }
+    if ((thresholds.min_std > 0) && (stddev < thresholds.min_std))
+    {
+        flag |= (int)ArtifactTypes::FLATLINE;
+    }
+    if ((thresholds.max_std > 0) && (stddev > thresholds.max_std))
+    {
+        flag |= (int)ArtifactTypes::VARIANCE;
+    }
+    if ((thresholds.line_freq > 0) && (thresholds.max_line_noise_ratio > 0) && (variance > 0))
+    {
+        // sinusoid with amplitude A has |S|^2 = (A * N / 2)^2 and power A^2 / 2
+        double line_power = 2.0 * (line_re[channel] * line_re[channel] +
+                                      line_im[channel] * line_im[channel]) /
+            ((double)window_len * window_len);
+        if (line_power / variance > thresholds.max_line_noise_ratio)
+        {
+            flag |= (int)ArtifactTypes::LINE_NOISE;
+        }
+    }
+    return flag;
+}
+
+void ArtifactDetector::refresh ()
+{
+    // recursive updates accumulate rounding errors, recompute them once per window
+    int oldest = (int)(num_samples % window_len);
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        const double *ring = history.data () + (size_t)channel * window_len;
+        int count = (num_samples < window_len) ? (int)num_samples : window_len;
+        double sum = 0.0;
+        double re = 0.0;
+        double im = 0.0;
+        for (int i = 0; i < window_len; i++)
+        {
+            int pos = oldest + i;
+            double x = ring[(pos >= window_len) ? pos - window_len : pos];
+            sum += x;
+            double new_re = re * rot_re - im * rot_im + x;
+            im = re * rot_im + im * rot_re;
+            re = new_re;
+        }
+        double channel_mean = sum / count;
+        double channel_m2 = 0.0;
+        for (int i = 0; i < count; i++)
+        {
+            int pos = (int)((num_samples - count + i) % window_len);
+            double delta = ring[pos] - channel_mean;
+            channel_m2 += delta * delta;
+        }
+        mean[channel] = channel_mean;
+        m2[channel] = channel_m2;
+        line_re[channel] = re;
+        line_im[channel] = im;
+    }
+    samples_since_refresh = 0;
+}
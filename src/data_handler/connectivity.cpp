@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <memory>
+#include <string.h>
+#include <vector>
+
+#include "connectivity.h"
+#include "fft_plan.h"
+#include "scratch_arena.h"
+#include "thread_pool.h"
+
+// channels are processed in square tiles, tile of accumulators fits into L1 cache
+#define CHANNEL_BLOCK_SIZE 16
+// number of datapoints per block for covariance, block for all channels stays in L2 cache
+#define TIME_BLOCK_SIZE 256
+
+
+void compute_csd_welch (const double *data, int num_channels, int data_len, int nfft, int overlap,
+    int sampling_rate, const double *window, int bin_start, int bin_end,
+    std::complex<double> *output)
+{
+    int step = nfft - overlap;
+    int num_segments = (data_len - nfft) / step + 1;
+    int num_bins = bin_end - bin_start;
+    std::shared_ptr<FFTPlan> plan = FFTPlan::get_plan (nfft);
+    ScratchScope scratch;
+    // layout is bins x segments x channels, spectra of all channels for a segment are contiguous
+    std::complex<double> *spectra =
+        scratch.alloc<std::complex<double>> ((size_t)num_bins * num_segments * num_channels);
+
+    // single fft per channel per segment
+    ThreadPool::parallel_for (0, num_channels, [&] (int channel) {
+        ScratchScope channel_scratch;
+        double *windowed = channel_scratch.alloc<double> (nfft);
+        std::complex<double> *spectrum = channel_scratch.alloc<std::complex<double>> (nfft / 2 + 1);
+        const double *channel_data = data + (size_t)channel * data_len;
+        for (int segment = 0; segment < num_segments; segment++)
+        {
+            const double *segment_data = channel_data + (size_t)segment * step;
+            for (int i = 0; i < nfft; i++)
+            {
+                windowed[i] = segment_data[i] * window[i];
+            }
+            plan->forward (windowed, spectrum);
+            for (int bin = 0; bin < num_bins; bin++)
+            {
+                spectra[((size_t)bin * num_segments + segment) * num_channels + channel] =
+                    spectrum[bin_start + bin];
+            }
+        }
+    });
+
+    // S_ij = sum over segments of X_i * conj (X_j), computed tile by tile for upper triangle
+    ThreadPool::parallel_for (0, num_bins, [&] (int bin) {
+        int k = bin_start + bin;
+        double scale = 1.0 / ((double)sampling_rate * (double)nfft * (double)num_segments);
+        if ((k != 0) && ((nfft % 2 != 0) || (k != nfft / 2)))
+        {
+            scale *= 2;
+        }
+        const std::complex<double> *x = spectra + (size_t)bin * num_segments * num_channels;
+        std::complex<double> *out = output + (size_t)bin * num_channels * num_channels;
+        double acc_re[CHANNEL_BLOCK_SIZE][CHANNEL_BLOCK_SIZE];
+        double acc_im[CHANNEL_BLOCK_SIZE][CHANNEL_BLOCK_SIZE];
+        for (int ib = 0; ib < num_channels; ib += CHANNEL_BLOCK_SIZE)
+        {
+            int i_end = std::min (ib + CHANNEL_BLOCK_SIZE, num_channels);
+            for (int jb = ib; jb < num_channels; jb += CHANNEL_BLOCK_SIZE)
+            {
+                int j_end = std::min (jb + CHANNEL_BLOCK_SIZE, num_channels);
+                memset (acc_re, 0, sizeof (acc_re));
+                memset (acc_im, 0, sizeof (acc_im));
+                for (int segment = 0; segment < num_segments; segment++)
+                {
+                    const std::complex<double> *row = x + (size_t)segment * num_channels;
+                    for (int i = ib; i < i_end; i++)
+                    {
+                        double a_re = row[i].real ();
+                        double a_im = row[i].imag ();
+                        for (int j = jb; j < j_end; j++)
+                        {
+                            double b_re = row[j].real ();
+                            double b_im = row[j].imag ();
+                            acc_re[i - ib][j - jb] += a_re * b_re + a_im * b_im;
+                            acc_im[i - ib][j - jb] += a_im * b_re - a_re * b_im;
+                        }
+                    }
+                }
+                // matrix is hermitian, fill lower triangle from the same tile
+                for (int i = ib; i < i_end; i++)
+                {
+                    for (int j = jb; j < j_end; j++)
+                    {
+                        double re = acc_re[i - ib][j - jb] * scale;
+                        double im = acc_im[i - ib][j - jb] * scale;
+                        out[(size_t)i * num_channels + j] = std::complex<double> (re, im);
+                        out[(size_t)j * num_channels + i] = std::complex<double> (re, -im);
+                    }
+                }
+            }
+        }
+    });
+}
+
+void compute_covariance_matrix (const double *data, int num_channels, int data_len, double *output)
+{
+    ScratchScope scratch;
+    double *centered = scratch.alloc<double> ((size_t)num_channels * data_len);
+    for (int i = 0; i < num_channels; i++)
+    {
+        const double *src = data + (size_t)i * data_len;
+        double *dst = centered + (size_t)i * data_len;
+        double mean = 0.0;
+        for (int j = 0; j < data_len; j++)
+        {
+            mean += src[j];
+        }
+        mean /= data_len;
+        for (int j = 0; j < data_len; j++)
+        {
+            dst[j] = src[j] - mean;
+        }
+    }
+
+    double norm = (data_len > 1) ? 1.0 / (double)(data_len - 1) : 1.0;
+    // rows have different amount of work in upper triangle, idle threads steal remaining rows
+    ThreadPool::parallel_for (0, num_channels, [&] (int i) {
+        const double *row_i = centered + (size_t)i * data_len;
+        ScratchScope row_scratch;
+        double *acc = row_scratch.alloc<double> (num_channels - i);
+        for (int j = i; j < num_channels; j++)
+        {
+            acc[j - i] = 0.0;
+        }
+        // row i block stays in L1 cache while it is multiplied by blocks of other rows
+        for (int t = 0; t < data_len; t += TIME_BLOCK_SIZE)
+        {
+            int t_end = std::min (t + TIME_BLOCK_SIZE, data_len);
+            for (int j = i; j < num_channels; j++)
+            {
+                const double *row_j = centered + (size_t)j * data_len;
+                double sum = 0.0;
+                for (int k = t; k < t_end; k++)
+                {
+                    sum += row_i[k] * row_j[k];
+                }
+                acc[j - i] += sum;
+            }
+        }
+        for (int j = i; j < num_channels; j++)
+        {
+            output[(size_t)i * num_channels + j] = acc[j - i] * norm;
+            output[(size_t)j * num_channels + i] = acc[j - i] * norm;
+        }
+    });
+}
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <complex>
 #include <math.h>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <stdint.h>
@@ -8,10 +11,22 @@
 #include <thread>
 #include <vector>
 
+#include "artifact_detector.h"
 #include "brainflow_constants.h"
+#include "connectivity.h"
 #include "data_handler.h"
 #include "downsample_operators.h"
+#include "fft_plan.h"
+#include "file_summary.h"
+#include "hilbert.h"
+#include "multitaper.h"
+#include "scratch_arena.h"
+#include "object_registry.h"
 #include "rolling_filter.h"
+#include "spatial_filter.h"
+#include "spectrogram.h"
+#include "ssvep_detector.h"
+#include "thread_pool.h"
 #include "wavelet_helpers.h"
 #include "window_functions.h"
 
@@ -20,14 +35,9 @@
 #include "wauxlib.h"
 #include "wavelib.h"
 
-#include "FFTReal.h"
 #include "spdlog/sinks/null_sink.h"
 #include "spdlog/spdlog.h"
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 #define LOGGER_NAME "data_logger"
 #define MAX_FILTER_ORDER 8
 
@@ -39,6 +49,11 @@ std::shared_ptr<spdlog::logger> data_logger =
 std::shared_ptr<spdlog::logger> data_logger = spdlog::stderr_logger_mt (LOGGER_NAME);
 #endif
 
+ObjectRegistry<Spectrogram> spectrograms;
+ObjectRegistry<HilbertFilter> hilbert_filters;
+ObjectRegistry<SSVEPDetector> ssvep_detectors;
+ObjectRegistry<ArtifactDetector> artifact_detectors;
+
 
 int set_log_file (char *log_file)
 {
@@ -88,12 +103,34 @@ int set_log_level (int level)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+int set_num_threads (int num_threads)
+{
+    int res = ThreadPool::set_num_threads (num_threads);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Number of threads must be >= 0, 0 means number of cores.");
+    }
+    return res;
+}
+
+int get_num_threads (int *num_threads)
+{
+    if (num_threads == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *num_threads = ThreadPool::get_num_threads ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 
 int perform_lowpass (double *data, int data_len, int sampling_rate, double cutoff, int order,
     int filter_type, double ripple)
 {
     double *filter_data[1];
     filter_data[0] = data;
+    // filter objects dont allocate memory inside, so filtering doesnt use heap at all
+    ScratchScope scratch;
     Dsp::Filter *f = NULL;
     if ((order < 1) || (order > MAX_FILTER_ORDER) || (!data))
     {
@@ -104,13 +141,16 @@ int perform_lowpass (double *data, int data_len, int sampling_rate, double cutof
     switch (static_cast<FilterTypes> (filter_type))
     {
         case FilterTypes::BUTTERWORTH:
-            f = new Dsp::FilterDesign<Dsp::Butterworth::Design::LowPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Butterworth::Design::LowPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::CHEBYSHEV_TYPE_1:
-            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::LowPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::ChebyshevI::Design::LowPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::BESSEL:
-            f = new Dsp::FilterDesign<Dsp::Bessel::Design::LowPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Bessel::Design::LowPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         default:
             data_logger->error ("Filter type {} is Invalid", filter_type);
@@ -127,7 +167,6 @@ int perform_lowpass (double *data, int data_len, int sampling_rate, double cutof
     }
     f->setParams (params);
     f->process (data_len, filter_data);
-    delete f;
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -135,6 +174,7 @@ int perform_lowpass (double *data, int data_len, int sampling_rate, double cutof
 int perform_highpass (double *data, int data_len, int sampling_rate, double cutoff, int order,
     int filter_type, double ripple)
 {
+    ScratchScope scratch;
     Dsp::Filter *f = NULL;
     double *filter_data[1];
     filter_data[0] = data;
@@ -148,13 +188,16 @@ int perform_highpass (double *data, int data_len, int sampling_rate, double cuto
     switch (static_cast<FilterTypes> (filter_type))
     {
         case FilterTypes::BUTTERWORTH:
-            f = new Dsp::FilterDesign<Dsp::Butterworth::Design::HighPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Butterworth::Design::HighPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::CHEBYSHEV_TYPE_1:
-            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::HighPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::ChebyshevI::Design::HighPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::BESSEL:
-            f = new Dsp::FilterDesign<Dsp::Bessel::Design::HighPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Bessel::Design::HighPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         default:
             data_logger->error ("Filter type {} is Invalid", filter_type);
@@ -170,7 +213,6 @@ int perform_highpass (double *data, int data_len, int sampling_rate, double cuto
     }
     f->setParams (params);
     f->process (data_len, filter_data);
-    delete f;
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -178,6 +220,7 @@ int perform_highpass (double *data, int data_len, int sampling_rate, double cuto
 int perform_bandpass (double *data, int data_len, int sampling_rate, double center_freq,
     double band_width, int order, int filter_type, double ripple)
 {
+    ScratchScope scratch;
     Dsp::Filter *f = NULL;
     double *filter_data[1];
     filter_data[0] = data;
@@ -191,13 +234,16 @@ int perform_bandpass (double *data, int data_len, int sampling_rate, double cent
     switch (static_cast<FilterTypes> (filter_type))
     {
         case FilterTypes::BUTTERWORTH:
-            f = new Dsp::FilterDesign<Dsp::Butterworth::Design::BandPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Butterworth::Design::BandPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::CHEBYSHEV_TYPE_1:
-            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::BESSEL:
-            f = new Dsp::FilterDesign<Dsp::Bessel::Design::BandPass<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Bessel::Design::BandPass<MAX_FILTER_ORDER>, 1>> ();
             break;
         default:
             data_logger->error ("Filter type {} is Invalid. ", filter_type);
@@ -216,7 +262,6 @@ int perform_bandpass (double *data, int data_len, int sampling_rate, double cent
     f->setParams (params);
 
     f->process (data_len, filter_data);
-    delete f;
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -224,6 +269,7 @@ int perform_bandpass (double *data, int data_len, int sampling_rate, double cent
 int perform_bandstop (double *data, int data_len, int sampling_rate, double center_freq,
     double band_width, int order, int filter_type, double ripple)
 {
+    ScratchScope scratch;
     Dsp::Filter *f = NULL;
     double *filter_data[1];
     filter_data[0] = data;
@@ -237,13 +283,16 @@ int perform_bandstop (double *data, int data_len, int sampling_rate, double cent
     switch (static_cast<FilterTypes> (filter_type))
     {
         case FilterTypes::BUTTERWORTH:
-            f = new Dsp::FilterDesign<Dsp::Butterworth::Design::BandStop<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Butterworth::Design::BandStop<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::CHEBYSHEV_TYPE_1:
-            f = new Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandStop<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::ChebyshevI::Design::BandStop<MAX_FILTER_ORDER>, 1>> ();
             break;
         case FilterTypes::BESSEL:
-            f = new Dsp::FilterDesign<Dsp::Bessel::Design::BandStop<MAX_FILTER_ORDER>, 1> ();
+            f = scratch.create<
+                Dsp::FilterDesign<Dsp::Bessel::Design::BandStop<MAX_FILTER_ORDER>, 1>> ();
             break;
         default:
             data_logger->error ("Filter type {} is Invalid", filter_type);
@@ -261,7 +310,6 @@ int perform_bandstop (double *data, int data_len, int sampling_rate, double cent
     }
     f->setParams (params);
     f->process (data_len, filter_data);
-    delete f;
 
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -451,10 +499,12 @@ int perform_wavelet_denoising (double *data, int data_len, char *wavelet, int de
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    denoise_object obj;
-    double *temp = new double[data_len];
+    ScratchScope scratch;
+    denoise_object obj = NULL;
+    double *temp = NULL;
     try
     {
+        temp = scratch.alloc<double> (data_len);
         obj = denoise_init (data_len, decomposition_level, wavelet);
         setDenoiseMethod (obj, "visushrink");
         setDenoiseWTMethod (obj, "dwt");
@@ -465,16 +515,10 @@ int perform_wavelet_denoising (double *data, int data_len, char *wavelet, int de
         {
             data[i] = temp[i];
         }
-        delete[] temp;
-        temp = NULL;
         denoise_free (obj);
     }
     catch (...)
     {
-        if (temp)
-        {
-            delete[] temp;
-        }
         if (obj)
         {
             denoise_free (obj);
@@ -517,78 +561,40 @@ int get_window (int window_function, int window_len, double *output_window)
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
-/*
-   FFTReal output | Positive FFT equiv.   | Negative FFT equiv.
-   ---------------+-----------------------+-----------------------
-   f [0]          | Real (bin 0)          | Real (bin 0)
-   f [...]        | Real (bin ...)        | Real (bin ...)
-   f [length/2]   | Real (bin length/2)   | Real (bin length/2)
-   f [length/2+1] | Imag (bin 1)          | -Imag (bin 1)
-   f [...]        | Imag (bin ...)        | -Imag (bin ...)
-   f [length-1]   | Imag (bin length/2-1) | -Imag (bin length/2-1)
-
-And FFT bins are distributed in f [] as above:
-
-               |                | Positive FFT    | Negative FFT
-   Bin         | Real part      | imaginary part  | imaginary part
-   ------------+----------------+-----------------+---------------
-   0           | f [0]          | 0               | 0
-   1           | f [1]          | f [length/2+1]  | -f [length/2+1]
-   ...         | f [...],       | f [...]         | -f [...]
-   length/2-1  | f [length/2-1] | f [length-1]    | -f [length-1]
-   length/2    | f [length/2]   | 0               | 0
-   length/2+1  | f [length/2-1] | -f [length-1]   | f [length-1]
-   ...         | f [...]        | -f [...]        | f [...]
-   length-1    | f [1]          | -f [length/2+1] | f [length/2+1]
-*/
 int perform_fft (
     double *data, int data_len, int window_function, double *output_re, double *output_im)
 {
-    // must be power of 2
-    if ((!data) || (!output_re) || (!output_im) || (data_len <= 0) || (data_len & (data_len - 1)))
+    if ((!data) || (!output_re) || (!output_im) || (data_len <= 0))
     {
-        data_logger->error ("Please check to make sure all arguments aren't empty and data_len is "
-                            "a postive power of 2.");
+        data_logger->error (
+            "Please check to make sure all arguments aren't empty and data_len is positive.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
 
-    double *windowed_data = new double[data_len];
-    get_window (window_function, data_len, windowed_data);
-    for (int i = 0; i < data_len; i++)
-    {
-        windowed_data[i] *= data[i];
-    }
-    double *temp = new double[data_len];
     try
     {
-        ffft::FFTReal<double> fft_object (data_len);
-        fft_object.do_fft (temp, windowed_data);
-        for (int i = 0; i < data_len / 2 + 1; i++)
+        ScratchScope scratch;
+        double *windowed_data = scratch.alloc<double> (data_len);
+        int res = get_window (window_function, data_len, windowed_data);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            output_re[i] = temp[i];
+            return res;
+        }
+        for (int i = 0; i < data_len; i++)
+        {
+            windowed_data[i] *= data[i];
         }
-        output_im[0] = 0.0;
-        for (int count = 1, j = data_len / 2 + 1; j < data_len; j++, count++)
+        std::shared_ptr<FFTPlan> plan = FFTPlan::get_plan (data_len);
+        std::complex<double> *temp = scratch.alloc<std::complex<double>> (data_len / 2 + 1);
+        plan->forward (windowed_data, temp);
+        for (int i = 0; i < data_len / 2 + 1; i++)
         {
-            // add minus to make output exactly as in scipy
-            output_im[count] = -temp[j];
+            output_re[i] = temp[i].real ();
+            output_im[i] = temp[i].imag ();
         }
-        output_im[data_len / 2] = 0.0;
-        delete[] temp;
-        delete[] windowed_data;
-        windowed_data = NULL;
-        temp = NULL;
     }
     catch (...)
     {
-        if (temp)
-        {
-            delete[] temp;
-        }
-        if (windowed_data)
-        {
-            delete[] windowed_data;
-        }
         data_logger->error ("Error with doing FFT processing.");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
@@ -598,38 +604,25 @@ int perform_fft (
 // data_len here is an original size, not len of input_re input_im
 int perform_ifft (double *input_re, double *input_im, int data_len, double *restored_data)
 {
-    // must be power of 2
-    if ((!restored_data) || (!input_re) || (!input_im) || (data_len <= 0) ||
-        (data_len & (data_len - 1)))
+    if ((!restored_data) || (!input_re) || (!input_im) || (data_len <= 0))
     {
-        data_logger->error ("Please check to make sure all arguments aren't empty and data_len is "
-                            "a postive power of 2.");
+        data_logger->error (
+            "Please check to make sure all arguments aren't empty and data_len is positive.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *temp = new double[data_len];
     try
     {
-        ffft::FFTReal<double> fft_object (data_len);
+        ScratchScope scratch;
+        std::shared_ptr<FFTPlan> plan = FFTPlan::get_plan (data_len);
+        std::complex<double> *temp = scratch.alloc<std::complex<double>> (data_len / 2 + 1);
         for (int i = 0; i < data_len / 2 + 1; i++)
         {
-            temp[i] = input_re[i];
-        }
-        for (int count = 1, j = data_len / 2 + 1; j < data_len; j++, count++)
-        {
-            // add minus to make output exactly as in scipy
-            temp[j] = -input_im[count];
+            temp[i] = std::complex<double> (input_re[i], input_im[i]);
         }
-        fft_object.do_ifft (temp, restored_data);
-        fft_object.rescale (restored_data);
-        delete[] temp;
-        temp = NULL;
+        plan->inverse (temp, restored_data);
     }
     catch (...)
     {
-        if (temp)
-        {
-            delete[] temp;
-        }
         data_logger->error ("Error with doing inverse FFT.");
         return (int)BrainFlowExitCodes::GENERAL_ERROR;
     }
@@ -639,20 +632,19 @@ int perform_ifft (double *input_re, double *input_im, int data_len, double *rest
 int get_psd (double *data, int data_len, int sampling_rate, int window_function,
     double *output_ampl, double *output_freq)
 {
-    if ((data == NULL) || (sampling_rate < 1) || (data_len < 1) || (data_len & (data_len - 1)) ||
-        (output_ampl == NULL) || (output_freq == NULL))
+    if ((data == NULL) || (sampling_rate < 1) || (data_len < 1) || (output_ampl == NULL) ||
+        (output_freq == NULL))
     {
         data_logger->error ("Please check to make sure all arguments aren't empty, sampling rate "
-                            "is >=1 and data_len is a postive power of 2.");
+                            "is >=1 and data_len is positive.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *re = new double[data_len / 2 + 1];
-    double *im = new double[data_len / 2 + 1];
+    ScratchScope scratch;
+    double *re = scratch.alloc<double> (data_len / 2 + 1);
+    double *im = scratch.alloc<double> (data_len / 2 + 1);
     int res = perform_fft (data, data_len, window_function, re, im);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
-        delete[] re;
-        delete[] im;
         return res;
     }
     double freq_res = (double)sampling_rate / (double)data_len;
@@ -660,14 +652,13 @@ int get_psd (double *data, int data_len, int sampling_rate, int window_function,
     {
         // https://www.mathworks.com/help/signal/ug/power-spectral-density-estimates-using-fft.html
         output_ampl[i] = (re[i] * re[i] + im[i] * im[i]) / ((double)(sampling_rate * data_len));
-        if ((i != 0) && (i != data_len / 2))
+        // for odd data_len there is no nyquist bin and the last bin should be doubled too
+        if ((i != 0) && ((data_len % 2 != 0) || (i != data_len / 2)))
         {
             output_ampl[i] *= 2;
         }
         output_freq[i] = i * freq_res;
     }
-    delete[] re;
-    delete[] im;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
@@ -705,6 +696,84 @@ int get_band_power (double *ampl, double *freq, int data_len, double freq_start,
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
+// band i covers trapezoids [ranges[2 * i], ranges[2 * i + 1]), the same bins as in get_band_power
+static int get_band_ranges (double *freq, int data_len, double *freq_starts, double *freq_ends,
+    int num_bands, int *ranges)
+{
+    double *freq_last = freq + data_len - 1;
+    for (int i = 0; i < num_bands; i++)
+    {
+        if (freq_starts[i] > freq_ends[i])
+        {
+            data_logger->error ("freq_start > freq_end for band {}", i);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        // freq is sorted, first bin >= freq_start and first bin > freq_end
+        ranges[2 * i] = (int)(std::lower_bound (freq, freq_last, freq_starts[i]) - freq);
+        ranges[2 * i + 1] = (int)(std::upper_bound (freq, freq_last, freq_ends[i]) - freq);
+        if (ranges[2 * i + 1] <= ranges[2 * i])
+        {
+            data_logger->error ("No data between freq_end and freq_start for band {}", i);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// trapezoids are computed once and shared by all bands, so overlapping bands are cheap
+static void integrate_bands (double *ampl, double freq_res, int data_len, int *ranges,
+    int num_bands, double *trapezoids, double *band_powers)
+{
+    for (int i = 0; i < data_len - 1; i++)
+    {
+        trapezoids[i] = 0.5 * freq_res * (ampl[i] + ampl[i + 1]);
+    }
+    for (int i = 0; i < num_bands; i++)
+    {
+        double res = 0.0;
+        for (int j = ranges[2 * i]; j < ranges[2 * i + 1]; j++)
+        {
+            res += trapezoids[j];
+        }
+        band_powers[i] = res;
+    }
+}
+
+int get_band_powers (double *ampl, double *freq, int data_len, double *freq_starts,
+    double *freq_ends, int num_bands, double *band_powers)
+{
+    return get_multichannel_band_powers (
+        ampl, 1, freq, data_len, freq_starts, freq_ends, num_bands, band_powers);
+}
+
+int get_multichannel_band_powers (double *ampls, int num_channels, double *freq, int data_len,
+    double *freq_starts, double *freq_ends, int num_bands, double *band_powers)
+{
+    if ((ampls == NULL) || (freq == NULL) || (freq_starts == NULL) || (freq_ends == NULL) ||
+        (band_powers == NULL) || (num_channels < 1) || (num_bands < 1) || (data_len < 2))
+    {
+        data_logger->error ("Please check to make sure all arguments aren't empty, num_channels "
+                            ">= 1, num_bands >= 1 and data_len >= 2");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // bin ranges depend only on freq, compute them once for all channels
+    ScratchScope scratch;
+    int *ranges = scratch.alloc<int> (2 * num_bands);
+    int res = get_band_ranges (freq, data_len, freq_starts, freq_ends, num_bands, ranges);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    double freq_res = freq[1] - freq[0];
+    double *trapezoids = scratch.alloc<double> (data_len - 1);
+    for (int i = 0; i < num_channels; i++)
+    {
+        integrate_bands (ampls + (size_t)i * data_len, freq_res, data_len, ranges, num_bands,
+            trapezoids, band_powers + (size_t)i * num_bands);
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int get_nearest_power_of_two (int value, int *output)
 {
     if (value < 0)
@@ -939,13 +1008,14 @@ int detrend (double *data, int data_len, int detrend_operation)
 int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampling_rate,
     int window_function, double *output_ampl, double *output_freq)
 {
-    if ((data == NULL) || (data_len < 1) || (nfft & (nfft - 1)) || (output_ampl == NULL) ||
+    if ((data == NULL) || (data_len < 1) || (nfft < 1) || (output_ampl == NULL) ||
         (output_freq == NULL) || (sampling_rate < 1) || (overlap < 0) || (overlap > nfft))
     {
         data_logger->error ("Please review your arguments.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    double *ampls = new double[nfft / 2 + 1];
+    ScratchScope scratch;
+    double *ampls = scratch.alloc<double> (nfft / 2 + 1);
     int counter = 0;
     for (int i = 0; i < nfft / 2 + 1; i++)
     {
@@ -956,7 +1026,6 @@ int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampli
         int res = get_psd (data + pos, nfft, sampling_rate, window_function, ampls, output_freq);
         if (res != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            delete[] ampls;
             return res;
         }
         for (int i = 0; i < nfft / 2 + 1; i++)
@@ -964,7 +1033,6 @@ int get_psd_welch (double *data, int data_len, int nfft, int overlap, int sampli
             output_ampl[i] += ampls[i];
         }
     }
-    delete[] ampls;
     if (counter == 0)
     {
         data_logger->error ("Nfft must be less than data_len.");
@@ -990,7 +1058,8 @@ int get_avg_band_powers (double *raw_data, int rows, int cols, int sampling_rate
     }
 
     // rows - channels, cols - datapoints
-    int *exit_codes = new int[rows];
+    ScratchScope scratch;
+    int *exit_codes = scratch.alloc<int> (rows);
     for (int i = 0; i < rows; i++)
     {
         exit_codes[i] = (int)BrainFlowExitCodes::STATUS_OK;
@@ -999,21 +1068,22 @@ int get_avg_band_powers (double *raw_data, int rows, int cols, int sampling_rate
     get_nearest_power_of_two (sampling_rate, &nfft);
     nfft *= 2; // for resolution ~ 0.5
     // handle the case if nfft > number of data points
-    // its valid case but results will not be accurate
-    while (nfft > cols)
+    // its valid case but results will not be accurate, fft supports any size so use all datapoints
+    if (nfft > cols)
     {
-        nfft /= 2;
+        nfft = cols;
     }
     if (nfft < 8)
     {
         data_logger->error ("Not enough data for calculation.");
-        delete[] exit_codes;
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
-    double **bands = new double *[5];
+    double band_starts[5] = {1.5, 4.0, 7.5, 13.0, 30.0};
+    double band_ends[5] = {4.0, 8.0, 13.0, 30.0, 45.0};
+    double **bands = scratch.alloc<double *> (5);
     for (int i = 0; i < 5; i++)
     {
-        bands[i] = new double[rows];
+        bands[i] = scratch.alloc<double> (rows);
         // to make valgrind happy
         for (int j = 0; j < rows; j++)
         {
@@ -1021,12 +1091,12 @@ int get_avg_band_powers (double *raw_data, int rows, int cols, int sampling_rate
         }
     }
 
-#pragma omp parallel for
-    for (int i = 0; i < rows; i++)
-    {
-        double *ampls = new double[nfft / 2 + 1];
-        double *freqs = new double[nfft / 2 + 1];
-        double *thread_data = new double[cols];
+    ThreadPool::parallel_for (0, rows, [&] (int i) {
+        // arena of the thread which processes this row
+        ScratchScope row_scratch;
+        double *ampls = row_scratch.alloc<double> (nfft / 2 + 1);
+        double *freqs = row_scratch.alloc<double> (nfft / 2 + 1);
+        double *thread_data = row_scratch.alloc<double> (cols);
         memcpy (thread_data, raw_data + i * cols, sizeof (double) * cols);
 
         if (apply_filters)
@@ -1054,42 +1124,21 @@ int get_avg_band_powers (double *raw_data, int rows, int cols, int sampling_rate
             (int)WindowFunctions::HANNING, ampls, freqs);
         if (exit_codes[i] == (int)BrainFlowExitCodes::STATUS_OK)
         {
-            exit_codes[i] = get_band_power (ampls, freqs, nfft / 2 + 1, 1.5, 4.0, &bands[0][i]);
-        }
-        if (exit_codes[i] == (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            exit_codes[i] = get_band_power (ampls, freqs, nfft / 2 + 1, 4.0, 8.0, &bands[1][i]);
-        }
-        if (exit_codes[i] == (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            exit_codes[i] = get_band_power (ampls, freqs, nfft / 2 + 1, 7.5, 13.0, &bands[2][i]);
-        }
-        if (exit_codes[i] == (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            exit_codes[i] = get_band_power (ampls, freqs, nfft / 2 + 1, 13.0, 30.0, &bands[3][i]);
-        }
-        if (exit_codes[i] == (int)BrainFlowExitCodes::STATUS_OK)
-        {
-            exit_codes[i] = get_band_power (ampls, freqs, nfft / 2 + 1, 30.0, 45.0, &bands[4][i]);
+            double channel_bands[5];
+            exit_codes[i] = get_band_powers (
+                ampls, freqs, nfft / 2 + 1, band_starts, band_ends, 5, channel_bands);
+            for (int j = 0; j < 5; j++)
+            {
+                bands[j][i] = channel_bands[j];
+            }
         }
-
-        delete[] ampls;
-        delete[] freqs;
-        delete[] thread_data;
-    }
+    });
 
     for (int i = 0; i < rows; i++)
     {
         if (exit_codes[i] != (int)BrainFlowExitCodes::STATUS_OK)
         {
-            int ec = exit_codes[i];
-            delete[] exit_codes;
-            for (int j = 0; j < 5; j++)
-            {
-                delete[] bands[j];
-            }
-            delete[] bands;
-            return ec;
+            return exit_codes[i];
         }
     }
 
@@ -1125,12 +1174,713 @@ int get_avg_band_powers (double *raw_data, int rows, int cols, int sampling_rate
         stddev_band_powers[i] = std_bands[i] / avg_bands[i];
     }
 
-    delete[] exit_codes;
-    for (int j = 0; j < 5; j++)
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_spectrogram (int num_channels, int nfft, int hop, int sampling_rate,
+    int window_function, int log_power, int *spectrogram_id)
+{
+    if ((num_channels < 1) || (nfft < 1) || (hop < 1) || (sampling_rate < 1) ||
+        (spectrogram_id == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    double *window = new double[nfft];
+    int res = get_window (window_function, nfft, window);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] window;
+        return res;
+    }
+    try
+    {
+        std::shared_ptr<Spectrogram> spectrogram = std::make_shared<Spectrogram> (
+            num_channels, nfft, hop, sampling_rate, window, (bool)log_power);
+        *spectrogram_id = spectrograms.add (spectrogram);
+    }
+    catch (...)
+    {
+        delete[] window;
+        data_logger->error ("Failed to allocate spectrogram.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    delete[] window;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int update_spectrogram (int spectrogram_id, double *data, int num_channels, int data_len,
+    int max_columns, double *output, int *num_columns)
+{
+    if ((data == NULL) || (data_len < 0) || (max_columns < 0) || (output == NULL) ||
+        (num_columns == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<Spectrogram> spectrogram = spectrograms.get (spectrogram_id);
+    if (!spectrogram)
+    {
+        data_logger->error ("Spectrogram {} doesn't exist.", spectrogram_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (spectrogram->get_num_channels () != num_channels)
+    {
+        data_logger->error ("Spectrogram was created for {} channels, provided {}.",
+            spectrogram->get_num_channels (), num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int res = spectrogram->update (data, data_len, max_columns, output, num_columns);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Output buffer for {} columns is too small.", max_columns);
+    }
+    return res;
+}
+
+int release_spectrogram (int spectrogram_id)
+{
+    if (!spectrograms.remove (spectrogram_id))
+    {
+        data_logger->error ("Spectrogram {} doesn't exist.", spectrogram_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_spectrogram_output_shape (
+    int spectrogram_id, int data_len, int *num_columns, int *num_bins)
+{
+    if ((data_len < 0) || (num_columns == NULL) || (num_bins == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<Spectrogram> spectrogram = spectrograms.get (spectrogram_id);
+    if (!spectrogram)
+    {
+        data_logger->error ("Spectrogram {} doesn't exist.", spectrogram_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    *num_columns = spectrogram->get_num_columns (data_len);
+    *num_bins = spectrogram->get_num_bins ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_csd_welch (double *data, int num_channels, int data_len, int nfft, int overlap,
+    int sampling_rate, int window_function, double *output_re, double *output_im,
+    double *output_freq)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 1) || (nfft < 1) ||
+        (sampling_rate < 1) || (overlap < 0) || (overlap >= nfft) || (output_re == NULL) ||
+        (output_im == NULL) || (output_freq == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (nfft > data_len)
+    {
+        data_logger->error ("Nfft must be less than data_len.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int num_bins = nfft / 2 + 1;
+    ScratchScope scratch;
+    double *window = scratch.alloc<double> (nfft);
+    int res = get_window (window_function, nfft, window);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::complex<double> *csd = NULL;
+    try
+    {
+        csd = scratch.alloc<std::complex<double>> ((size_t)num_bins * num_channels * num_channels);
+        compute_csd_welch (
+            data, num_channels, data_len, nfft, overlap, sampling_rate, window, 0, num_bins, csd);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for cross spectral density.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    size_t total = (size_t)num_bins * num_channels * num_channels;
+    for (size_t i = 0; i < total; i++)
+    {
+        output_re[i] = csd[i].real ();
+        output_im[i] = csd[i].imag ();
+    }
+    double freq_res = (double)sampling_rate / (double)nfft;
+    for (int i = 0; i < num_bins; i++)
+    {
+        output_freq[i] = i * freq_res;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_coherence (double *data, int num_channels, int data_len, int nfft, int overlap,
+    int sampling_rate, int window_function, double freq_start, double freq_end, double *output)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 1) || (nfft < 1) ||
+        (sampling_rate < 1) || (overlap < 0) || (overlap >= nfft) || (freq_start > freq_end) ||
+        (output == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (nfft > data_len)
+    {
+        data_logger->error ("Nfft must be less than data_len.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // only bins inside the band are needed
+    double freq_res = (double)sampling_rate / (double)nfft;
+    int bin_start = std::max (0, (int)ceil (freq_start / freq_res));
+    int bin_end = std::min (nfft / 2, (int)floor (freq_end / freq_res)) + 1;
+    if (bin_end <= bin_start)
+    {
+        data_logger->error ("No data between freq_end and freq_start.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    ScratchScope scratch;
+    double *window = scratch.alloc<double> (nfft);
+    int res = get_window (window_function, nfft, window);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    int num_bins = bin_end - bin_start;
+    std::complex<double> *csd = NULL;
+    try
+    {
+        csd = scratch.alloc<std::complex<double>> ((size_t)num_bins * num_channels * num_channels);
+        compute_csd_welch (data, num_channels, data_len, nfft, overlap, sampling_rate, window,
+            bin_start, bin_end, csd);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for cross spectral density.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    // magnitude squared coherence |S_ij|^2 / (S_ii * S_jj) averaged over bins in the band
+    size_t matrix_size = (size_t)num_channels * num_channels;
+    for (size_t i = 0; i < matrix_size; i++)
+    {
+        output[i] = 0.0;
+    }
+    for (int bin = 0; bin < num_bins; bin++)
+    {
+        const std::complex<double> *s = csd + bin * matrix_size;
+        for (int i = 0; i < num_channels; i++)
+        {
+            double s_ii = s[(size_t)i * num_channels + i].real ();
+            for (int j = 0; j < num_channels; j++)
+            {
+                double s_jj = s[(size_t)j * num_channels + j].real ();
+                double denom = s_ii * s_jj;
+                if (denom > 0)
+                {
+                    output[(size_t)i * num_channels + j] +=
+                        std::norm (s[(size_t)i * num_channels + j]) / denom;
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < matrix_size; i++)
+    {
+        output[i] /= num_bins;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_covariance_matrix (double *data, int num_channels, int data_len, double *output)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 2) || (output == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    try
+    {
+        compute_covariance_matrix (data, num_channels, data_len, output);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for covariance matrix.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_psd_multitaper (double *data, int data_len, int sampling_rate, double nw, int num_tapers,
+    double *output_ampl, double *output_freq)
+{
+    return get_multichannel_psd_multitaper (
+        data, 1, data_len, sampling_rate, nw, num_tapers, output_ampl, output_freq);
+}
+
+int get_multichannel_psd_multitaper (double *data, int num_channels, int data_len,
+    int sampling_rate, double nw, int num_tapers, double *output_ampl, double *output_freq)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 1) || (sampling_rate < 1) ||
+        (output_ampl == NULL) || (output_freq == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((nw <= 0) || (nw >= data_len / 2.0) || (num_tapers < 1) || (num_tapers > data_len))
+    {
+        data_logger->error ("nw must be between 0 and data_len / 2, num_tapers must be between 1 "
+                            "and data_len. nw: {}, num_tapers: {}",
+            nw, num_tapers);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (num_tapers > (int)(2 * nw))
+    {
+        data_logger->warn ("Tapers after 2 * nw - 1 have poor concentration. num_tapers: {}",
+            num_tapers);
+    }
+    try
+    {
+        std::shared_ptr<DPSSTapers> tapers =
+            DPSSTapers::get_tapers (data_len, nw, num_tapers);
+        compute_psd_multitaper (data, num_channels, data_len, sampling_rate, *tapers, output_ampl);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for multitaper psd.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    double freq_res = (double)sampling_rate / (double)data_len;
+    for (int i = 0; i < data_len / 2 + 1; i++)
+    {
+        output_freq[i] = i * freq_res;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int perform_hilbert_transform (
+    double *data, int data_len, double *output_envelope, double *output_phase)
+{
+    return perform_multichannel_hilbert_transform (
+        data, 1, data_len, output_envelope, output_phase);
+}
+
+int perform_multichannel_hilbert_transform (double *data, int num_channels, int data_len,
+    double *output_envelope, double *output_phase)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 1) || (output_envelope == NULL) ||
+        (output_phase == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    try
+    {
+        compute_analytic_signal (data, num_channels, data_len, output_envelope, output_phase);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for hilbert transform.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_hilbert_filter (int num_channels, int num_taps, int *filter_id)
+{
+    if ((num_channels < 1) || (num_taps < 3) || (num_taps % 2 == 0) || (filter_id == NULL))
+    {
+        data_logger->error ("num_taps must be odd and >= 3, num_channels must be positive.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    double *window = new double[num_taps];
+    int res = get_window ((int)WindowFunctions::HAMMING, num_taps, window);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        delete[] window;
+        return res;
+    }
+    try
+    {
+        std::shared_ptr<HilbertFilter> filter =
+            std::make_shared<HilbertFilter> (num_channels, num_taps, window);
+        *filter_id = hilbert_filters.add (filter);
+    }
+    catch (...)
+    {
+        delete[] window;
+        data_logger->error ("Failed to allocate hilbert filter.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    delete[] window;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int update_hilbert_filter (int filter_id, double *data, int num_channels, int data_len,
+    double *output_envelope, double *output_phase)
+{
+    if ((data == NULL) || (data_len < 0) || (output_envelope == NULL) || (output_phase == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<HilbertFilter> filter = hilbert_filters.get (filter_id);
+    if (!filter)
+    {
+        data_logger->error ("Hilbert filter {} doesn't exist.", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (filter->get_num_channels () != num_channels)
+    {
+        data_logger->error ("Hilbert filter was created for {} channels, provided {}.",
+            filter->get_num_channels (), num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    try
+    {
+        filter->update (data, data_len, output_envelope, output_phase);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to update hilbert filter.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_hilbert_filter (int filter_id)
+{
+    if (!hilbert_filters.remove (filter_id))
     {
-        delete[] bands[j];
+        data_logger->error ("Hilbert filter {} doesn't exist.", filter_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
-    delete[] bands;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
+int create_ssvep_detector (int num_channels, int sampling_rate, double *target_freqs,
+    int num_targets, int num_harmonics, int window_len, int *detector_id)
+{
+    if ((num_channels < 1) || (sampling_rate < 1) || (target_freqs == NULL) || (num_targets < 1) ||
+        (num_harmonics < 1) || (window_len < 1) || (detector_id == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    for (int i = 0; i < num_targets; i++)
+    {
+        if ((target_freqs[i] <= 0) || (target_freqs[i] >= sampling_rate / 2.0))
+        {
+            data_logger->error ("Target frequency {} should be between 0 and {}.", target_freqs[i],
+                sampling_rate / 2.0);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    try
+    {
+        std::shared_ptr<SSVEPDetector> detector = std::make_shared<SSVEPDetector> (num_channels,
+            sampling_rate, target_freqs, num_targets, num_harmonics, window_len);
+        *detector_id = ssvep_detectors.add (detector);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate ssvep detector.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
+
+int update_ssvep_detector (
+    int detector_id, double *data, int num_channels, int data_len, double *scores)
+{
+    if ((data == NULL) || (data_len < 0) || (scores == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<SSVEPDetector> detector = ssvep_detectors.get (detector_id);
+    if (!detector)
+    {
+        data_logger->error ("SSVEP detector {} doesn't exist.", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (detector->get_num_channels () != num_channels)
+    {
+        data_logger->error ("SSVEP detector was created for {} channels, provided {}.",
+            detector->get_num_channels (), num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    detector->update (data, data_len, scores);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_ssvep_detector (int detector_id)
+{
+    if (!ssvep_detectors.remove (detector_id))
+    {
+        data_logger->error ("SSVEP detector {} doesn't exist.", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int apply_spatial_filter (double *filter, int num_outputs, double *data, int num_channels,
+    int data_len, double *output)
+{
+    if ((filter == NULL) || (num_outputs < 1) || (data == NULL) || (num_channels < 1) ||
+        (data_len < 1) || (output == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((output == data) && (num_outputs > num_channels))
+    {
+        data_logger->error ("For inplace filtering num_outputs must be <= num_channels.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (output != data)
+    {
+        spatial_filter_gemm (filter, num_outputs, data, num_channels, data_len, output);
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    ScratchScope scratch;
+    double *temp = NULL;
+    try
+    {
+        temp = scratch.alloc<double> ((size_t)num_outputs * data_len);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate memory for spatial filter.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    spatial_filter_gemm (filter, num_outputs, data, num_channels, data_len, temp);
+    memcpy (output, temp, sizeof (double) * num_outputs * data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int perform_common_average_reference (double *data, int num_channels, int data_len)
+{
+    if ((data == NULL) || (num_channels < 1) || (data_len < 1))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    common_average_reference (data, num_channels, data_len);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+// finds samples with non zero marker which have enough data around them
+static void find_epoch_events (double *data, int data_len, int marker_row, int pre_samples,
+    int post_samples, std::vector<int> &events)
+{
+    double *markers = data + (size_t)marker_row * data_len;
+    for (int i = pre_samples; i <= data_len - post_samples; i++)
+    {
+        if (markers[i] != 0.0)
+        {
+            events.push_back (i);
+        }
+    }
+}
+
+int get_num_epochs (double *data, int num_rows, int data_len, int marker_row, int pre_samples,
+    int post_samples, int *num_epochs)
+{
+    if ((data == NULL) || (num_rows < 1) || (data_len < 1) || (marker_row < 0) ||
+        (marker_row >= num_rows) || (pre_samples < 0) || (post_samples < 0) ||
+        (pre_samples + post_samples < 1) || (num_epochs == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::vector<int> events;
+    find_epoch_events (data, data_len, marker_row, pre_samples, post_samples, events);
+    *num_epochs = (int)events.size ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_epochs (double *data, int num_rows, int data_len, int marker_row, int *channels,
+    int num_channels, int pre_samples, int post_samples, int apply_baseline, int max_epochs,
+    double *output, double *output_markers, int *num_epochs)
+{
+    if ((data == NULL) || (num_rows < 1) || (data_len < 1) || (marker_row < 0) ||
+        (marker_row >= num_rows) || (channels == NULL) || (num_channels < 1) ||
+        (pre_samples < 0) || (post_samples < 0) || (pre_samples + post_samples < 1) ||
+        (max_epochs < 0) || (output == NULL) || (output_markers == NULL) || (num_epochs == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if ((apply_baseline) && (pre_samples == 0))
+    {
+        data_logger->error ("Baseline correction requires pre_samples > 0.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    for (int i = 0; i < num_channels; i++)
+    {
+        if ((channels[i] < 0) || (channels[i] >= num_rows))
+        {
+            data_logger->error ("Invalid channel {}, num_rows is {}.", channels[i], num_rows);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    std::vector<int> events;
+    find_epoch_events (data, data_len, marker_row, pre_samples, post_samples, events);
+    int count = (int)events.size ();
+    if (count > max_epochs)
+    {
+        data_logger->error ("Found {} epochs, output buffer is for {}.", count, max_epochs);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+
+    // output is epochs x channels x samples
+    int epoch_len = pre_samples + post_samples;
+    ThreadPool::parallel_for (0, count, [&] (int i) {
+        int start = events[i] - pre_samples;
+        output_markers[i] = data[(size_t)marker_row * data_len + events[i]];
+        for (int j = 0; j < num_channels; j++)
+        {
+            double *src = data + (size_t)channels[j] * data_len + start;
+            double *dst = output + ((size_t)i * num_channels + j) * epoch_len;
+            memcpy (dst, src, sizeof (double) * epoch_len);
+            if (apply_baseline)
+            {
+                double baseline = 0.0;
+                for (int k = 0; k < pre_samples; k++)
+                {
+                    baseline += dst[k];
+                }
+                baseline /= pre_samples;
+                for (int k = 0; k < epoch_len; k++)
+                {
+                    dst[k] -= baseline;
+                }
+            }
+        }
+    });
+    *num_epochs = count;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_artifact_detector (int num_channels, int sampling_rate, int window_len,
+    double max_peak_to_peak, double min_std, double max_std, double line_freq,
+    double max_line_noise_ratio, int interpolate, int *detector_id)
+{
+    if ((num_channels < 1) || (sampling_rate < 1) || (window_len < 2) || (detector_id == NULL) ||
+        (line_freq >= sampling_rate / 2.0))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    ArtifactThresholds thresholds;
+    thresholds.max_peak_to_peak = max_peak_to_peak;
+    thresholds.min_std = min_std;
+    thresholds.max_std = max_std;
+    thresholds.line_freq = line_freq;
+    thresholds.max_line_noise_ratio = max_line_noise_ratio;
+    try
+    {
+        std::shared_ptr<ArtifactDetector> detector = std::make_shared<ArtifactDetector> (
+            num_channels, sampling_rate, window_len, thresholds, (bool)interpolate);
+        *detector_id = artifact_detectors.add (detector);
+    }
+    catch (...)
+    {
+        data_logger->error ("Failed to allocate artifact detector.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int update_artifact_detector (
+    int detector_id, double *data, int num_channels, int data_len, int *flags)
+{
+    if ((data == NULL) || (data_len < 0) || (flags == NULL))
+    {
+        data_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::shared_ptr<ArtifactDetector> detector = artifact_detectors.get (detector_id);
+    if (!detector)
+    {
+        data_logger->error ("Artifact detector {} doesn't exist.", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    if (detector->get_num_channels () != num_channels)
+    {
+        data_logger->error ("Artifact detector was created for {} channels, provided {}.",
+            detector->get_num_channels (), num_channels);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    detector->update (data, data_len, flags);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int release_artifact_detector (int detector_id)
+{
+    if (!artifact_detectors.remove (detector_id))
+    {
+        data_logger->error ("Artifact detector {} doesn't exist.", detector_id);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int create_file_summary (char *file_name, char *summary_file)
+{
+    if ((file_name == NULL) || (summary_file == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int res = FileSummary::build (file_name, summary_file);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Couldn't create summary {} for file {}", summary_file, file_name);
+    }
+    return res;
+}
+
+int get_file_summary_info (char *summary_file, int *num_rows, int *num_samples)
+{
+    if ((summary_file == NULL) || (num_rows == NULL) || (num_samples == NULL))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    FileSummary summary;
+    int res = summary.open (summary_file);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Couldn't read summary file {}", summary_file);
+        return res;
+    }
+    *num_rows = summary.get_num_rows ();
+    *num_samples = (int)summary.get_num_samples ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int get_file_envelope (char *summary_file, int start_sample, int end_sample, int num_points,
+    double *min_buf, double *max_buf, double *mean_buf, int *returned_points)
+{
+    if ((summary_file == NULL) || (min_buf == NULL) || (max_buf == NULL) || (mean_buf == NULL) ||
+        (returned_points == NULL) || (start_sample < 0) || (end_sample <= start_sample) ||
+        (num_points <= 0))
+    {
+        data_logger->error ("invalid input params");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    FileSummary summary;
+    int res = summary.open (summary_file);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Couldn't read summary file {}", summary_file);
+        return res;
+    }
+    res = summary.get_envelope (
+        start_sample, end_sample, num_points, min_buf, max_buf, mean_buf, returned_points);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        data_logger->error ("Couldn't read envelope from {}", summary_file);
+    }
+    return res;
+}
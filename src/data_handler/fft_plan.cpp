@@ -0,0 +1,446 @@
+#include <map>
+#include <math.h>
+#include <mutex>
+
+#include "fft_plan.h"
+#include "scratch_arena.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_CACHED_FFT_PLANS 64
+
+
+// std::complex operator* has extra checks for inf and nan which make butterflies much slower
+static inline std::complex<double> cmul (
+    const std::complex<double> &a, const std::complex<double> &b)
+{
+    return std::complex<double> (a.real () * b.real () - a.imag () * b.imag (),
+        a.real () * b.imag () + a.imag () * b.real ());
+}
+
+static inline std::complex<double> cscale (const std::complex<double> &a, double scale)
+{
+    return std::complex<double> (a.real () * scale, a.imag () * scale);
+}
+
+// smallest number >= value which has only 2, 3 and 5 as prime factors
+static int get_next_fast_size (int value)
+{
+    for (int candidate = value;; candidate++)
+    {
+        int rest = candidate;
+        while (rest % 2 == 0)
+        {
+            rest /= 2;
+        }
+        while (rest % 3 == 0)
+        {
+            rest /= 3;
+        }
+        while (rest % 5 == 0)
+        {
+            rest /= 5;
+        }
+        if (rest == 1)
+        {
+            return candidate;
+        }
+    }
+}
+
+//////////////////////////////////////////
+/////////////// complex fft //////////////
+//////////////////////////////////////////
+
+ComplexFFTPlan::ComplexFFTPlan (int n)
+{
+    this->n = n;
+    use_bluestein = false;
+
+    int rest = n;
+    const int radixes[] = {4, 2, 3, 5};
+    for (int radix : radixes)
+    {
+        while ((rest > 1) && (rest % radix == 0))
+        {
+            rest /= radix;
+            factors.push_back (radix);
+            factors.push_back (rest);
+        }
+    }
+
+    if (rest != 1)
+    {
+        // convolution of size m >= 2n - 1 computed with fast sizes only
+        use_bluestein = true;
+        factors.clear ();
+        int m = get_next_fast_size (2 * n - 1);
+        conv_plan = std::unique_ptr<ComplexFFTPlan> (new ComplexFFTPlan (m));
+        chirp.resize (n);
+        for (int i = 0; i < n; i++)
+        {
+            // i^2 mod 2n to keep precision for big i
+            long long sq = ((long long)i * (long long)i) % (2LL * n);
+            double phase = -M_PI * (double)sq / (double)n;
+            chirp[i] = std::complex<double> (cos (phase), sin (phase));
+        }
+        std::vector<std::complex<double>> filter (m, std::complex<double> (0.0, 0.0));
+        filter[0] = std::conj (chirp[0]);
+        for (int i = 1; i < n; i++)
+        {
+            filter[i] = std::conj (chirp[i]);
+            filter[m - i] = std::conj (chirp[i]);
+        }
+        chirp_fft.resize (m);
+        conv_plan->forward (filter.data (), chirp_fft.data ());
+        // fold normalization of inverse transform into the filter
+        for (int i = 0; i < m; i++)
+        {
+            chirp_fft[i] = cscale (chirp_fft[i], 1.0 / (double)m);
+        }
+        return;
+    }
+
+    twiddles.resize (n);
+    for (int i = 0; i < n; i++)
+    {
+        double phase = -2.0 * M_PI * (double)i / (double)n;
+        twiddles[i] = std::complex<double> (cos (phase), sin (phase));
+    }
+}
+
+void ComplexFFTPlan::forward (const std::complex<double> *in, std::complex<double> *out) const
+{
+    if (n == 1)
+    {
+        out[0] = in[0];
+    }
+    else if (use_bluestein)
+    {
+        bluestein (in, out);
+    }
+    else
+    {
+        work (out, in, 1, factors.data ());
+    }
+}
+
+std::shared_ptr<ComplexFFTPlan> ComplexFFTPlan::get_plan (int n)
+{
+    static std::mutex plans_mutex;
+    static std::map<int, std::shared_ptr<ComplexFFTPlan>> plans;
+
+    std::lock_guard<std::mutex> lock (plans_mutex);
+    auto it = plans.find (n);
+    if (it != plans.end ())
+    {
+        return it->second;
+    }
+    if (plans.size () >= MAX_CACHED_FFT_PLANS)
+    {
+        plans.clear ();
+    }
+    std::shared_ptr<ComplexFFTPlan> plan = std::make_shared<ComplexFFTPlan> (n);
+    plans[n] = plan;
+    return plan;
+}
+
+void ComplexFFTPlan::inverse (const std::complex<double> *in, std::complex<double> *out) const
+{
+    ScratchScope scratch;
+    // ifft(x) = conj (fft (conj (x)))
+    std::complex<double> *temp = scratch.alloc<std::complex<double>> (n);
+    for (int i = 0; i < n; i++)
+    {
+        temp[i] = std::conj (in[i]);
+    }
+    forward (temp, out);
+    for (int i = 0; i < n; i++)
+    {
+        out[i] = std::conj (out[i]);
+    }
+}
+
+// recursive decimation in time, output of each stage is contiguous so butterfly loops have unit
+// stride over the output and compiler is able to vectorize them
+void ComplexFFTPlan::work (std::complex<double> *out, const std::complex<double> *in, int fstride,
+    const int *factor) const
+{
+    int p = factor[0];
+    int m = factor[1];
+    std::complex<double> *out_begin = out;
+    std::complex<double> *out_end = out + p * m;
+
+    if (m == 1)
+    {
+        do
+        {
+            *out = *in;
+            in += fstride;
+        } while (++out != out_end);
+    }
+    else
+    {
+        do
+        {
+            work (out, in, fstride * p, factor + 2);
+            in += fstride;
+        } while ((out += m) != out_end);
+    }
+
+    switch (p)
+    {
+        case 2:
+            butterfly_2 (out_begin, fstride, m);
+            break;
+        case 3:
+            butterfly_3 (out_begin, fstride, m);
+            break;
+        case 4:
+            butterfly_4 (out_begin, fstride, m);
+            break;
+        case 5:
+            butterfly_5 (out_begin, fstride, m);
+            break;
+        default:
+            break;
+    }
+}
+
+void ComplexFFTPlan::butterfly_2 (std::complex<double> *out, int fstride, int m) const
+{
+    std::complex<double> *out2 = out + m;
+    for (int k = 0; k < m; k++)
+    {
+        std::complex<double> t = cmul (out2[k], twiddles[k * fstride]);
+        out2[k] = out[k] - t;
+        out[k] += t;
+    }
+}
+
+void ComplexFFTPlan::butterfly_3 (std::complex<double> *out, int fstride, int m) const
+{
+    // imag part of exp(-2*pi*i/3)
+    const double epi3 = twiddles[fstride * m].imag ();
+    for (int k = 0; k < m; k++)
+    {
+        std::complex<double> s1 = cmul (out[k + m], twiddles[k * fstride]);
+        std::complex<double> s2 = cmul (out[k + 2 * m], twiddles[2 * k * fstride]);
+        std::complex<double> s3 = s1 + s2;
+        std::complex<double> s0 = cscale (s1 - s2, epi3);
+        std::complex<double> base = out[k] - cscale (s3, 0.5);
+        out[k] += s3;
+        out[k + m] = std::complex<double> (base.real () - s0.imag (), base.imag () + s0.real ());
+        out[k + 2 * m] =
+            std::complex<double> (base.real () + s0.imag (), base.imag () - s0.real ());
+    }
+}
+
+void ComplexFFTPlan::butterfly_4 (std::complex<double> *out, int fstride, int m) const
+{
+    for (int k = 0; k < m; k++)
+    {
+        std::complex<double> s0 = cmul (out[k + m], twiddles[k * fstride]);
+        std::complex<double> s1 = cmul (out[k + 2 * m], twiddles[2 * k * fstride]);
+        std::complex<double> s2 = cmul (out[k + 3 * m], twiddles[3 * k * fstride]);
+        std::complex<double> s5 = out[k] - s1;
+        std::complex<double> s4 = out[k] + s1;
+        std::complex<double> s3 = s0 + s2;
+        std::complex<double> s6 = s0 - s2;
+        out[k] = s4 + s3;
+        out[k + 2 * m] = s4 - s3;
+        out[k + m] = std::complex<double> (s5.real () + s6.imag (), s5.imag () - s6.real ());
+        out[k + 3 * m] = std::complex<double> (s5.real () - s6.imag (), s5.imag () + s6.real ());
+    }
+}
+
+void ComplexFFTPlan::butterfly_5 (std::complex<double> *out, int fstride, int m) const
+{
+    const std::complex<double> ya = twiddles[fstride * m];
+    const std::complex<double> yb = twiddles[2 * fstride * m];
+    for (int k = 0; k < m; k++)
+    {
+        std::complex<double> s0 = out[k];
+        std::complex<double> s1 = cmul (out[k + m], twiddles[k * fstride]);
+        std::complex<double> s2 = cmul (out[k + 2 * m], twiddles[2 * k * fstride]);
+        std::complex<double> s3 = cmul (out[k + 3 * m], twiddles[3 * k * fstride]);
+        std::complex<double> s4 = cmul (out[k + 4 * m], twiddles[4 * k * fstride]);
+
+        std::complex<double> s7 = s1 + s4;
+        std::complex<double> s10 = s1 - s4;
+        std::complex<double> s8 = s2 + s3;
+        std::complex<double> s9 = s2 - s3;
+
+        out[k] = s0 + s7 + s8;
+
+        std::complex<double> s5 = s0 + cscale (s7, ya.real ()) + cscale (s8, yb.real ());
+        std::complex<double> s6 (s10.imag () * ya.imag () + s9.imag () * yb.imag (),
+            -s10.real () * ya.imag () - s9.real () * yb.imag ());
+        out[k + m] = s5 - s6;
+        out[k + 4 * m] = s5 + s6;
+
+        std::complex<double> s11 = s0 + cscale (s7, yb.real ()) + cscale (s8, ya.real ());
+        std::complex<double> s12 (-s10.imag () * yb.imag () + s9.imag () * ya.imag (),
+            s10.real () * yb.imag () - s9.real () * ya.imag ());
+        out[k + 2 * m] = s11 + s12;
+        out[k + 3 * m] = s11 - s12;
+    }
+}
+
+void ComplexFFTPlan::bluestein (const std::complex<double> *in, std::complex<double> *out) const
+{
+    ScratchScope scratch;
+    int m = conv_plan->get_size ();
+    std::complex<double> *a = scratch.alloc<std::complex<double>> (m);
+    std::complex<double> *b = scratch.alloc<std::complex<double>> (m);
+    for (int i = 0; i < n; i++)
+    {
+        a[i] = cmul (in[i], chirp[i]);
+    }
+    conv_plan->forward (a, b);
+    for (int i = 0; i < m; i++)
+    {
+        b[i] = cmul (b[i], chirp_fft[i]);
+    }
+    conv_plan->inverse (b, a);
+    for (int i = 0; i < n; i++)
+    {
+        out[i] = cmul (a[i], chirp[i]);
+    }
+}
+
+//////////////////////////////////////////
+//////////////// real fft ////////////////
+//////////////////////////////////////////
+
+FFTPlan::FFTPlan (int n)
+{
+    this->n = n;
+    if (n % 2 == 0)
+    {
+        complex_plan = std::unique_ptr<ComplexFFTPlan> (new ComplexFFTPlan (n / 2));
+        split_twiddles.resize (n / 2);
+        for (int i = 0; i < n / 2; i++)
+        {
+            double phase = -2.0 * M_PI * (double)i / (double)n;
+            split_twiddles[i] = std::complex<double> (cos (phase), sin (phase));
+        }
+    }
+    else
+    {
+        complex_plan = std::unique_ptr<ComplexFFTPlan> (new ComplexFFTPlan (n));
+    }
+}
+
+std::shared_ptr<FFTPlan> FFTPlan::get_plan (int n)
+{
+    static std::mutex plans_mutex;
+    static std::map<int, std::shared_ptr<FFTPlan>> plans;
+
+    std::lock_guard<std::mutex> lock (plans_mutex);
+    auto it = plans.find (n);
+    if (it != plans.end ())
+    {
+        return it->second;
+    }
+    // plans in use are kept alive by shared_ptr, its safe to drop them from cache
+    if (plans.size () >= MAX_CACHED_FFT_PLANS)
+    {
+        plans.clear ();
+    }
+    std::shared_ptr<FFTPlan> plan = std::make_shared<FFTPlan> (n);
+    plans[n] = plan;
+    return plan;
+}
+
+void FFTPlan::forward (const double *in, std::complex<double> *out) const
+{
+    ScratchScope scratch;
+    if (n % 2 != 0)
+    {
+        std::complex<double> *packed = scratch.alloc<std::complex<double>> (n);
+        std::complex<double> *spectrum = scratch.alloc<std::complex<double>> (n);
+        for (int i = 0; i < n; i++)
+        {
+            packed[i] = std::complex<double> (in[i], 0.0);
+        }
+        complex_plan->forward (packed, spectrum);
+        for (int i = 0; i < n / 2 + 1; i++)
+        {
+            out[i] = spectrum[i];
+        }
+        return;
+    }
+
+    // even samples go to real part, odd samples to imag part
+    int half = n / 2;
+    std::complex<double> *packed = scratch.alloc<std::complex<double>> (half);
+    std::complex<double> *spectrum = scratch.alloc<std::complex<double>> (half);
+    for (int i = 0; i < half; i++)
+    {
+        packed[i] = std::complex<double> (in[2 * i], in[2 * i + 1]);
+    }
+    complex_plan->forward (packed, spectrum);
+
+    out[0] = std::complex<double> (spectrum[0].real () + spectrum[0].imag (), 0.0);
+    out[half] = std::complex<double> (spectrum[0].real () - spectrum[0].imag (), 0.0);
+    for (int k = 1; k < half; k++)
+    {
+        std::complex<double> z = spectrum[k];
+        std::complex<double> z_conj = std::conj (spectrum[half - k]);
+        std::complex<double> even = cscale (z + z_conj, 0.5);
+        std::complex<double> odd_t = z - z_conj;
+        // (z - conj(z[n/2-k])) / 2i
+        std::complex<double> odd (0.5 * odd_t.imag (), -0.5 * odd_t.real ());
+        out[k] = even + cmul (split_twiddles[k], odd);
+    }
+}
+
+void FFTPlan::inverse (const std::complex<double> *in, double *out) const
+{
+    ScratchScope scratch;
+    if (n % 2 != 0)
+    {
+        std::complex<double> *spectrum = scratch.alloc<std::complex<double>> (n);
+        std::complex<double> *restored = scratch.alloc<std::complex<double>> (n);
+        spectrum[0] = std::complex<double> (in[0].real (), 0.0);
+        for (int i = 1; i < n / 2 + 1; i++)
+        {
+            spectrum[i] = in[i];
+            spectrum[n - i] = std::conj (in[i]);
+        }
+        complex_plan->inverse (spectrum, restored);
+        for (int i = 0; i < n; i++)
+        {
+            out[i] = restored[i].real () / (double)n;
+        }
+        return;
+    }
+
+    int half = n / 2;
+    std::complex<double> *packed = scratch.alloc<std::complex<double>> (half);
+    std::complex<double> *restored = scratch.alloc<std::complex<double>> (half);
+    for (int k = 0; k < half; k++)
+    {
+        std::complex<double> x = in[k];
+        std::complex<double> x_conj = std::conj (in[half - k]);
+        if (k == 0)
+        {
+            // imag parts of dc and nyquist bins are ignored, like in numpy.fft.irfft
+            x = std::complex<double> (in[0].real (), 0.0);
+            x_conj = std::complex<double> (in[half].real (), 0.0);
+        }
+        std::complex<double> even = cscale (x + x_conj, 0.5);
+        std::complex<double> odd = cmul (cscale (x - x_conj, 0.5), std::conj (split_twiddles[k]));
+        // even + i * odd
+        packed[k] = std::complex<double> (even.real () - odd.imag (), even.imag () + odd.real ());
+    }
+    complex_plan->inverse (packed, restored);
+    for (int i = 0; i < half; i++)
+    {
+        out[2 * i] = restored[i].real () / (double)half;
+        out[2 * i + 1] = restored[i].imag () / (double)half;
+    }
+}
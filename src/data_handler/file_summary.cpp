@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <sstream>
+#include <string.h>
+#include <string>
+
+#include "brainflow_constants.h"
+#include "file_summary.h"
+#include "summary_pyramid.h"
+
+// smallest blocks have 2^FILE_SUMMARY_LEVEL packages, summary is about 20% of csv file, stats are
+// doubles because csv doesnt tell which rows are timestamps
+#define FILE_SUMMARY_LEVEL 4
+#define FILE_SUMMARY_MAGIC "BFSP"
+#define FILE_SUMMARY_VERSION 2
+
+
+static bool parse_csv_line (const char *line, std::vector<double> &values)
+{
+    std::stringstream ss (line);
+    std::string tmp;
+    values.clear ();
+    try
+    {
+        while (getline (ss, tmp, ','))
+        {
+            values.push_back (std::stod (tmp));
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return !values.empty ();
+}
+
+int FileSummary::build (const char *csv_file, const char *summary_file)
+{
+    FILE *csv = fopen (csv_file, "r");
+    if (csv == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    uint64_t total_rows = 0;
+    for (int c = getc (csv); c != EOF; c = getc (csv))
+    {
+        if (c == '\n')
+        {
+            total_rows++;
+        }
+    }
+    if (total_rows < ((uint64_t)1 << FILE_SUMMARY_LEVEL))
+    {
+        fclose (csv);
+        return (int)BrainFlowExitCodes::EMPTY_BUFFER_ERROR;
+    }
+    fseek (csv, 0, SEEK_SET);
+
+    // rows of csv file are packages
+    char buf[4096];
+    std::vector<double> values;
+    SummaryPyramid *pyramid = NULL;
+    int num_rows = 0;
+    uint64_t num_samples = 0;
+    while ((num_samples < total_rows) && (fgets (buf, sizeof (buf), csv) != NULL))
+    {
+        bool is_valid = parse_csv_line (buf, values) &&
+            ((pyramid == NULL) || ((int)values.size () == num_rows));
+        if (!is_valid)
+        {
+            delete pyramid;
+            fclose (csv);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+        if (pyramid == NULL)
+        {
+            num_rows = (int)values.size ();
+            pyramid = new SummaryPyramid (num_rows, (size_t)total_rows, FILE_SUMMARY_LEVEL);
+        }
+        pyramid->add (values.data ());
+        num_samples++;
+    }
+    fclose (csv);
+
+    FILE *fp = fopen (summary_file, "wb");
+    if (fp == NULL)
+    {
+        delete pyramid;
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    int32_t header[4] = {FILE_SUMMARY_VERSION, num_rows, pyramid->get_base_level (),
+        pyramid->get_top_level ()};
+    bool is_written = (fwrite (FILE_SUMMARY_MAGIC, 1, 4, fp) == 4) &&
+        (fwrite (header, sizeof (int32_t), 4, fp) == 4) &&
+        (fwrite (&num_samples, sizeof (uint64_t), 1, fp) == 1);
+    std::vector<double> block ((size_t)num_rows * SummaryPyramid::NUM_STATS);
+    for (int level = pyramid->get_base_level (); level <= pyramid->get_top_level (); level++)
+    {
+        // ring of the pyramid is not smaller than file, so all blocks are available
+        for (uint64_t k = 0; (is_written) && (k < (num_samples >> level)); k++)
+        {
+            pyramid->get_block (level, k, block.data ());
+            is_written =
+                (fwrite (block.data (), sizeof (double), block.size (), fp) == block.size ());
+        }
+    }
+    delete pyramid;
+    if ((fclose (fp) != 0) || (!is_written))
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+FileSummary::FileSummary ()
+{
+    fp = NULL;
+    num_rows = 0;
+    base_level = 0;
+    top_level = 0;
+    num_samples = 0;
+}
+
+FileSummary::~FileSummary ()
+{
+    if (fp != NULL)
+    {
+        fclose (fp);
+        fp = NULL;
+    }
+}
+
+int FileSummary::open (const char *summary_file)
+{
+    fp = fopen (summary_file, "rb");
+    if (fp == NULL)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    char magic[4];
+    int32_t header[4];
+    bool is_read = (fread (magic, 1, 4, fp) == 4) &&
+        (fread (header, sizeof (int32_t), 4, fp) == 4) &&
+        (fread (&num_samples, sizeof (uint64_t), 1, fp) == 1);
+    if ((!is_read) || (memcmp (magic, FILE_SUMMARY_MAGIC, 4) != 0) ||
+        (header[0] != FILE_SUMMARY_VERSION) || (header[1] <= 0) || (header[2] < 0) ||
+        (header[3] < header[2]) || (header[3] >= 64))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    num_rows = header[1];
+    base_level = header[2];
+    top_level = header[3];
+    uint64_t block_bytes = (uint64_t)num_rows * SummaryPyramid::NUM_STATS * sizeof (double);
+    // levels follow the header
+    uint64_t offset = (uint64_t)ftell (fp);
+    for (int level = base_level; level <= top_level; level++)
+    {
+        level_offsets.push_back (offset);
+        offset += (num_samples >> level) * block_bytes;
+    }
+    block.resize ((size_t)num_rows * SummaryPyramid::NUM_STATS);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int FileSummary::get_envelope (uint64_t start, uint64_t end, int num_points, double *min,
+    double *max, double *mean, int *returned_points)
+{
+    uint64_t indexed = (num_samples >> base_level) << base_level;
+    end = std::min (end, indexed);
+    if ((fp == NULL) || (num_points <= 0) || (start >= end))
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    uint64_t block_size = (uint64_t)1 << base_level;
+    uint64_t block_bytes = (uint64_t)num_rows * SummaryPyramid::NUM_STATS * sizeof (double);
+    // points narrower than a block repeat values of this block
+    int result_count = (int)std::min ((uint64_t)num_points, end - start);
+    std::vector<std::pair<int, uint64_t>> blocks;
+    for (int p = 0; p < result_count; p++)
+    {
+        uint64_t point_start = start + (end - start) * p / result_count;
+        uint64_t point_end = start + (end - start) * (p + 1) / result_count;
+        point_start = (point_start >> base_level) << base_level;
+        point_end = std::min (((point_end + block_size - 1) >> base_level) << base_level, indexed);
+        SummaryPyramid::split_range (point_start, point_end, base_level, top_level, blocks);
+        double sum = 0.0;
+        for (size_t j = 0; j < blocks.size (); j++)
+        {
+            uint64_t offset =
+                level_offsets[blocks[j].first - base_level] + blocks[j].second * block_bytes;
+            if ((fseek (fp, (long)offset, SEEK_SET) != 0) ||
+                (fread (block.data (), sizeof (double), block.size (), fp) != block.size ()))
+            {
+                return (int)BrainFlowExitCodes::GENERAL_ERROR;
+            }
+            double size = (double)((uint64_t)1 << blocks[j].first);
+            for (int i = 0; i < num_rows; i++)
+            {
+                const double *stats = block.data () + i * SummaryPyramid::NUM_STATS;
+                double *point_min = min + (size_t)i * result_count + p;
+                double *point_max = max + (size_t)i * result_count + p;
+                double *point_mean = mean + (size_t)i * result_count + p;
+                if (j == 0)
+                {
+                    *point_min = stats[0];
+                    *point_max = stats[1];
+                    *point_mean = 0.0;
+                }
+                *point_min = std::min (*point_min, stats[0]);
+                *point_max = std::max (*point_max, stats[1]);
+                // sum is accumulated in mean and divided below
+                *point_mean += stats[2] * size;
+            }
+            sum += size;
+        }
+        for (int i = 0; i < num_rows; i++)
+        {
+            mean[(size_t)i * result_count + p] /= sum;
+        }
+    }
+    *returned_points = result_count;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
@@ -0,0 +1,99 @@
+#include <complex>
+#include <math.h>
+#include <memory>
+#include <string.h>
+
+#include "fft_plan.h"
+#include "hilbert.h"
+#include "scratch_arena.h"
+#include "thread_pool.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+void compute_analytic_signal (const double *data, int num_channels, int data_len,
+    double *output_envelope, double *output_phase)
+{
+    int num_bins = data_len / 2 + 1;
+    std::shared_ptr<FFTPlan> plan = FFTPlan::get_plan (data_len);
+    std::shared_ptr<ComplexFFTPlan> inverse_plan = ComplexFFTPlan::get_plan (data_len);
+
+    ThreadPool::parallel_for (0, num_channels, [&] (int channel) {
+        ScratchScope scratch;
+        // complex values are zero initialized, negative frequencies stay zero
+        std::complex<double> *spectrum = scratch.alloc<std::complex<double>> (data_len);
+        std::complex<double> *analytic = scratch.alloc<std::complex<double>> (data_len);
+        const double *channel_data = data + (size_t)channel * data_len;
+        plan->forward (channel_data, spectrum);
+        // double positive frequencies, negative ones stay zero, dc and nyquist are kept as is
+        for (int i = 1; i < num_bins; i++)
+        {
+            if ((data_len % 2 != 0) || (i != data_len / 2))
+            {
+                spectrum[i] *= 2.0;
+            }
+        }
+        inverse_plan->inverse (spectrum, analytic);
+        double *envelope = output_envelope + (size_t)channel * data_len;
+        double *phase = output_phase + (size_t)channel * data_len;
+        for (int i = 0; i < data_len; i++)
+        {
+            // inverse transform is unscaled, real part is equal to input data
+            double im = analytic[i].imag () / data_len;
+            envelope[i] = sqrt (channel_data[i] * channel_data[i] + im * im);
+            phase[i] = atan2 (im, channel_data[i]);
+        }
+    });
+}
+
+HilbertFilter::HilbertFilter (int num_channels, int num_taps, const double *window)
+{
+    this->num_channels = num_channels;
+    this->num_taps = num_taps;
+    int delay = (num_taps - 1) / 2;
+    // ideal hilbert transformer is 2 / (pi * k) for odd k and zero for even k
+    coefs.resize ((delay + 1) / 2);
+    for (size_t i = 0; i < coefs.size (); i++)
+    {
+        int k = 2 * (int)i + 1;
+        coefs[i] = 2.0 / (M_PI * k) * window[delay + k];
+    }
+    history.resize ((size_t)num_channels * (num_taps - 1), 0.0);
+}
+
+void HilbertFilter::update (
+    const double *data, int data_len, double *output_envelope, double *output_phase)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    int history_len = num_taps - 1;
+    int delay = history_len / 2;
+    int num_coefs = (int)coefs.size ();
+    work.resize ((size_t)history_len + data_len);
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        // contiguous history + new data, so convolution doesnt need to wrap around
+        double *channel_history = history.data () + (size_t)channel * history_len;
+        memcpy (work.data (), channel_history, sizeof (double) * history_len);
+        memcpy (work.data () + history_len, data + (size_t)channel * data_len,
+            sizeof (double) * data_len);
+        double *envelope = output_envelope + (size_t)channel * data_len;
+        double *phase = output_phase + (size_t)channel * data_len;
+        for (int i = 0; i < data_len; i++)
+        {
+            // center of the filter is the sample delayed by delay points
+            const double *center = work.data () + i + delay;
+            double im = 0.0;
+            for (int j = 0; j < num_coefs; j++)
+            {
+                int k = 2 * j + 1;
+                im += coefs[j] * (center[-k] - center[k]);
+            }
+            double re = center[0];
+            envelope[i] = sqrt (re * re + im * im);
+            phase[i] = atan2 (im, re);
+        }
+        memcpy (channel_history, work.data () + data_len, sizeof (double) * history_len);
+    }
+}
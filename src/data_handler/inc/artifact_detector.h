@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+
+struct ArtifactThresholds
+{
+    // thresholds <= 0 disable corresponding check
+    double max_peak_to_peak;
+    double min_std;
+    double max_std;
+    // ratio of line noise power to variance
+    double max_line_noise_ratio;
+    double line_freq;
+};
+
+// running peak to peak (monotonic queues), variance (sliding Welford) and line noise power
+// (sliding Goertzel) over last window_len samples per channel, cost per sample is O(1) amortized
+class ArtifactDetector
+{
+public:
+    ArtifactDetector (int num_channels, int sampling_rate, int window_len,
+        const ArtifactThresholds &thresholds, bool interpolate);
+
+    int get_num_channels () const
+    {
+        return num_channels;
+    }
+
+    // data is num_channels x data_len, flags has the same shape and stores ArtifactTypes bits
+    // if interpolate is set flagged datapoints are replaced inplace by mean of good channels
+    void update (double *data, int data_len, int *flags);
+
+private:
+    int num_channels;
+    int window_len;
+    ArtifactThresholds thresholds;
+    bool interpolate;
+    double rot_re;
+    double rot_im;
+    double rot_n_re;
+    double rot_n_im;
+
+    std::mutex lock;
+    // num_channels rings of window_len raw samples
+    std::vector<double> history;
+    // monotonic queues of sample indices, num_channels x window_len rings
+    std::vector<int64_t> max_queue;
+    std::vector<int64_t> min_queue;
+    std::vector<int> max_head;
+    std::vector<int> max_size;
+    std::vector<int> min_head;
+    std::vector<int> min_size;
+    std::vector<double> mean;
+    std::vector<double> m2;
+    std::vector<double> line_re;
+    std::vector<double> line_im;
+    // last good value per channel, used if all channels are flagged
+    std::vector<double> last_good;
+    int64_t num_samples;
+    int samples_since_refresh;
+
+    int add_sample (int channel, double x);
+    void refresh ();
+};
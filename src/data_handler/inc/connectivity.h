@@ -0,0 +1,15 @@
+#pragma once
+
+#include <complex>
+
+
+// cross spectral matrices for bins [bin_start, bin_end) averaged over welch segments
+// data is num_channels x data_len, window has nfft elements
+// output is (bin_end - bin_start) x num_channels x num_channels, scaled the same way as get_psd
+void compute_csd_welch (const double *data, int num_channels, int data_len, int nfft, int overlap,
+    int sampling_rate, const double *window, int bin_start, int bin_end,
+    std::complex<double> *output);
+
+// data is num_channels x data_len, output is num_channels x num_channels, unbiased estimate
+void compute_covariance_matrix (
+    const double *data, int num_channels, int data_len, double *output);
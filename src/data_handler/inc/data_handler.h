@@ -38,6 +38,18 @@ extern "C"
         double *data, int data_len, int window_function, double *output_re, double *output_im);
     SHARED_EXPORT int CALLING_CONVENTION perform_ifft (
         double *input_re, double *input_im, int data_len, double *restored_data);
+    // envelope and instantaneous phase in radians from analytic signal
+    SHARED_EXPORT int CALLING_CONVENTION perform_hilbert_transform (
+        double *data, int data_len, double *output_envelope, double *output_phase);
+    // data, output_envelope and output_phase are num_channels x data_len
+    SHARED_EXPORT int CALLING_CONVENTION perform_multichannel_hilbert_transform (double *data,
+        int num_channels, int data_len, double *output_envelope, double *output_phase);
+    // streaming hilbert transform with FIR filter, output is delayed by (num_taps - 1) / 2 samples
+    SHARED_EXPORT int CALLING_CONVENTION create_hilbert_filter (
+        int num_channels, int num_taps, int *filter_id);
+    SHARED_EXPORT int CALLING_CONVENTION update_hilbert_filter (int filter_id, double *data,
+        int num_channels, int data_len, double *output_envelope, double *output_phase);
+    SHARED_EXPORT int CALLING_CONVENTION release_hilbert_filter (int filter_id);
     SHARED_EXPORT int CALLING_CONVENTION get_nearest_power_of_two (int value, int *output);
     SHARED_EXPORT int CALLING_CONVENTION get_psd (double *data, int data_len, int sampling_rate,
         int window_function, double *output_ampl, double *output_freq);
@@ -46,14 +58,88 @@ extern "C"
     SHARED_EXPORT int CALLING_CONVENTION get_psd_welch (double *data, int data_len, int nfft,
         int overlap, int sampling_rate, int window_function, double *output_ampl,
         double *output_freq);
+    // nw is time-halfbandwidth product, DPSS tapers are cached by (data_len, nw, num_tapers)
+    SHARED_EXPORT int CALLING_CONVENTION get_psd_multitaper (double *data, int data_len,
+        int sampling_rate, double nw, int num_tapers, double *output_ampl, double *output_freq);
+    // data is num_channels x data_len, output_ampl is num_channels x (data_len / 2 + 1)
+    SHARED_EXPORT int CALLING_CONVENTION get_multichannel_psd_multitaper (double *data,
+        int num_channels, int data_len, int sampling_rate, double nw, int num_tapers,
+        double *output_ampl, double *output_freq);
     SHARED_EXPORT int CALLING_CONVENTION get_band_power (double *ampl, double *freq, int data_len,
         double freq_start, double freq_end, double *band_power);
+    // computes several bands in one call, bin ranges are shared by all bands and channels
+    SHARED_EXPORT int CALLING_CONVENTION get_band_powers (double *ampl, double *freq, int data_len,
+        double *freq_starts, double *freq_ends, int num_bands, double *band_powers);
+    // ampls is num_channels x data_len, band_powers is num_channels x num_bands
+    SHARED_EXPORT int CALLING_CONVENTION get_multichannel_band_powers (double *ampls,
+        int num_channels, double *freq, int data_len, double *freq_starts, double *freq_ends,
+        int num_bands, double *band_powers);
 
     SHARED_EXPORT int CALLING_CONVENTION get_avg_band_powers (double *raw_data, int rows, int cols,
         int sampling_rate, int apply_filters, double *avg_band_powers, double *stddev_band_powers);
+
+    // streaming spectrogram, emits nfft / 2 + 1 psd values per channel every hop samples
+    SHARED_EXPORT int CALLING_CONVENTION create_spectrogram (int num_channels, int nfft, int hop,
+        int sampling_rate, int window_function, int log_power, int *spectrogram_id);
+    // data is num_channels x data_len, output is num_columns x num_channels x (nfft / 2 + 1)
+    SHARED_EXPORT int CALLING_CONVENTION update_spectrogram (int spectrogram_id, double *data,
+        int num_channels, int data_len, int max_columns, double *output, int *num_columns);
+    SHARED_EXPORT int CALLING_CONVENTION release_spectrogram (int spectrogram_id);
+    SHARED_EXPORT int CALLING_CONVENTION get_spectrogram_output_shape (int spectrogram_id,
+        int data_len, int *num_columns, int *num_bins); // its an internal method for bindings
+    // ssvep detector, scores are updated per sample over the last window_len samples
+    SHARED_EXPORT int CALLING_CONVENTION create_ssvep_detector (int num_channels,
+        int sampling_rate, double *target_freqs, int num_targets, int num_harmonics,
+        int window_len, int *detector_id);
+    // data is num_channels x data_len, scores has num_targets elements
+    SHARED_EXPORT int CALLING_CONVENTION update_ssvep_detector (
+        int detector_id, double *data, int num_channels, int data_len, double *scores);
+    SHARED_EXPORT int CALLING_CONVENTION release_ssvep_detector (int detector_id);
+    // artifact detector over the last window_len samples, thresholds <= 0 disable checks
+    SHARED_EXPORT int CALLING_CONVENTION create_artifact_detector (int num_channels,
+        int sampling_rate, int window_len, double max_peak_to_peak, double min_std,
+        double max_std, double line_freq, double max_line_noise_ratio, int interpolate,
+        int *detector_id);
+    // data and flags are num_channels x data_len, flags store ArtifactTypes bits
+    // if interpolate is set flagged datapoints are replaced inplace
+    SHARED_EXPORT int CALLING_CONVENTION update_artifact_detector (
+        int detector_id, double *data, int num_channels, int data_len, int *flags);
+    SHARED_EXPORT int CALLING_CONVENTION release_artifact_detector (int detector_id);
+    // multichannel methods, data is num_channels x data_len
+    // filter is num_outputs x num_channels, output is num_outputs x data_len
+    // output can be the same array as data if num_outputs <= num_channels
+    SHARED_EXPORT int CALLING_CONVENTION apply_spatial_filter (double *filter, int num_outputs,
+        double *data, int num_channels, int data_len, double *output);
+    // inplace common average reference
+    SHARED_EXPORT int CALLING_CONVENTION perform_common_average_reference (
+        double *data, int num_channels, int data_len);
+    // output_re and output_im are (nfft / 2 + 1) x num_channels x num_channels
+    SHARED_EXPORT int CALLING_CONVENTION get_csd_welch (double *data, int num_channels,
+        int data_len, int nfft, int overlap, int sampling_rate, int window_function,
+        double *output_re, double *output_im, double *output_freq);
+    // magnitude squared coherence averaged over the band, output is num_channels x num_channels
+    SHARED_EXPORT int CALLING_CONVENTION get_coherence (double *data, int num_channels,
+        int data_len, int nfft, int overlap, int sampling_rate, int window_function,
+        double freq_start, double freq_end, double *output);
+    // output is num_channels x num_channels
+    SHARED_EXPORT int CALLING_CONVENTION get_covariance_matrix (
+        double *data, int num_channels, int data_len, double *output);
+    // epochs around non zero values in marker_row, data is num_rows x data_len
+    // epoch covers [marker - pre_samples, marker + post_samples), output is
+    // num_epochs x num_channels x (pre_samples + post_samples), output_markers has marker values
+    SHARED_EXPORT int CALLING_CONVENTION get_epochs (double *data, int num_rows, int data_len,
+        int marker_row, int *channels, int num_channels, int pre_samples, int post_samples,
+        int apply_baseline, int max_epochs, double *output, double *output_markers,
+        int *num_epochs);
+    SHARED_EXPORT int CALLING_CONVENTION get_num_epochs (double *data, int num_rows, int data_len,
+        int marker_row, int pre_samples, int post_samples,
+        int *num_epochs); // its an internal method for bindings
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level (int log_level);
     SHARED_EXPORT int CALLING_CONVENTION set_log_file (char *log_file);
+    // threads for multichannel methods, 0 means number of cores, 1 disables parallel processing
+    SHARED_EXPORT int CALLING_CONVENTION set_num_threads (int num_threads);
+    SHARED_EXPORT int CALLING_CONVENTION get_num_threads (int *num_threads);
     // file operations
     SHARED_EXPORT int CALLING_CONVENTION write_file (
         double *data, int num_rows, int num_cols, char *file_name, char *file_mode);
@@ -62,6 +148,13 @@ extern "C"
     SHARED_EXPORT int CALLING_CONVENTION get_num_elements_in_file (
         char *file_name, int *num_elements); // its an internal method for bindings its not
                                              // available via high level api
+    // min/max/mean pyramid of csv file for drawing long recordings
+    SHARED_EXPORT int CALLING_CONVENTION create_file_summary (char *file_name, char *summary_file);
+    SHARED_EXPORT int CALLING_CONVENTION get_file_summary_info (
+        char *summary_file, int *num_rows, int *num_samples);
+    SHARED_EXPORT int CALLING_CONVENTION get_file_envelope (char *summary_file, int start_sample,
+        int end_sample, int num_points, double *min_buf, double *max_buf, double *mean_buf,
+        int *returned_points);
 #ifdef __cplusplus
 }
 #endif
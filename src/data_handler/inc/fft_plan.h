@@ -0,0 +1,74 @@
+#pragma once
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+
+// complex fft of any size, mixed radix 2/3/4/5 and Bluestein algorithm for other prime factors
+class ComplexFFTPlan
+{
+public:
+    explicit ComplexFFTPlan (int n);
+
+    // plans are immutable and cached by size, so they can be shared between threads
+    static std::shared_ptr<ComplexFFTPlan> get_plan (int n);
+
+    int get_size () const
+    {
+        return n;
+    }
+
+    // forward transform with exp(-2*pi*i*k*j/n) kernel, in and out must not overlap
+    void forward (const std::complex<double> *in, std::complex<double> *out) const;
+    // unscaled inverse transform, in and out must not overlap
+    void inverse (const std::complex<double> *in, std::complex<double> *out) const;
+
+private:
+    int n;
+    // pairs of (radix, remaining length)
+    std::vector<int> factors;
+    // exp(-2*pi*i*k/n)
+    std::vector<std::complex<double>> twiddles;
+
+    // Bluestein's algorithm, used if n has prime factors other than 2, 3 and 5
+    bool use_bluestein;
+    std::unique_ptr<ComplexFFTPlan> conv_plan;
+    std::vector<std::complex<double>> chirp;
+    std::vector<std::complex<double>> chirp_fft;
+
+    void work (std::complex<double> *out, const std::complex<double> *in, int fstride,
+        const int *factor) const;
+    void butterfly_2 (std::complex<double> *out, int fstride, int m) const;
+    void butterfly_3 (std::complex<double> *out, int fstride, int m) const;
+    void butterfly_4 (std::complex<double> *out, int fstride, int m) const;
+    void butterfly_5 (std::complex<double> *out, int fstride, int m) const;
+    void bluestein (const std::complex<double> *in, std::complex<double> *out) const;
+};
+
+// fft for real input of any size, output is n / 2 + 1 bins of positive frequencies
+class FFTPlan
+{
+public:
+    explicit FFTPlan (int n);
+
+    // plans are immutable and cached by size, so they can be shared between threads
+    static std::shared_ptr<FFTPlan> get_plan (int n);
+
+    int get_size () const
+    {
+        return n;
+    }
+
+    // X[k] = sum x[j] * exp(-2*pi*i*k*j/n), k = 0..n/2, same as numpy.fft.rfft
+    void forward (const double *in, std::complex<double> *out) const;
+    // restores n real values from n / 2 + 1 bins, output is scaled by 1 / n
+    void inverse (const std::complex<double> *in, double *out) const;
+
+private:
+    int n;
+    // for even n input is packed into complex array of size n / 2
+    std::unique_ptr<ComplexFFTPlan> complex_plan;
+    // exp(-2*pi*i*k/n) for k < n / 2, used to split packed spectrum
+    std::vector<std::complex<double>> split_twiddles;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+
+// min/max/mean pyramid of a csv file written by write_file, stored in a separate binary file,
+// packages after the last complete base level block are not included
+class FileSummary
+{
+public:
+    // one pass over csv file, returns value from BrainFlowExitCodes
+    static int build (const char *csv_file, const char *summary_file);
+
+    FileSummary ();
+    ~FileSummary ();
+
+    int open (const char *summary_file);
+
+    // envelope per row for num_points equal parts of [start, end) package indices, output is row
+    // major with returned number of columns, edges are rounded to base level blocks
+    int get_envelope (uint64_t start, uint64_t end, int num_points, double *min, double *max,
+        double *mean, int *returned_points);
+
+    int get_num_rows ()
+    {
+        return num_rows;
+    }
+
+    uint64_t get_num_samples ()
+    {
+        return num_samples;
+    }
+
+private:
+    FILE *fp;
+    int num_rows;
+    int base_level;
+    int top_level;
+    uint64_t num_samples;
+    // file offset of each level starting from base_level
+    std::vector<uint64_t> level_offsets;
+    std::vector<double> block;
+};
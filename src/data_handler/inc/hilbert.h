@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+
+// analytic signal via fft, the same as scipy.signal.hilbert
+// data is num_channels x data_len, envelope and phase have the same shape, phase is in radians
+void compute_analytic_signal (const double *data, int num_channels, int data_len,
+    double *output_envelope, double *output_phase);
+
+// streaming hilbert transform using windowed FIR approximation
+// output is delayed by (num_taps - 1) / 2 samples relative to input
+class HilbertFilter
+{
+public:
+    // num_taps must be odd, window must have num_taps elements
+    HilbertFilter (int num_channels, int num_taps, const double *window);
+
+    int get_num_channels () const
+    {
+        return num_channels;
+    }
+
+    int get_delay () const
+    {
+        return (num_taps - 1) / 2;
+    }
+
+    // data is num_channels x data_len, envelope and phase have the same shape
+    void update (
+        const double *data, int data_len, double *output_envelope, double *output_phase);
+
+private:
+    int num_channels;
+    int num_taps;
+
+    std::mutex lock;
+    // only odd taps of hilbert transformer are non zero, coefs[i] is tap at offset 2 * i + 1
+    std::vector<double> coefs;
+    // last num_taps - 1 samples per channel
+    std::vector<double> history;
+    std::vector<double> work;
+};
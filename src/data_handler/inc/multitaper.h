@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+
+// discrete prolate spheroidal sequences (Slepian tapers) for multitaper psd
+class DPSSTapers
+{
+public:
+    // nw is time-halfbandwidth product, tapers are sorted by concentration in descending order
+    DPSSTapers (int n, double nw, int num_tapers);
+
+    // tapers are immutable and cached by (n, nw, num_tapers), so they can be shared between threads
+    static std::shared_ptr<DPSSTapers> get_tapers (int n, double nw, int num_tapers);
+
+    int get_size () const
+    {
+        return n;
+    }
+
+    int get_num_tapers () const
+    {
+        return num_tapers;
+    }
+
+    // taper k has n elements and unit energy
+    const double *get_taper (int k) const
+    {
+        return tapers.data () + (size_t)k * n;
+    }
+
+    // fraction of taper energy inside [-w, w] band, used as weight for averaging
+    double get_concentration (int k) const
+    {
+        return concentrations[k];
+    }
+
+private:
+    int n;
+    int num_tapers;
+    std::vector<double> tapers;
+    std::vector<double> concentrations;
+};
+
+// data is num_channels x data_len, output is num_channels x (data_len / 2 + 1)
+// tapered spectra are averaged with concentration weights and scaled the same way as get_psd
+void compute_psd_multitaper (const double *data, int num_channels, int data_len,
+    int sampling_rate, const DPSSTapers &tapers, double *output_ampl);
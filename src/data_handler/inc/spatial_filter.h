@@ -0,0 +1,10 @@
+#pragma once
+
+
+// output = filter x data, filter is num_outputs x num_channels, data is num_channels x data_len
+// output is num_outputs x data_len and must not overlap with data
+void spatial_filter_gemm (const double *filter, int num_outputs, const double *data,
+    int num_channels, int data_len, double *output);
+
+// subtracts mean across channels from each sample in place, data is num_channels x data_len
+void common_average_reference (double *data, int num_channels, int data_len);
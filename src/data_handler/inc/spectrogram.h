@@ -0,0 +1,57 @@
+#pragma once
+
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fft_plan.h"
+
+
+// keeps last nfft samples per channel and emits a spectrogram column every hop samples
+class Spectrogram
+{
+public:
+    // window must have nfft elements
+    Spectrogram (int num_channels, int nfft, int hop, int sampling_rate, const double *window,
+        bool log_power);
+
+    int get_num_channels () const
+    {
+        return num_channels;
+    }
+
+    int get_num_bins () const
+    {
+        return nfft / 2 + 1;
+    }
+
+    // number of columns which will be emitted if data_len new samples are added
+    int get_num_columns (int data_len);
+    // data is num_channels x data_len, output is num_columns x num_channels x (nfft / 2 + 1)
+    int update (
+        const double *data, int data_len, int max_columns, double *output, int *num_columns);
+
+private:
+    int num_channels;
+    int nfft;
+    int hop;
+    int sampling_rate;
+    bool log_power;
+
+    std::mutex lock;
+    std::shared_ptr<FFTPlan> plan;
+    std::vector<double> window;
+    // num_channels rings of nfft samples each
+    std::vector<double> history;
+    int history_pos;
+    // samples added so far, capped at nfft, column can be emitted only if history is full
+    int num_filled;
+    int samples_since_column;
+
+    std::vector<double> windowed;
+    std::vector<std::complex<double>> spectrum;
+
+    int count_columns (int data_len) const;
+    void compute_column (double *output);
+};
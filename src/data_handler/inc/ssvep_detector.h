@@ -0,0 +1,55 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+
+// sliding single bin dft (Goertzel) for each target frequency and harmonic over last window_len
+// samples, cost per sample is O(num_channels * num_targets * num_harmonics)
+class SSVEPDetector
+{
+public:
+    SSVEPDetector (int num_channels, int sampling_rate, const double *target_freqs,
+        int num_targets, int num_harmonics, int window_len);
+
+    int get_num_channels () const
+    {
+        return num_channels;
+    }
+
+    int get_num_targets () const
+    {
+        return num_targets;
+    }
+
+    // data is num_channels x data_len, scores has num_targets elements
+    // score is a fraction of signal energy at target frequency and its harmonics, from 0 to 1
+    void update (const double *data, int data_len, double *scores);
+
+private:
+    int num_channels;
+    int num_targets;
+    int num_harmonics;
+    int window_len;
+
+    std::mutex lock;
+    // per oscillator (target x harmonic): exp(-i * w) and exp(-i * w * window_len)
+    std::vector<double> rot_re;
+    std::vector<double> rot_im;
+    std::vector<double> rot_n_re;
+    std::vector<double> rot_n_im;
+    // harmonics above nyquist frequency are excluded from scores
+    std::vector<double> weights;
+    // num_channels x num_oscillators dft values over the window
+    std::vector<double> state_re;
+    std::vector<double> state_im;
+    // last window_len samples per channel
+    std::vector<double> history;
+    std::vector<double> energy;
+    int history_pos;
+    int num_filled;
+    // recursive update accumulates rounding errors, state is recomputed once per window
+    int samples_since_refresh;
+
+    void refresh ();
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+
+// pool for per channel loops in data handler, threads are created on first parallel_for, range is
+// split between the caller and pool threads, each thread processes its own part and after that
+// steals indices from parts of other threads
+class ThreadPool
+{
+public:
+    // 0 means number of cores, 1 disables pool, threads are recreated lazily on next parallel_for
+    static int set_num_threads (int num_threads);
+    static int get_num_threads ();
+    // calls body for each index in [begin, end) and returns after all calls, nested calls and calls
+    // while pool is busy with another loop run in the calling thread
+    static void parallel_for (int begin, int end, const std::function<void (int)> &body);
+
+private:
+    struct Part
+    {
+        std::atomic<int> next;
+        int end;
+        // each part is updated by its own thread most of the time, keep them in separate lines
+        char padding[64 - sizeof (std::atomic<int>) - sizeof (int)];
+    };
+
+    struct Job
+    {
+        const std::function<void (int)> *body;
+        std::vector<Part> parts;
+        int pending_workers;
+    };
+
+    static std::mutex instance_mutex;
+    static ThreadPool *instance;
+
+    // only one loop at a time uses pool threads
+    std::mutex job_mutex;
+    std::mutex mutex;
+    std::condition_variable job_cv;
+    std::condition_variable done_cv;
+    std::vector<std::thread> workers;
+    Job *job;
+    uint64_t generation;
+    bool keep_alive;
+    int num_threads;
+
+    ThreadPool ();
+
+    static ThreadPool *get_instance ();
+    void start_workers ();
+    void stop_workers ();
+    void run_worker (int worker_id, uint64_t last_generation);
+    void run_job (Job *job, int part);
+};
@@ -0,0 +1,360 @@
+#include <algorithm>
+#include <complex>
+#include <map>
+#include <math.h>
+#include <mutex>
+#include <tuple>
+
+#include "fft_plan.h"
+#include "multitaper.h"
+#include "scratch_arena.h"
+#include "thread_pool.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_CACHED_TAPERS 32
+#define BISECTION_ITERATIONS 128
+#define INVERSE_ITERATIONS 3
+
+
+// tapers are eigenvectors of symmetric tridiagonal matrix which commutes with the concentration
+// problem: diag[i] = ((n - 1 - 2i) / 2)^2 * cos (2 * pi * w), off[i] = (i + 1) * (n - 1 - i) / 2
+// eigenvalues are found by bisection with Sturm sequences, eigenvectors by inverse iteration
+
+// number of eigenvalues less than x
+static int sturm_count (const std::vector<double> &diag, const std::vector<double> &off, double x)
+{
+    int n = (int)diag.size ();
+    int count = 0;
+    double q = diag[0] - x;
+    for (int i = 0;; i++)
+    {
+        if (q < 0)
+        {
+            count++;
+        }
+        if (i == n - 1)
+        {
+            break;
+        }
+        if (q == 0)
+        {
+            q = 1e-300;
+        }
+        q = diag[i + 1] - x - off[i] * off[i] / q;
+    }
+    return count;
+}
+
+// solves (T - shift * I) x = b in place using LU with partial pivoting
+static void solve_shifted (const std::vector<double> &diag, const std::vector<double> &off,
+    double shift, double *b)
+{
+    int n = (int)diag.size ();
+    std::vector<double> dl (off);
+    std::vector<double> du (off);
+    std::vector<double> du2 (n, 0.0);
+    std::vector<double> d (n);
+    std::vector<bool> swapped (n, false);
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        d[i] = diag[i] - shift;
+        norm = std::max (norm, fabs (d[i]));
+    }
+    if (n > 1)
+    {
+        norm = std::max (norm, fabs (off[n / 2]));
+    }
+    // shift is an eigenvalue, replace zero pivots by tiny value to keep solution finite
+    double tiny = std::max (norm, 1.0) * 1e-15;
+
+    for (int i = 0; i < n - 1; i++)
+    {
+        if (fabs (d[i]) >= fabs (dl[i]))
+        {
+            double fact = (d[i] != 0) ? dl[i] / d[i] : 0.0;
+            dl[i] = fact;
+            d[i + 1] -= fact * du[i];
+        }
+        else
+        {
+            double fact = d[i] / dl[i];
+            d[i] = dl[i];
+            dl[i] = fact;
+            double temp = du[i];
+            du[i] = d[i + 1];
+            d[i + 1] = temp - fact * d[i + 1];
+            if (i < n - 2)
+            {
+                du2[i] = du[i + 1];
+                du[i + 1] = -fact * du[i + 1];
+            }
+            swapped[i] = true;
+        }
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (fabs (d[i]) < tiny)
+        {
+            d[i] = (d[i] < 0) ? -tiny : tiny;
+        }
+    }
+
+    for (int i = 0; i < n - 1; i++)
+    {
+        if (swapped[i])
+        {
+            double temp = b[i];
+            b[i] = b[i + 1];
+            b[i + 1] = temp - dl[i] * b[i];
+        }
+        else
+        {
+            b[i + 1] -= dl[i] * b[i];
+        }
+    }
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double val = b[i];
+        if (i + 1 < n)
+        {
+            val -= du[i] * b[i + 1];
+        }
+        if (i + 2 < n)
+        {
+            val -= du2[i] * b[i + 2];
+        }
+        b[i] = val / d[i];
+    }
+}
+
+static void normalize (double *x, int n)
+{
+    double norm = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+        norm += x[i] * x[i];
+    }
+    norm = sqrt (norm);
+    for (int i = 0; i < n; i++)
+    {
+        x[i] /= norm;
+    }
+}
+
+DPSSTapers::DPSSTapers (int n, double nw, int num_tapers)
+{
+    this->n = n;
+    this->num_tapers = num_tapers;
+    tapers.resize ((size_t)n * num_tapers, 0.0);
+    concentrations.resize (num_tapers, 1.0);
+    if (n == 1)
+    {
+        tapers[0] = 1.0;
+        return;
+    }
+
+    double w = nw / (double)n;
+    double cos_w = cos (2.0 * M_PI * w);
+    std::vector<double> diag (n);
+    std::vector<double> off (n - 1);
+    for (int i = 0; i < n; i++)
+    {
+        double val = (n - 1 - 2 * i) / 2.0;
+        diag[i] = val * val * cos_w;
+    }
+    for (int i = 0; i < n - 1; i++)
+    {
+        off[i] = (i + 1) * (double)(n - 1 - i) / 2.0;
+    }
+    // Gershgorin bounds
+    double lower = diag[0];
+    double upper = diag[0];
+    for (int i = 0; i < n; i++)
+    {
+        double radius = ((i > 0) ? fabs (off[i - 1]) : 0.0) + ((i < n - 1) ? fabs (off[i]) : 0.0);
+        lower = std::min (lower, diag[i] - radius);
+        upper = std::max (upper, diag[i] + radius);
+    }
+
+    for (int k = 0; k < num_tapers; k++)
+    {
+        // k-th largest eigenvalue has index n - 1 - k in ascending order
+        int index = n - 1 - k;
+        double lo = lower;
+        double hi = upper;
+        for (int iter = 0; iter < BISECTION_ITERATIONS; iter++)
+        {
+            double mid = 0.5 * (lo + hi);
+            if ((mid <= lo) || (mid >= hi))
+            {
+                break;
+            }
+            if (sturm_count (diag, off, mid) > index)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid;
+            }
+        }
+        double eigenvalue = 0.5 * (lo + hi);
+
+        // start vector should not be symmetric or antisymmetric to reach both kinds of tapers
+        double *taper = tapers.data () + (size_t)k * n;
+        for (int i = 0; i < n; i++)
+        {
+            taper[i] = 1.0 + 0.5 * sin (1.0 + i);
+        }
+        for (int iter = 0; iter < INVERSE_ITERATIONS; iter++)
+        {
+            solve_shifted (diag, off, eigenvalue, taper);
+            // keep tapers orthogonal if eigenvalues are close
+            for (int j = 0; j < k; j++)
+            {
+                const double *prev = tapers.data () + (size_t)j * n;
+                double dot = 0.0;
+                for (int i = 0; i < n; i++)
+                {
+                    dot += taper[i] * prev[i];
+                }
+                for (int i = 0; i < n; i++)
+                {
+                    taper[i] -= dot * prev[i];
+                }
+            }
+            normalize (taper, n);
+        }
+
+        // the same sign convention as in scipy.signal.windows.dpss
+        if (k % 2 == 0)
+        {
+            double sum = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                sum += taper[i];
+            }
+            if (sum < 0)
+            {
+                for (int i = 0; i < n; i++)
+                {
+                    taper[i] = -taper[i];
+                }
+            }
+        }
+        else
+        {
+            double thresh = std::max (1e-7, 1.0 / n);
+            for (int i = 0; i < n; i++)
+            {
+                if (taper[i] * taper[i] > thresh)
+                {
+                    if (taper[i] < 0)
+                    {
+                        for (int j = 0; j < n; j++)
+                        {
+                            taper[j] = -taper[j];
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        // concentration is sum_ij taper[i] * taper[j] * sin (2 * pi * w * (i - j)) / (pi * (i - j))
+        double concentration = 0.0;
+        for (int lag = 0; lag < n; lag++)
+        {
+            double autocorr = 0.0;
+            for (int i = 0; i < n - lag; i++)
+            {
+                autocorr += taper[i] * taper[i + lag];
+            }
+            if (lag == 0)
+            {
+                concentration += 2.0 * w * autocorr;
+            }
+            else
+            {
+                concentration += 2.0 * autocorr * sin (2.0 * M_PI * w * lag) / (M_PI * lag);
+            }
+        }
+        concentrations[k] = concentration;
+    }
+}
+
+std::shared_ptr<DPSSTapers> DPSSTapers::get_tapers (int n, double nw, int num_tapers)
+{
+    static std::mutex tapers_mutex;
+    static std::map<std::tuple<int, double, int>, std::shared_ptr<DPSSTapers>> cache;
+
+    std::tuple<int, double, int> key = std::make_tuple (n, nw, num_tapers);
+    std::lock_guard<std::mutex> lock (tapers_mutex);
+    auto it = cache.find (key);
+    if (it != cache.end ())
+    {
+        return it->second;
+    }
+    // tapers in use are kept alive by shared_ptr, its safe to drop them from cache
+    if (cache.size () >= MAX_CACHED_TAPERS)
+    {
+        cache.clear ();
+    }
+    std::shared_ptr<DPSSTapers> tapers = std::make_shared<DPSSTapers> (n, nw, num_tapers);
+    cache[key] = tapers;
+    return tapers;
+}
+
+void compute_psd_multitaper (const double *data, int num_channels, int data_len,
+    int sampling_rate, const DPSSTapers &tapers, double *output_ampl)
+{
+    int num_bins = data_len / 2 + 1;
+    int num_tapers = tapers.get_num_tapers ();
+    std::shared_ptr<FFTPlan> plan = FFTPlan::get_plan (data_len);
+    double weights_sum = 0.0;
+    for (int k = 0; k < num_tapers; k++)
+    {
+        weights_sum += tapers.get_concentration (k);
+    }
+    // tapers have unit energy, so there is no division by data_len unlike get_psd
+    double scale = 1.0 / ((double)sampling_rate * weights_sum);
+
+    // all channels x tapers transforms share the same plan
+    ThreadPool::parallel_for (0, num_channels, [&] (int channel) {
+        ScratchScope scratch;
+        double *tapered = scratch.alloc<double> (data_len);
+        std::complex<double> *spectrum = scratch.alloc<std::complex<double>> (num_bins);
+        const double *channel_data = data + (size_t)channel * data_len;
+        double *ampl = output_ampl + (size_t)channel * num_bins;
+        for (int i = 0; i < num_bins; i++)
+        {
+            ampl[i] = 0.0;
+        }
+        for (int k = 0; k < num_tapers; k++)
+        {
+            const double *taper = tapers.get_taper (k);
+            double weight = tapers.get_concentration (k);
+            for (int i = 0; i < data_len; i++)
+            {
+                tapered[i] = channel_data[i] * taper[i];
+            }
+            plan->forward (tapered, spectrum);
+            for (int i = 0; i < num_bins; i++)
+            {
+                ampl[i] += weight * std::norm (spectrum[i]);
+            }
+        }
+        for (int i = 0; i < num_bins; i++)
+        {
+            ampl[i] *= scale;
+            if ((i != 0) && ((data_len % 2 != 0) || (i != data_len / 2)))
+            {
+                ampl[i] *= 2;
+            }
+        }
+    });
+}
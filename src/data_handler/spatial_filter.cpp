@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <string.h>
+
+#include "spatial_filter.h"
+#include "thread_pool.h"
+
+// block of datapoints for all input channels should fit into L2 cache
+#define TIME_BLOCK_SIZE 256
+// number of output rows updated per pass over input row, inner loop is vectorized over time
+#define ROW_BLOCK_SIZE 4
+
+
+void spatial_filter_gemm (const double *filter, int num_outputs, const double *data,
+    int num_channels, int data_len, double *output)
+{
+    int num_time_blocks = (data_len + TIME_BLOCK_SIZE - 1) / TIME_BLOCK_SIZE;
+    ThreadPool::parallel_for (0, num_time_blocks, [&] (int block) {
+        int t_start = block * TIME_BLOCK_SIZE;
+        int len = std::min (TIME_BLOCK_SIZE, data_len - t_start);
+        for (int i = 0; i < num_outputs; i += ROW_BLOCK_SIZE)
+        {
+            int rows = std::min (ROW_BLOCK_SIZE, num_outputs - i);
+            for (int r = 0; r < rows; r++)
+            {
+                memset (output + (size_t)(i + r) * data_len + t_start, 0, sizeof (double) * len);
+            }
+            if (rows == ROW_BLOCK_SIZE)
+            {
+                double *out0 = output + (size_t)i * data_len + t_start;
+                double *out1 = out0 + data_len;
+                double *out2 = out1 + data_len;
+                double *out3 = out2 + data_len;
+                for (int k = 0; k < num_channels; k++)
+                {
+                    double w0 = filter[(size_t)i * num_channels + k];
+                    double w1 = filter[(size_t)(i + 1) * num_channels + k];
+                    double w2 = filter[(size_t)(i + 2) * num_channels + k];
+                    double w3 = filter[(size_t)(i + 3) * num_channels + k];
+                    // sparse filters like laplacian skip most of input channels
+                    if ((w0 == 0.0) && (w1 == 0.0) && (w2 == 0.0) && (w3 == 0.0))
+                    {
+                        continue;
+                    }
+                    const double *x = data + (size_t)k * data_len + t_start;
+                    for (int t = 0; t < len; t++)
+                    {
+                        out0[t] += w0 * x[t];
+                        out1[t] += w1 * x[t];
+                        out2[t] += w2 * x[t];
+                        out3[t] += w3 * x[t];
+                    }
+                }
+            }
+            else
+            {
+                for (int r = 0; r < rows; r++)
+                {
+                    double *out = output + (size_t)(i + r) * data_len + t_start;
+                    for (int k = 0; k < num_channels; k++)
+                    {
+                        double w = filter[(size_t)(i + r) * num_channels + k];
+                        if (w == 0.0)
+                        {
+                            continue;
+                        }
+                        const double *x = data + (size_t)k * data_len + t_start;
+                        for (int t = 0; t < len; t++)
+                        {
+                            out[t] += w * x[t];
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+void common_average_reference (double *data, int num_channels, int data_len)
+{
+    int num_time_blocks = (data_len + TIME_BLOCK_SIZE - 1) / TIME_BLOCK_SIZE;
+    ThreadPool::parallel_for (0, num_time_blocks, [&] (int block) {
+        int t_start = block * TIME_BLOCK_SIZE;
+        int len = std::min (TIME_BLOCK_SIZE, data_len - t_start);
+        double mean[TIME_BLOCK_SIZE];
+        memset (mean, 0, sizeof (mean));
+        for (int k = 0; k < num_channels; k++)
+        {
+            const double *x = data + (size_t)k * data_len + t_start;
+            for (int t = 0; t < len; t++)
+            {
+                mean[t] += x[t];
+            }
+        }
+        for (int t = 0; t < len; t++)
+        {
+            mean[t] /= num_channels;
+        }
+        for (int k = 0; k < num_channels; k++)
+        {
+            double *x = data + (size_t)k * data_len + t_start;
+            for (int t = 0; t < len; t++)
+            {
+                x[t] -= mean[t];
+            }
+        }
+    });
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <math.h>
+
+#include "brainflow_constants.h"
+#include "spectrogram.h"
+
+// lower bound for log scale to avoid -inf for zero bins
+#define MIN_LOG_POWER 1e-30
+
+
+Spectrogram::Spectrogram (
+    int num_channels, int nfft, int hop, int sampling_rate, const double *window, bool log_power)
+{
+    this->num_channels = num_channels;
+    this->nfft = nfft;
+    this->hop = hop;
+    this->sampling_rate = sampling_rate;
+    this->log_power = log_power;
+    this->window.assign (window, window + nfft);
+    plan = FFTPlan::get_plan (nfft);
+    history.resize ((size_t)num_channels * nfft, 0.0);
+    history_pos = 0;
+    num_filled = 0;
+    samples_since_column = 0;
+    windowed.resize (nfft);
+    spectrum.resize (nfft / 2 + 1);
+}
+
+int Spectrogram::get_num_columns (int data_len)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    return count_columns (data_len);
+}
+
+int Spectrogram::count_columns (int data_len) const
+{
+    if (num_filled < nfft)
+    {
+        int need_to_fill = nfft - num_filled;
+        if (data_len < need_to_fill)
+        {
+            return 0;
+        }
+        return 1 + (data_len - need_to_fill) / hop;
+    }
+    return (samples_since_column + data_len) / hop;
+}
+
+int Spectrogram::update (
+    const double *data, int data_len, int max_columns, double *output, int *num_columns)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    // check it before consuming data to keep state unchanged on error
+    if (count_columns (data_len) > max_columns)
+    {
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
+
+    int column_size = num_channels * (nfft / 2 + 1);
+    int columns = 0;
+    int consumed = 0;
+    while (consumed < data_len)
+    {
+        // copy samples in blocks up to the next column
+        int steps = 0;
+        if (num_filled < nfft)
+        {
+            steps = std::min (nfft - num_filled, data_len - consumed);
+        }
+        else
+        {
+            steps = std::min (hop - samples_since_column, data_len - consumed);
+        }
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            const double *src = data + (size_t)channel * data_len + consumed;
+            double *ring = history.data () + (size_t)channel * nfft;
+            int pos = history_pos;
+            for (int i = 0; i < steps; i++)
+            {
+                ring[pos] = src[i];
+                pos = (pos + 1 == nfft) ? 0 : pos + 1;
+            }
+        }
+        history_pos = (history_pos + steps) % nfft;
+        consumed += steps;
+
+        bool emit = false;
+        if (num_filled < nfft)
+        {
+            num_filled += steps;
+            emit = (num_filled == nfft);
+        }
+        else
+        {
+            samples_since_column += steps;
+            emit = (samples_since_column == hop);
+        }
+        if (emit)
+        {
+            samples_since_column = 0;
+            compute_column (output + (size_t)columns * column_size);
+            columns++;
+        }
+    }
+    *num_columns = columns;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void Spectrogram::compute_column (double *output)
+{
+    int num_bins = nfft / 2 + 1;
+    double scale = 1.0 / ((double)sampling_rate * (double)nfft);
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        // history_pos points to the oldest sample
+        const double *ring = history.data () + (size_t)channel * nfft;
+        int first_part = nfft - history_pos;
+        for (int i = 0; i < first_part; i++)
+        {
+            windowed[i] = ring[history_pos + i] * window[i];
+        }
+        for (int i = first_part; i < nfft; i++)
+        {
+            windowed[i] = ring[i - first_part] * window[i];
+        }
+        plan->forward (windowed.data (), spectrum.data ());
+
+        // the same scaling as in get_psd
+        double *column = output + (size_t)channel * num_bins;
+        for (int i = 0; i < num_bins; i++)
+        {
+            double power = std::norm (spectrum[i]) * scale;
+            if ((i != 0) && ((nfft % 2 != 0) || (i != nfft / 2)))
+            {
+                power *= 2;
+            }
+            if (log_power)
+            {
+                power = 10.0 * log10 (std::max (power, MIN_LOG_POWER));
+            }
+            column[i] = power;
+        }
+    }
+}
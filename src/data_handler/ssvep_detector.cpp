@@ -0,0 +1,158 @@
+#include <math.h>
+
+#include "ssvep_detector.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+SSVEPDetector::SSVEPDetector (int num_channels, int sampling_rate, const double *target_freqs,
+    int num_targets, int num_harmonics, int window_len)
+{
+    this->num_channels = num_channels;
+    this->num_targets = num_targets;
+    this->num_harmonics = num_harmonics;
+    this->window_len = window_len;
+    int num_oscillators = num_targets * num_harmonics;
+    rot_re.resize (num_oscillators);
+    rot_im.resize (num_oscillators);
+    rot_n_re.resize (num_oscillators);
+    rot_n_im.resize (num_oscillators);
+    weights.resize (num_oscillators);
+    for (int i = 0; i < num_targets; i++)
+    {
+        for (int j = 0; j < num_harmonics; j++)
+        {
+            int osc = i * num_harmonics + j;
+            double freq = target_freqs[i] * (j + 1);
+            double w = 2.0 * M_PI * freq / (double)sampling_rate;
+            rot_re[osc] = cos (w);
+            rot_im[osc] = -sin (w);
+            rot_n_re[osc] = cos (w * window_len);
+            rot_n_im[osc] = -sin (w * window_len);
+            weights[osc] = (freq < sampling_rate / 2.0) ? 1.0 : 0.0;
+        }
+    }
+    state_re.resize ((size_t)num_channels * num_oscillators, 0.0);
+    state_im.resize ((size_t)num_channels * num_oscillators, 0.0);
+    history.resize ((size_t)num_channels * window_len, 0.0);
+    energy.resize (num_channels, 0.0);
+    history_pos = 0;
+    num_filled = 0;
+    samples_since_refresh = 0;
+}
+
+void SSVEPDetector::update (const double *data, int data_len, double *scores)
+{
+    std::lock_guard<std::mutex> guard (lock);
+    int num_oscillators = num_targets * num_harmonics;
+    int start_pos = history_pos;
+    int consumed = 0;
+    while (consumed < data_len)
+    {
+        // process samples in blocks up to the next refresh
+        int steps = window_len - samples_since_refresh;
+        if (steps > data_len - consumed)
+        {
+            steps = data_len - consumed;
+        }
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            const double *src = data + (size_t)channel * data_len + consumed;
+            double *ring = history.data () + (size_t)channel * window_len;
+            double *s_re = state_re.data () + (size_t)channel * num_oscillators;
+            double *s_im = state_im.data () + (size_t)channel * num_oscillators;
+            int pos = start_pos;
+            double channel_energy = energy[channel];
+            for (int i = 0; i < steps; i++)
+            {
+                double x = src[i];
+                double x_old = ring[pos];
+                ring[pos] = x;
+                pos = (pos + 1 == window_len) ? 0 : pos + 1;
+                channel_energy += x * x - x_old * x_old;
+                // S[t] = x[t] + exp(-i * w) * S[t - 1] - x[t - N] * exp(-i * w * N)
+                for (int osc = 0; osc < num_oscillators; osc++)
+                {
+                    double re = s_re[osc] * rot_re[osc] - s_im[osc] * rot_im[osc];
+                    double im = s_re[osc] * rot_im[osc] + s_im[osc] * rot_re[osc];
+                    s_re[osc] = re + x - x_old * rot_n_re[osc];
+                    s_im[osc] = im - x_old * rot_n_im[osc];
+                }
+            }
+            energy[channel] = channel_energy;
+        }
+        start_pos = (start_pos + steps) % window_len;
+        history_pos = start_pos;
+        num_filled = (num_filled + steps > window_len) ? window_len : num_filled + steps;
+        samples_since_refresh += steps;
+        consumed += steps;
+        if (samples_since_refresh == window_len)
+        {
+            refresh ();
+        }
+    }
+
+    double total_energy = 0.0;
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        total_energy += energy[channel];
+    }
+    for (int i = 0; i < num_targets; i++)
+    {
+        double power = 0.0;
+        for (int channel = 0; channel < num_channels; channel++)
+        {
+            for (int j = 0; j < num_harmonics; j++)
+            {
+                int osc = i * num_harmonics + j;
+                size_t idx = (size_t)channel * num_oscillators + osc;
+                power += weights[osc] *
+                    (state_re[idx] * state_re[idx] + state_im[idx] * state_im[idx]);
+            }
+        }
+        // sinusoid with amplitude A has |S|^2 = (A * N / 2)^2 and energy A^2 * N / 2
+        if ((total_energy > 0) && (num_filled > 0))
+        {
+            scores[i] = 2.0 * power / ((double)num_filled * total_energy);
+        }
+        else
+        {
+            scores[i] = 0.0;
+        }
+    }
+}
+
+void SSVEPDetector::refresh ()
+{
+    int num_oscillators = num_targets * num_harmonics;
+    for (int channel = 0; channel < num_channels; channel++)
+    {
+        const double *ring = history.data () + (size_t)channel * window_len;
+        double *s_re = state_re.data () + (size_t)channel * num_oscillators;
+        double *s_im = state_im.data () + (size_t)channel * num_oscillators;
+        double channel_energy = 0.0;
+        for (int osc = 0; osc < num_oscillators; osc++)
+        {
+            s_re[osc] = 0.0;
+            s_im[osc] = 0.0;
+        }
+        // from the oldest sample to the newest one, unfilled part of ring is zero
+        for (int i = 0; i < window_len; i++)
+        {
+            int pos = history_pos + i;
+            double x = ring[(pos >= window_len) ? pos - window_len : pos];
+            channel_energy += x * x;
+            for (int osc = 0; osc < num_oscillators; osc++)
+            {
+                double re = s_re[osc] * rot_re[osc] - s_im[osc] * rot_im[osc];
+                double im = s_re[osc] * rot_im[osc] + s_im[osc] * rot_re[osc];
+                s_re[osc] = re + x;
+                s_im[osc] = im;
+            }
+        }
+        energy[channel] = channel_energy;
+    }
+    samples_since_refresh = 0;
+}
@@ -0,0 +1,196 @@
+#include "thread_pool.h"
+#include "brainflow_constants.h"
+
+
+std::mutex ThreadPool::instance_mutex;
+// never deleted, pool threads should not be joined from static destructors on library unload
+ThreadPool *ThreadPool::instance = NULL;
+
+// pool threads and threads inside parallel_for run nested loops serially
+static thread_local bool inside_pool_loop = false;
+
+ThreadPool::ThreadPool ()
+{
+    job = NULL;
+    generation = 0;
+    keep_alive = false;
+    num_threads = 0;
+}
+
+ThreadPool *ThreadPool::get_instance ()
+{
+    std::lock_guard<std::mutex> guard (instance_mutex);
+    if (instance == NULL)
+    {
+        instance = new ThreadPool ();
+    }
+    return instance;
+}
+
+int ThreadPool::set_num_threads (int num_threads)
+{
+    if (num_threads < 0)
+    {
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    ThreadPool *pool = get_instance ();
+    // wait for running loop
+    std::lock_guard<std::mutex> job_guard (pool->job_mutex);
+    pool->stop_workers ();
+    pool->num_threads = num_threads;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int ThreadPool::get_num_threads ()
+{
+    ThreadPool *pool = get_instance ();
+    std::lock_guard<std::mutex> job_guard (pool->job_mutex);
+    if (pool->num_threads > 0)
+    {
+        return pool->num_threads;
+    }
+    int num_cores = (int)std::thread::hardware_concurrency ();
+    return (num_cores > 0) ? num_cores : 1;
+}
+
+void ThreadPool::parallel_for (int begin, int end, const std::function<void (int)> &body)
+{
+    ThreadPool *pool = NULL;
+    if ((end - begin > 1) && (!inside_pool_loop))
+    {
+        pool = get_instance ();
+        if (!pool->job_mutex.try_lock ())
+        {
+            pool = NULL;
+        }
+    }
+    if (pool != NULL)
+    {
+        pool->start_workers ();
+        if (pool->workers.empty ())
+        {
+            pool->job_mutex.unlock ();
+            pool = NULL;
+        }
+    }
+    if (pool == NULL)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            body (i);
+        }
+        return;
+    }
+
+    // part 0 is for the calling thread
+    Job job;
+    int num_parts = (int)pool->workers.size () + 1;
+    job.body = &body;
+    job.parts = std::vector<Part> (num_parts);
+    job.pending_workers = num_parts - 1;
+    int len = end - begin;
+    for (int i = 0; i < num_parts; i++)
+    {
+        job.parts[i].next = begin + (int)((int64_t)len * i / num_parts);
+        job.parts[i].end = begin + (int)((int64_t)len * (i + 1) / num_parts);
+    }
+    {
+        std::lock_guard<std::mutex> guard (pool->mutex);
+        pool->job = &job;
+        pool->generation++;
+    }
+    pool->job_cv.notify_all ();
+    inside_pool_loop = true;
+    pool->run_job (&job, 0);
+    inside_pool_loop = false;
+    {
+        std::unique_lock<std::mutex> lock (pool->mutex);
+        pool->done_cv.wait (lock, [&job] { return job.pending_workers == 0; });
+        pool->job = NULL;
+    }
+    pool->job_mutex.unlock ();
+}
+
+void ThreadPool::run_job (Job *job, int part)
+{
+    int num_parts = (int)job->parts.size ();
+    for (int i = 0; i < num_parts; i++)
+    {
+        // own part first, after that parts of other threads
+        Part &current = job->parts[(part + i) % num_parts];
+        while (true)
+        {
+            int index = current.next.fetch_add (1);
+            if (index >= current.end)
+            {
+                break;
+            }
+            (*job->body) (index);
+        }
+    }
+}
+
+// should be called with job_mutex locked
+void ThreadPool::start_workers ()
+{
+    if ((keep_alive) || (num_threads == 1))
+    {
+        return;
+    }
+    int total_threads = num_threads;
+    if (total_threads == 0)
+    {
+        total_threads = (int)std::thread::hardware_concurrency ();
+    }
+    keep_alive = true;
+    // generation is changed only by parallel_for with job_mutex locked, so workers cant miss the
+    // first job
+    uint64_t start_generation = generation;
+    // calling thread is one of them
+    for (int i = 0; i < total_threads - 1; i++)
+    {
+        workers.push_back (std::thread (
+            [this, i, start_generation] { this->run_worker (i, start_generation); }));
+    }
+}
+
+// should be called with job_mutex locked
+void ThreadPool::stop_workers ()
+{
+    {
+        std::lock_guard<std::mutex> guard (mutex);
+        keep_alive = false;
+    }
+    job_cv.notify_all ();
+    for (size_t i = 0; i < workers.size (); i++)
+    {
+        workers[i].join ();
+    }
+    workers.clear ();
+}
+
+void ThreadPool::run_worker (int worker_id, uint64_t last_generation)
+{
+    inside_pool_loop = true;
+    std::unique_lock<std::mutex> lock (mutex);
+    while (true)
+    {
+        job_cv.wait (lock, [this, last_generation] {
+            return (!keep_alive) || (generation != last_generation);
+        });
+        if (!keep_alive)
+        {
+            return;
+        }
+        last_generation = generation;
+        Job *current = job;
+        lock.unlock ();
+        run_job (current, worker_id + 1);
+        lock.lock ();
+        current->pending_workers--;
+        if (current->pending_workers == 0)
+        {
+            done_cv.notify_one ();
+        }
+    }
+}
@@ -60,3 +60,17 @@ int BaseClassifier::set_log_file (char *log_file)
     return (int)BrainFlowExitCodes::STATUS_OK;
 #endif
 }
+
+int BaseClassifier::predict_from_raw (const double *data, int rows, int cols, int sampling_rate,
+    const int *channels, int num_channels, double *output)
+{
+    double features[FeatureExtractor::NUM_FEATURES];
+    int res = feature_extractor.get_features (
+        data, rows, cols, sampling_rate, channels, num_channels, features);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        safe_logger (spdlog::level::err, "Failed to calculate feature vector.");
+        return res;
+    }
+    return predict (features, FeatureExtractor::NUM_FEATURES, output);
+}
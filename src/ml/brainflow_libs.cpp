@@ -0,0 +1,63 @@
+#include <mutex>
+#include <string>
+
+#include "base_classifier.h"
+#include "brainflow_libs.h"
+#include "get_dll_dir.h"
+
+#ifdef _WIN32
+#define DATA_HANDLER_LIB ((sizeof (void *) == 4) ? "DataHandler32.dll" : "DataHandler.dll")
+#define BOARD_CONTROLLER_LIB \
+    ((sizeof (void *) == 4) ? "BoardController32.dll" : "BoardController.dll")
+#elif defined(__APPLE__)
+#define DATA_HANDLER_LIB "libDataHandler.dylib"
+#define BOARD_CONTROLLER_LIB "libBoardController.dylib"
+#else
+#define DATA_HANDLER_LIB "libDataHandler.so"
+#define BOARD_CONTROLLER_LIB "libBoardController.so"
+#endif
+
+
+static std::mutex libs_mutex;
+
+DLLLoader *BrainFlowLibs::get_data_handler ()
+{
+    // loaders are never deleted, functions from them can be used until process exit
+    static DLLLoader *data_handler = NULL;
+    std::lock_guard<std::mutex> lock (libs_mutex);
+    if (data_handler == NULL)
+    {
+        data_handler = load (DATA_HANDLER_LIB);
+    }
+    return data_handler;
+}
+
+DLLLoader *BrainFlowLibs::get_board_controller ()
+{
+    static DLLLoader *board_controller = NULL;
+    std::lock_guard<std::mutex> lock (libs_mutex);
+    if (board_controller == NULL)
+    {
+        board_controller = load (BOARD_CONTROLLER_LIB);
+    }
+    return board_controller;
+}
+
+DLLLoader *BrainFlowLibs::load (const char *lib_name)
+{
+    char lib_dir[1024];
+    std::string lib_path = lib_name;
+    if (get_dll_path (lib_dir))
+    {
+        lib_path = std::string (lib_dir) + lib_name;
+    }
+    BaseClassifier::ml_logger->debug ("use dyn lib: {}", lib_path.c_str ());
+    DLLLoader *loader = new DLLLoader (lib_path.c_str ());
+    if (!loader->load_library ())
+    {
+        BaseClassifier::ml_logger->error ("Failed to load library {}", lib_path.c_str ());
+        delete loader;
+        return NULL;
+    }
+    return loader;
+}
@@ -6,14 +6,21 @@
 #include "concentration_knn_classifier.h"
 #include "focus_dataset.h"
 
+#define MAX_NEIGHBORS 100
+
 
 int ConcentrationKNNClassifier::prepare ()
 {
-    if (kdtree != NULL)
+    if (index != NULL)
     {
         safe_logger (spdlog::level::err, "Classifier has already been prepared.");
         return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
     }
+    int res = load_dataset ();
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
     if (!params.other_info.empty ())
     {
         try
@@ -27,59 +34,109 @@ int ConcentrationKNNClassifier::prepare ()
             return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
         }
     }
-    if ((num_neighbors < 1) || (num_neighbors > 100))
+    if ((num_neighbors < 1) || (num_neighbors > MAX_NEIGHBORS))
     {
         safe_logger (spdlog::level::err, "You must pick from 1-100 neighbors.");
         return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
     }
+    if (num_neighbors > (int)labels.size ())
+    {
+        safe_logger (spdlog::level::err, "Number of neighbors is bigger than dataset size.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    index = new QuantizedKNN (points.data (), labels.data (), (int)labels.size (), num_features);
+    // index keeps its own copy
+    std::vector<double> ().swap (points);
+    std::vector<int> ().swap (labels);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
 
-    int dataset_len = sizeof (brainflow_focus_y) / sizeof (brainflow_focus_y[0]);
-    for (int i = 0; i < dataset_len; i++)
+int ConcentrationKNNClassifier::load_dataset ()
+{
+    if (params.file.empty ())
     {
-        FocusPoint point (brainflow_focus_x[i], 10, brainflow_focus_y[i]);
+        num_features = FocusPoint::DIM;
         // decrease weight for stddev, 0.2 - experimental vlaue
-        for (int j = 5; j < 10; j++)
+        for (int j = 0; j < FocusPoint::DIM; j++)
         {
-            point[j] *= 0.2;
+            feature_weights[j] = (j < 5) ? 1.0 : 0.2;
         }
-        dataset.push_back (point);
+        int dataset_len = sizeof (brainflow_focus_y) / sizeof (brainflow_focus_y[0]);
+        points.resize ((size_t)dataset_len * num_features);
+        labels.assign (brainflow_focus_y, brainflow_focus_y + dataset_len);
+        for (int i = 0; i < dataset_len; i++)
+        {
+            for (int j = 0; j < num_features; j++)
+            {
+                points[(size_t)i * num_features + j] = brainflow_focus_x[i][j] * feature_weights[j];
+            }
+        }
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+
+    // points are copied to index, mapping is not needed after that
+    ModelFile model_file;
+    int res = model_file.open (params.file, (int)BrainFlowClassifiers::KNN);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    const ModelFileHeader &header = model_file.get_header ();
+    if (header.num_features > (uint32_t)FocusPoint::DIM)
+    {
+        safe_logger (
+            spdlog::level::err, "KNN model supports up to {} features.", (int)FocusPoint::DIM);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    num_features = (int)header.num_features;
+    if (header.num_neighbors > 0)
+    {
+        num_neighbors = (int)header.num_neighbors;
+    }
+    const double *weights = model_file.get_feature_weights ();
+    for (int j = 0; j < FocusPoint::DIM; j++)
+    {
+        feature_weights[j] = (j < num_features) ? weights[j] : 0.0;
+    }
+    const double *file_points = model_file.get_points ();
+    const int32_t *file_labels = model_file.get_labels ();
+    points.resize ((size_t)header.num_rows * num_features);
+    labels.assign (file_labels, file_labels + header.num_rows);
+    for (size_t i = 0; i < points.size (); i++)
+    {
+        points[i] = file_points[i] * feature_weights[i % num_features];
     }
-    kdtree = new kdt::KDTree<FocusPoint> (dataset);
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int ConcentrationKNNClassifier::predict (double *data, int data_len, double *output)
 {
-    if ((data_len < 5) || (data == NULL) || (output == NULL))
-    {
-        safe_logger (spdlog::level::err, "All argument must not be null, and data_len must be 10");
-        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
-    }
-    if (kdtree == NULL)
+    if (index == NULL)
     {
         safe_logger (spdlog::level::err, "Please prepare classifier with prepare method.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
+    // builtin dataset may work without stddev, models from file require all features
+    int min_len = (params.file.empty ()) ? 5 : num_features;
+    if ((data_len < min_len) || (data == NULL) || (output == NULL))
+    {
+        safe_logger (spdlog::level::err,
+            "All argument must not be null, and data_len must be {}", num_features);
+        return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
+    }
 
-    double feature_vector[10] = {0.0};
-    for (int i = 0; i < data_len; i++)
+    double feature_vector[FocusPoint::DIM] = {0.0};
+    for (int i = 0; i < std::min (data_len, num_features); i++)
     {
-        if (i >= 5)
-        {
-            feature_vector[i] = data[i] * 0.2;
-        }
-        else
-        {
-            feature_vector[i] = data[i];
-        }
+        feature_vector[i] = data[i] * feature_weights[i];
     }
 
-    FocusPoint sample_to_predict (feature_vector, 10, 0);
-    const std::vector<int> knn_ids = kdtree->knnSearch (sample_to_predict, num_neighbors);
+    int knn_ids[MAX_NEIGHBORS];
+    index->search (feature_vector, num_neighbors, knn_ids);
     int num_ones = 0;
-    for (int i = 0; i < (int)knn_ids.size (); i++)
+    for (int i = 0; i < num_neighbors; i++)
     {
-        if (dataset[knn_ids[i]].value == 1)
+        if (index->get_label (knn_ids[i]) == 1)
         {
             num_ones++;
         }
@@ -93,14 +150,13 @@ int ConcentrationKNNClassifier::predict (double *data, int data_len, double *out
 
 int ConcentrationKNNClassifier::release ()
 {
-    if (kdtree == NULL)
+    if (index == NULL)
     {
         safe_logger (spdlog::level::err, "Please prepare classifier with prepare method.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
-    delete kdtree;
-    kdtree = NULL;
-    dataset.clear ();
+    delete index;
+    index = NULL;
     safe_logger (spdlog::level::info, "Model has been cleared.");
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
@@ -9,29 +9,59 @@
 
 int ConcentrationRegressionClassifier::prepare ()
 {
+    if (coefficients != NULL)
+    {
+        safe_logger (spdlog::level::err, "Classifier has already been prepared.");
+        return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
+    }
+    if (params.file.empty ())
+    {
+        coefficients = regression_coefficients;
+        intercept = regression_intercept;
+        num_features = 10;
+        return (int)BrainFlowExitCodes::STATUS_OK;
+    }
+    int res = model_file.open (params.file, (int)BrainFlowClassifiers::REGRESSION);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    coefficients = model_file.get_coefficients ();
+    intercept = model_file.get_header ().intercept;
+    num_features = (int)model_file.get_header ().num_features;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int ConcentrationRegressionClassifier::predict (double *data, int data_len, double *output)
 {
-    if ((data_len < 5) || (data == NULL) || (output == NULL))
+    if (coefficients == NULL)
+    {
+        safe_logger (spdlog::level::err, "Please prepare classifier with prepare method.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    // undocumented feature(not recommended): builtin model may work without stddev but with worse
+    // accuracy, models from file require all features
+    int min_len = (model_file.is_open ()) ? num_features : 5;
+    if ((data_len < min_len) || (data == NULL) || (output == NULL))
     {
         safe_logger (spdlog::level::err,
-            "Incorrect arguments. Data len must be 10 and pointers should be non null.");
+            "Incorrect arguments. Data len must be {} and pointers should be non null.",
+            num_features);
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
     double value = 0.0;
-    // undocumented feature(not recommended): may work without stddev but with worse accuracy
-    for (int i = 0; i < std::min (data_len, 10); i++)
+    for (int i = 0; i < std::min (data_len, num_features); i++)
     {
-        value += regression_coefficients[i] * data[i];
+        value += coefficients[i] * data[i];
     }
-    double concentration = 1.0 / (1.0 + exp (-1.0 * (regression_intercept + value)));
+    double concentration = 1.0 / (1.0 + exp (-1.0 * (intercept + value)));
     *output = concentration;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
 
 int ConcentrationRegressionClassifier::release ()
 {
+    model_file.close ();
+    coefficients = NULL;
     return (int)BrainFlowExitCodes::STATUS_OK;
 }
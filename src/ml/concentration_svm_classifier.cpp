@@ -1,17 +1,122 @@
 #include <algorithm>
 #include <cmath>
 #include <stdlib.h>
+#include <string.h>
 
 #include "brainflow_constants.h"
 #include "concentration_svm_classifier.h"
 #include "get_dll_dir.h"
 
 
+#ifndef __ANDROID__
+// model is created in the same way as by svm_load_model, so it can be freed by
+// svm_free_and_destroy_model
+static struct svm_model *create_svm_model (const ModelFile &model_file)
+{
+    const ModelFileHeader &header = model_file.get_header ();
+    int num_sv = (int)header.num_rows;
+    int num_features = (int)header.num_features;
+    struct svm_model *model = (struct svm_model *)calloc (1, sizeof (struct svm_model));
+    if (model == NULL)
+    {
+        return NULL;
+    }
+    model->param.svm_type = C_SVC;
+    model->param.kernel_type = header.kernel_type;
+    model->param.degree = header.degree;
+    model->param.gamma = header.gamma;
+    model->param.coef0 = header.coef0;
+    model->nr_class = 2;
+    model->l = num_sv;
+    model->free_sv = 1;
+    model->rho = (double *)malloc (sizeof (double));
+    model->probA = (double *)malloc (sizeof (double));
+    model->probB = (double *)malloc (sizeof (double));
+    model->label = (int *)malloc (2 * sizeof (int));
+    model->nSV = (int *)malloc (2 * sizeof (int));
+    model->sv_coef = (double **)calloc (1, sizeof (double *));
+    model->SV = (struct svm_node **)calloc (num_sv, sizeof (struct svm_node *));
+    if ((model->sv_coef != NULL) && (model->SV != NULL))
+    {
+        model->sv_coef[0] = (double *)malloc (num_sv * sizeof (double));
+        // single block for all vectors with -1 terminators, the same as x_space in libsvm
+        model->SV[0] = (struct svm_node *)malloc (
+            (size_t)num_sv * (num_features + 1) * sizeof (struct svm_node));
+    }
+    if ((model->rho == NULL) || (model->probA == NULL) || (model->probB == NULL) ||
+        (model->label == NULL) || (model->nSV == NULL) || (model->sv_coef == NULL) ||
+        (model->SV == NULL) || (model->sv_coef[0] == NULL) || (model->SV[0] == NULL))
+    {
+        svm_free_and_destroy_model (&model);
+        return NULL;
+    }
+    model->rho[0] = header.intercept;
+    model->probA[0] = header.prob_a;
+    model->probB[0] = header.prob_b;
+    for (int i = 0; i < 2; i++)
+    {
+        model->label[i] = header.labels[i];
+        model->nSV[i] = header.num_sv[i];
+    }
+    memcpy (model->sv_coef[0], model_file.get_sv_coef (), num_sv * sizeof (double));
+    const double *support_vectors = model_file.get_support_vectors ();
+    for (int i = 0; i < num_sv; i++)
+    {
+        struct svm_node *sv = model->SV[0] + (size_t)i * (num_features + 1);
+        const double *values = support_vectors + (size_t)i * num_features;
+        model->SV[i] = sv;
+        for (int j = 0; j < num_features; j++)
+        {
+            sv[j].index = j + 1;
+            sv[j].value = values[j];
+        }
+        sv[num_features].index = -1;
+    }
+    return model;
+}
+
+int ConcentrationSVMClassifier::load_model_file ()
+{
+    ModelFile model_file;
+    int res = model_file.open (params.file, (int)BrainFlowClassifiers::SVM);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    const ModelFileHeader &header = model_file.get_header ();
+    if ((header.kernel_type != LINEAR) && (header.kernel_type != POLY) &&
+        (header.kernel_type != RBF) && (header.kernel_type != SIGMOID))
+    {
+        safe_logger (spdlog::level::err, "Unsupported kernel type {}.", header.kernel_type);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    // support vectors are copied to libsvm structures, mapping is not needed after that
+    model = create_svm_model (model_file);
+    if (model == NULL)
+    {
+        safe_logger (spdlog::level::err, "failed to allocate model.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    num_features = (int)header.num_features;
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+#endif
+
+
 int ConcentrationSVMClassifier::prepare ()
 {
 #ifdef __ANDROID__
     return (int)BrainFlowExitCodes::UNSUPPORTED_CLASSIFIER_AND_METRIC_COMBINATION_ERROR;
 #else
+    if (model != NULL)
+    {
+        safe_logger (spdlog::level::err, "Classifier has already been prepared.");
+        return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
+    }
+    if (!params.file.empty ())
+    {
+        return load_model_file ();
+    }
     char path[1024];
     bool res = get_dll_path (path);
     if (!res)
@@ -51,10 +156,11 @@ int ConcentrationSVMClassifier::predict (double *data, int data_len, double *out
         safe_logger (spdlog::level::err, "Please prepare classifier with prepare method.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
-    if ((data_len != 10) || (data == NULL) || (output == NULL))
+    if ((data_len != num_features) || (data == NULL) || (output == NULL))
     {
         safe_logger (spdlog::level::err,
-            "Incorrect arguments. Data len must be 10 and pointers should be non null.");
+            "Incorrect arguments. Data len must be {} and pointers should be non null.",
+            num_features);
         return (int)BrainFlowExitCodes::INVALID_BUFFER_SIZE_ERROR;
     }
     struct svm_node *x = (struct svm_node *)malloc ((data_len + 1) * sizeof (struct svm_node));
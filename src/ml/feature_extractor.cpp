@@ -0,0 +1,52 @@
+#include <string.h>
+
+#include "base_classifier.h"
+#include "brainflow_constants.h"
+#include "brainflow_libs.h"
+#include "feature_extractor.h"
+
+
+int FeatureExtractor::get_features (const double *data, int rows, int cols, int sampling_rate,
+    const int *channels, int num_channels, double *features)
+{
+    if ((data == NULL) || (channels == NULL) || (features == NULL) || (rows < 1) || (cols < 1) ||
+        (num_channels < 1) || (sampling_rate < 1))
+    {
+        BaseClassifier::ml_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    for (int i = 0; i < num_channels; i++)
+    {
+        if ((channels[i] < 0) || (channels[i] >= rows))
+        {
+            BaseClassifier::ml_logger->error ("Invalid channel {} for {} rows.", channels[i], rows);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    if (get_avg_band_powers == NULL)
+    {
+        DLLLoader *data_handler = BrainFlowLibs::get_data_handler ();
+        if (data_handler != NULL)
+        {
+            get_avg_band_powers =
+                (GetAvgBandPowersFunc)data_handler->get_address ("get_avg_band_powers");
+        }
+        if (get_avg_band_powers == NULL)
+        {
+            BaseClassifier::ml_logger->error ("Failed to get get_avg_band_powers function.");
+            return (int)BrainFlowExitCodes::GENERAL_ERROR;
+        }
+    }
+    size_t size = (size_t)num_channels * cols;
+    if (channels_data.size () < size)
+    {
+        channels_data.resize (size);
+    }
+    for (int i = 0; i < num_channels; i++)
+    {
+        memcpy (channels_data.data () + (size_t)i * cols, data + (size_t)channels[i] * cols,
+            sizeof (double) * cols);
+    }
+    return get_avg_band_powers (channels_data.data (), num_channels, cols, sampling_rate, 1,
+        features, features + NUM_FEATURES / 2);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "brainflow_model_params.h"
+#include "feature_extractor.h"
 #include "spdlog/spdlog.h"
 
 class BaseClassifier
@@ -48,4 +49,11 @@ public:
     virtual int prepare () = 0;
     virtual int predict (double *data, int data_len, double *output) = 0;
     virtual int release () = 0;
+
+    // feature extraction from raw data and predict in a single call
+    int predict_from_raw (const double *data, int rows, int cols, int sampling_rate,
+        const int *channels, int num_channels, double *output);
+
+private:
+    FeatureExtractor feature_extractor;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "runtime_dll_loader.h"
+
+
+// ml module doesnt link other brainflow libraries, they are loaded at runtime from the same folder
+// on first use and stay loaded, if library is already loaded by application the same instance is
+// used, so board sessions created by application are visible here
+class BrainFlowLibs
+{
+public:
+    // return NULL if library can not be loaded
+    static DLLLoader *get_data_handler ();
+    static DLLLoader *get_board_controller ();
+
+private:
+    static DLLLoader *load (const char *lib_name);
+};
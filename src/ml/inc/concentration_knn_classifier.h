@@ -4,8 +4,8 @@
 
 #include "base_classifier.h"
 #include "focus_point.h"
-
-#include "kdtree.h"
+#include "model_file.h"
+#include "quantized_knn.h"
 
 
 class ConcentrationKNNClassifier : public BaseClassifier
@@ -14,7 +14,8 @@ public:
     ConcentrationKNNClassifier (struct BrainFlowModelParams params) : BaseClassifier (params)
     {
         num_neighbors = 5;
-        kdtree = NULL;
+        num_features = FocusPoint::DIM;
+        index = NULL;
     }
 
     virtual ~ConcentrationKNNClassifier ()
@@ -28,7 +29,14 @@ public:
     virtual int release ();
 
 private:
-    std::vector<FocusPoint> dataset;
-    kdt::KDTree<FocusPoint> *kdtree;
+    // weighted points and labels until index is built
+    std::vector<double> points;
+    std::vector<int> labels;
+    QuantizedKNN *index;
     int num_neighbors;
+    int num_features;
+    // features are multiplied by weights before distance calculation
+    double feature_weights[FocusPoint::DIM];
+
+    int load_dataset ();
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_classifier.h"
+#include "model_file.h"
 
 
 class ConcentrationLDAClassifier : public BaseClassifier
@@ -8,6 +9,9 @@ class ConcentrationLDAClassifier : public BaseClassifier
 public:
     ConcentrationLDAClassifier (struct BrainFlowModelParams params) : BaseClassifier (params)
     {
+        coefficients = NULL;
+        intercept = 0.0;
+        num_features = 0;
     }
 
     virtual ~ConcentrationLDAClassifier ()
@@ -19,4 +23,11 @@ public:
     virtual int prepare ();
     virtual int predict (double *data, int data_len, double *output);
     virtual int release ();
+
+private:
+    // builtin coefficients or coefficients from mapped model file
+    ModelFile model_file;
+    const double *coefficients;
+    double intercept;
+    int num_features;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_classifier.h"
+#include "model_file.h"
 #include "svm.h"
 
 class ConcentrationSVMClassifier : public BaseClassifier
@@ -9,6 +10,7 @@ public:
     ConcentrationSVMClassifier (struct BrainFlowModelParams params) : BaseClassifier (params)
     {
         model = NULL;
+        num_features = 10;
     }
 
     virtual ~ConcentrationSVMClassifier ()
@@ -23,4 +25,7 @@ public:
 
 private:
     struct svm_model *model;
+    int num_features;
+
+    int load_model_file ();
 };
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+
+// feature vector for builtin models: avg band powers for 5 bands followed by their stddev, the
+// same as get_avg_band_powers with filters from data handler, buffer for selected channels is
+// reused between calls
+class FeatureExtractor
+{
+public:
+    static const int NUM_FEATURES = 10;
+
+    FeatureExtractor ()
+    {
+        get_avg_band_powers = NULL;
+    }
+
+    // data is rows x cols like board data, features should have NUM_FEATURES elements
+    int get_features (const double *data, int rows, int cols, int sampling_rate,
+        const int *channels, int num_channels, double *features);
+
+private:
+    typedef int (*GetAvgBandPowersFunc) (double *, int, int, int, int, double *, double *);
+
+    GetAvgBandPowersFunc get_avg_band_powers;
+    std::vector<double> channels_data;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// calculates metric in background thread from the latest window_size samples of board session
+// every interval_ms, scores are kept until they are read by get_scores
+class MetricStream
+{
+public:
+    // up to 10 minutes of scores for one second interval
+    static const size_t MAX_SCORES = 600;
+
+    // data is num_rows x window_size, predict is called without any locks held by stream
+    typedef std::function<int (const double *data, int rows, int cols, double *score)>
+        PredictFunction;
+
+    MetricStream (int board_id, const std::string &input_params, int num_rows,
+        int timestamp_channel, int window_size, int interval_ms, PredictFunction predict);
+    ~MetricStream ();
+
+    MetricStream (const MetricStream &) = delete;
+    MetricStream &operator= (const MetricStream &) = delete;
+
+    int start ();
+    void stop ();
+    // oldest scores first, returns number of copied scores
+    int get_scores (int max_scores, double *scores, double *timestamps);
+
+private:
+    typedef int (*GetCurrentBoardDataFunc) (int, double *, int *, int, char *);
+
+    int board_id;
+    std::string input_params;
+    int num_rows;
+    int timestamp_channel;
+    int window_size;
+    int interval_ms;
+    PredictFunction predict;
+    GetCurrentBoardDataFunc get_current_board_data;
+    std::vector<double> window;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool keep_alive;
+    std::deque<double> scores;
+    std::deque<double> timestamps;
+
+    void run ();
+};
@@ -10,6 +10,19 @@ extern "C"
     SHARED_EXPORT int CALLING_CONVENTION predict (
         double *data, int data_len, double *output, char *json_params);
     SHARED_EXPORT int CALLING_CONVENTION release (char *json_params);
+    // data is rows x cols like board data, feature vector is calculated from channels with filters
+    // like in get_avg_band_powers and passed to predict
+    SHARED_EXPORT int CALLING_CONVENTION predict_from_raw (double *data, int rows, int cols,
+        int sampling_rate, int *channels, int num_channels, double *output, char *json_params);
+    // background thread calls predict_from_raw for the latest window_size samples of board session
+    // every interval_ms, stream is stopped by stop_metric_stream or release
+    SHARED_EXPORT int CALLING_CONVENTION start_metric_stream (int board_id,
+        char *json_brainflow_input_params, int *channels, int num_channels, int window_size,
+        int interval_ms, char *json_params);
+    // returns and removes oldest scores, timestamps are taken from the last sample of each window
+    SHARED_EXPORT int CALLING_CONVENTION get_metric_stream_scores (int max_scores, double *scores,
+        double *timestamps, int *num_scores, char *json_params);
+    SHARED_EXPORT int CALLING_CONVENTION stop_metric_stream (char *json_params);
 
     // logging methods
     SHARED_EXPORT int CALLING_CONVENTION set_log_level (int log_level);
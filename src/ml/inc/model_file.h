@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#define MODEL_FILE_VERSION 1
+#define MAX_MODEL_FEATURES 1024
+
+
+// binary model file, little endian: 128 bytes header followed by data sections, all sections
+// are arrays of doubles except knn labels, so doubles in mapped file are 8 bytes aligned
+// regression, lda: double coefficients[num_features]
+// svm: double sv_coef[num_rows], double support_vectors[num_rows][num_features]
+// knn: double feature_weights[num_features], double points[num_rows][num_features],
+//      int32 labels[num_rows]
+// positive class is concentration for all classifiers, relaxation is 1 - concentration
+struct ModelFileHeader
+{
+    char magic[8];          // "BFMODEL"
+    uint32_t version;       // MODEL_FILE_VERSION
+    uint32_t classifier;    // BrainFlowClassifiers
+    uint32_t num_features;  // size of feature vector
+    uint32_t num_rows;      // support vectors for svm, points for knn, 0 for linear models
+    uint32_t num_neighbors; // knn only, 0 to use default
+    int32_t kernel_type;    // svm only, libsvm kernel type
+    int32_t degree;         // svm only
+    int32_t labels[2];      // svm only, libsvm class labels
+    int32_t num_sv[2];      // svm only, number of support vectors for each label
+    uint32_t reserved;
+    double intercept;       // intercept for linear models, rho for svm
+    double gamma;           // svm only
+    double coef0;           // svm only
+    double prob_a;          // svm only, platt scaling
+    double prob_b;          // svm only, platt scaling
+    uint64_t data_size;     // size of data sections in bytes
+    char padding[24];
+};
+
+// file is memory mapped, validation checks only header and file size, so it doesnt depend on
+// model size, data sections are used directly from mapped memory
+class ModelFile
+{
+public:
+    ModelFile ();
+    ~ModelFile ();
+
+    ModelFile (const ModelFile &) = delete;
+    ModelFile &operator= (const ModelFile &) = delete;
+
+    // fails if file is not a valid model file for this classifier
+    int open (const std::string &path, int classifier);
+    void close ();
+    bool is_open () const
+    {
+        return (data != NULL);
+    }
+
+    const ModelFileHeader &get_header () const
+    {
+        return *(const ModelFileHeader *)data;
+    }
+    // regression and lda
+    const double *get_coefficients () const;
+    // svm
+    const double *get_sv_coef () const;
+    const double *get_support_vectors () const;
+    // knn
+    const double *get_feature_weights () const;
+    const double *get_points () const;
+    const int32_t *get_labels () const;
+
+    static uint64_t get_data_size (const ModelFileHeader &header);
+
+private:
+    char *data;
+    size_t size;
+    bool is_mapped;
+
+    const double *get_section (uint64_t offset) const
+    {
+        return (const double *)(data + sizeof (ModelFileHeader) + offset);
+    }
+    std::string validate () const;
+};
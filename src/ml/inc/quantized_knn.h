@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+
+// brute force knn search over uint8 quantized points, each feature is quantized separately in
+// [min, max] range, codes are stored feature by feature in blocks of BLOCK_SIZE points, so scan
+// reads ~1 byte per feature per point and inner loops are vectorized by compiler
+// quantization error is bounded, so points which may be closer than k-th neighbor are rechecked
+// with exact distance, result is the same as for exact search except order of equal distances
+class QuantizedKNN
+{
+public:
+    static const int BLOCK_SIZE = 256;
+
+    // points are copied, weights should be applied before
+    QuantizedKNN (const double *points, const int *labels, int num_points, int num_features);
+
+    // writes ids of num_neighbors closest points sorted by distance, query has num_features values
+    void search (const double *query, int num_neighbors, int *ids) const;
+
+    int get_label (int id) const
+    {
+        return labels[id];
+    }
+
+    int get_num_points () const
+    {
+        return num_points;
+    }
+
+private:
+    int num_points;
+    int num_features;
+    int num_blocks;
+    // codes[block][feature][BLOCK_SIZE]
+    std::vector<uint8_t> codes;
+    std::vector<float> mins;
+    std::vector<float> scales;
+    // squared scales, weights for distance in quantized units
+    std::vector<float> weights;
+    // max distance between point and its quantized value
+    double max_error;
+    // for exact distances of candidates
+    std::vector<double> points;
+    std::vector<int> labels;
+};
@@ -0,0 +1,126 @@
+#include <chrono>
+
+#include "base_classifier.h"
+#include "brainflow_constants.h"
+#include "brainflow_libs.h"
+#include "metric_stream.h"
+
+
+MetricStream::MetricStream (int board_id, const std::string &input_params, int num_rows,
+    int timestamp_channel, int window_size, int interval_ms, PredictFunction predict)
+    : input_params (input_params), predict (predict)
+{
+    this->board_id = board_id;
+    this->num_rows = num_rows;
+    this->timestamp_channel = timestamp_channel;
+    this->window_size = window_size;
+    this->interval_ms = interval_ms;
+    get_current_board_data = NULL;
+    keep_alive = false;
+}
+
+MetricStream::~MetricStream ()
+{
+    stop ();
+}
+
+int MetricStream::start ()
+{
+    if (thread.joinable ())
+    {
+        BaseClassifier::ml_logger->error ("Metric stream is already running.");
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
+    DLLLoader *board_controller = BrainFlowLibs::get_board_controller ();
+    if (board_controller != NULL)
+    {
+        get_current_board_data =
+            (GetCurrentBoardDataFunc)board_controller->get_address ("get_current_board_data");
+    }
+    if (get_current_board_data == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Failed to get get_current_board_data function.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    try
+    {
+        window.resize ((size_t)num_rows * window_size);
+        keep_alive = true;
+        thread = std::thread ([this] { this->run (); });
+    }
+    catch (...)
+    {
+        keep_alive = false;
+        BaseClassifier::ml_logger->error ("Failed to start metric stream.");
+        return (int)BrainFlowExitCodes::STREAM_THREAD_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void MetricStream::stop ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        keep_alive = false;
+    }
+    cv.notify_all ();
+    if (thread.joinable ())
+    {
+        thread.join ();
+    }
+}
+
+int MetricStream::get_scores (int max_scores, double *scores, double *timestamps)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    int count = 0;
+    while ((count < max_scores) && (!this->scores.empty ()))
+    {
+        scores[count] = this->scores.front ();
+        timestamps[count] = this->timestamps.front ();
+        this->scores.pop_front ();
+        this->timestamps.pop_front ();
+        count++;
+    }
+    return count;
+}
+
+void MetricStream::run ()
+{
+    auto next_time = std::chrono::steady_clock::now ();
+    while (true)
+    {
+        next_time += std::chrono::milliseconds (interval_ms);
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            cv.wait_until (lock, next_time, [this] { return !keep_alive; });
+            if (!keep_alive)
+            {
+                return;
+            }
+        }
+        int num_samples = 0;
+        int res = get_current_board_data (window_size, window.data (), &num_samples, board_id,
+            const_cast<char *> (input_params.c_str ()));
+        // not enough data yet
+        if ((res != (int)BrainFlowExitCodes::STATUS_OK) || (num_samples < window_size))
+        {
+            continue;
+        }
+        double score = 0.0;
+        res = predict (window.data (), num_rows, window_size, &score);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            continue;
+        }
+        double timestamp = window[(size_t)(timestamp_channel + 1) * window_size - 1];
+        std::lock_guard<std::mutex> lock (mutex);
+        if (scores.size () >= MAX_SCORES)
+        {
+            scores.pop_front ();
+            timestamps.pop_front ();
+        }
+        scores.push_back (score);
+        timestamps.push_back (timestamp);
+    }
+}
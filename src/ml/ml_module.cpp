@@ -1,15 +1,19 @@
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include "base_classifier.h"
 #include "brainflow_constants.h"
+#include "brainflow_libs.h"
 #include "brainflow_model_params.h"
 #include "concentration_knn_classifier.h"
 #include "concentration_lda_classifier.h"
 #include "concentration_regression_classifier.h"
 #include "concentration_svm_classifier.h"
+#include "metric_stream.h"
 #include "ml_module.h"
 #include "relaxation_knn_classifier.h"
 #include "relaxation_lda_classifier.h"
@@ -24,6 +28,8 @@ int string_to_brainflow_model_params (const char *json_params, struct BrainFlowM
 
 std::map<struct BrainFlowModelParams, std::shared_ptr<BaseClassifier>> ml_models;
 std::mutex models_mutex;
+// declared after models_mutex, streams use it until they are stopped
+std::map<struct BrainFlowModelParams, std::shared_ptr<MetricStream>> metric_streams;
 
 
 int prepare (char *json_params)
@@ -122,30 +128,244 @@ int predict (double *data, int data_len, double *output, char *json_params)
     return model->second->predict (data, data_len, output);
 }
 
-int release (char *json_params)
+int predict_from_raw (double *data, int rows, int cols, int sampling_rate, int *channels,
+    int num_channels, double *output, char *json_params)
 {
     std::lock_guard<std::mutex> lock (models_mutex);
-
     struct BrainFlowModelParams key (
         (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
-    BaseClassifier::ml_logger->trace ("(Release)Incoming json: {}", json_params);
+    BaseClassifier::ml_logger->trace ("(PredictFromRaw)Incoming json: {}", json_params);
     int res = string_to_brainflow_model_params (json_params, &key);
     if (res != (int)BrainFlowExitCodes::STATUS_OK)
     {
         return res;
     }
+    auto model = ml_models.find (key);
+    if (model == ml_models.end ())
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before using it for prediction.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    return model->second->predict_from_raw (
+        data, rows, cols, sampling_rate, channels, num_channels, output);
+}
+
+int release (char *json_params)
+{
+    std::shared_ptr<MetricStream> stream = NULL;
+    int res = (int)BrainFlowExitCodes::STATUS_OK;
+    {
+        std::lock_guard<std::mutex> lock (models_mutex);
+
+        struct BrainFlowModelParams key (
+            (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
+        BaseClassifier::ml_logger->trace ("(Release)Incoming json: {}", json_params);
+        res = string_to_brainflow_model_params (json_params, &key);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+
+        auto model = ml_models.find (key);
+        if (model == ml_models.end ())
+        {
+            BaseClassifier::ml_logger->error ("Must prepare model before releasing it.");
+            return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+        }
+        res = model->second->release ();
+        ml_models.erase (model);
+
+        auto metric_stream = metric_streams.find (key);
+        if (metric_stream != metric_streams.end ())
+        {
+            stream = metric_stream->second;
+            metric_streams.erase (metric_stream);
+        }
+    }
+    // stream thread may wait for models_mutex, stop it after unlock
+    if (stream != NULL)
+    {
+        stream->stop ();
+    }
+    return res;
+}
 
+// board description is needed to allocate window and find timestamps
+static int get_board_description (int board_id, const char *json_input_params,
+    int *sampling_rate, int *num_rows, int *timestamp_channel)
+{
+    DLLLoader *board_controller = BrainFlowLibs::get_board_controller ();
+    if (board_controller == NULL)
+    {
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    int (*get_sampling_rate) (int, int *) =
+        (int (*) (int, int *))board_controller->get_address ("get_sampling_rate");
+    int (*get_num_rows) (int, int *) =
+        (int (*) (int, int *))board_controller->get_address ("get_num_rows");
+    int (*get_timestamp_channel) (int, int *) =
+        (int (*) (int, int *))board_controller->get_address ("get_timestamp_channel");
+    if ((get_sampling_rate == NULL) || (get_num_rows == NULL) || (get_timestamp_channel == NULL))
+    {
+        BaseClassifier::ml_logger->error ("Failed to get board description functions.");
+        return (int)BrainFlowExitCodes::GENERAL_ERROR;
+    }
+    // data layout of streaming and playback boards is defined by master board from other_info
+    int master_board_id = board_id;
+    if ((board_id == (int)BoardIds::STREAMING_BOARD) ||
+        (board_id == (int)BoardIds::PLAYBACK_FILE_BOARD))
+    {
+        try
+        {
+            json config = json::parse (std::string (json_input_params));
+            master_board_id = std::stoi (config["other_info"].get<std::string> ());
+        }
+        catch (...)
+        {
+            BaseClassifier::ml_logger->error ("Write master board id to other_info field.");
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    int res = get_sampling_rate (master_board_id, sampling_rate);
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = get_num_rows (master_board_id, num_rows);
+    }
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        res = get_timestamp_channel (master_board_id, timestamp_channel);
+    }
+    return res;
+}
+
+// model is looked up on each call, so stream doesnt keep released model alive
+static int predict_for_stream (const struct BrainFlowModelParams &key,
+    const std::vector<int> &channels, int sampling_rate, const double *data, int rows, int cols,
+    double *score)
+{
+    std::lock_guard<std::mutex> lock (models_mutex);
     auto model = ml_models.find (key);
     if (model == ml_models.end ())
     {
-        BaseClassifier::ml_logger->error ("Must prepare model before releasing it.");
         return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
     }
-    res = model->second->release ();
-    ml_models.erase (model);
+    return model->second->predict_from_raw (
+        data, rows, cols, sampling_rate, channels.data (), (int)channels.size (), score);
+}
+
+int start_metric_stream (int board_id, char *json_input_params, int *channels, int num_channels,
+    int window_size, int interval_ms, char *json_params)
+{
+    if ((json_input_params == NULL) || (channels == NULL) || (num_channels < 1) ||
+        (window_size < 1) || (interval_ms < 1))
+    {
+        BaseClassifier::ml_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (models_mutex);
+    struct BrainFlowModelParams key (
+        (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
+    BaseClassifier::ml_logger->trace ("(StartMetricStream)Incoming json: {}", json_params);
+    int res = string_to_brainflow_model_params (json_params, &key);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    if (ml_models.find (key) == ml_models.end ())
+    {
+        BaseClassifier::ml_logger->error ("Must prepare model before starting metric stream.");
+        return (int)BrainFlowExitCodes::CLASSIFIER_IS_NOT_PREPARED_ERROR;
+    }
+    if (metric_streams.find (key) != metric_streams.end ())
+    {
+        BaseClassifier::ml_logger->error ("Metric stream is already running for this model.");
+        return (int)BrainFlowExitCodes::STREAM_ALREADY_RUN_ERROR;
+    }
+    int sampling_rate = 0;
+    int num_rows = 0;
+    int timestamp_channel = 0;
+    res = get_board_description (
+        board_id, json_input_params, &sampling_rate, &num_rows, &timestamp_channel);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    std::vector<int> stream_channels (channels, channels + num_channels);
+    for (int i = 0; i < num_channels; i++)
+    {
+        if ((channels[i] < 0) || (channels[i] >= num_rows))
+        {
+            BaseClassifier::ml_logger->error ("Invalid channel {}.", channels[i]);
+            return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+        }
+    }
+    MetricStream::PredictFunction predict = std::bind (predict_for_stream, key, stream_channels,
+        sampling_rate, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4);
+    std::shared_ptr<MetricStream> stream = std::make_shared<MetricStream> (board_id,
+        std::string (json_input_params), num_rows, timestamp_channel, window_size, interval_ms,
+        predict);
+    res = stream->start ();
+    if (res == (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        metric_streams[key] = stream;
+    }
     return res;
 }
 
+int get_metric_stream_scores (
+    int max_scores, double *scores, double *timestamps, int *num_scores, char *json_params)
+{
+    if ((max_scores < 1) || (scores == NULL) || (timestamps == NULL) || (num_scores == NULL))
+    {
+        BaseClassifier::ml_logger->error ("Please review your arguments.");
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (models_mutex);
+    struct BrainFlowModelParams key (
+        (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
+    int res = string_to_brainflow_model_params (json_params, &key);
+    if (res != (int)BrainFlowExitCodes::STATUS_OK)
+    {
+        return res;
+    }
+    auto stream = metric_streams.find (key);
+    if (stream == metric_streams.end ())
+    {
+        BaseClassifier::ml_logger->error ("Metric stream is not running for this model.");
+        return (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING;
+    }
+    *num_scores = stream->second->get_scores (max_scores, scores, timestamps);
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+int stop_metric_stream (char *json_params)
+{
+    std::shared_ptr<MetricStream> stream = NULL;
+    {
+        std::lock_guard<std::mutex> lock (models_mutex);
+        struct BrainFlowModelParams key (
+            (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
+        BaseClassifier::ml_logger->trace ("(StopMetricStream)Incoming json: {}", json_params);
+        int res = string_to_brainflow_model_params (json_params, &key);
+        if (res != (int)BrainFlowExitCodes::STATUS_OK)
+        {
+            return res;
+        }
+        auto metric_stream = metric_streams.find (key);
+        if (metric_stream == metric_streams.end ())
+        {
+            BaseClassifier::ml_logger->error ("Metric stream is not running for this model.");
+            return (int)BrainFlowExitCodes::STREAM_THREAD_IS_NOT_RUNNING;
+        }
+        stream = metric_stream->second;
+        metric_streams.erase (metric_stream);
+    }
+    // stream thread may wait for models_mutex, stop it after unlock
+    stream->stop ();
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
 int string_to_brainflow_model_params (const char *json_params, struct BrainFlowModelParams *params)
 {
     // input string -> json -> struct BrainFlowModelParams
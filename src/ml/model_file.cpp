@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "base_classifier.h"
+#include "brainflow_constants.h"
+#include "model_file.h"
+
+#define MODEL_FILE_MAGIC "BFMODEL"
+
+static_assert (sizeof (ModelFileHeader) == 128, "model file header must be 128 bytes");
+
+
+ModelFile::ModelFile ()
+{
+    data = NULL;
+    size = 0;
+    is_mapped = false;
+}
+
+ModelFile::~ModelFile ()
+{
+    close ();
+}
+
+int ModelFile::open (const std::string &path, int classifier)
+{
+    if (data != NULL)
+    {
+        BaseClassifier::ml_logger->error ("Model file is already opened.");
+        return (int)BrainFlowExitCodes::ANOTHER_CLASSIFIER_IS_PREPARED_ERROR;
+    }
+#ifdef _WIN32
+    // no mmap, read the whole file
+    FILE *fp = fopen (path.c_str (), "rb");
+    if (fp == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Failed to open model file {}.", path);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    fseek (fp, 0, SEEK_END);
+    long file_size = ftell (fp);
+    fseek (fp, 0, SEEK_SET);
+    if (file_size >= (long)sizeof (ModelFileHeader))
+    {
+        size = (size_t)file_size;
+        data = new char[size];
+        if (fread (data, 1, size, fp) != size)
+        {
+            close ();
+        }
+    }
+    fclose (fp);
+#else
+    int fd = ::open (path.c_str (), O_RDONLY);
+    if (fd < 0)
+    {
+        BaseClassifier::ml_logger->error ("Failed to open model file {}.", path);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    struct stat file_stat;
+    if ((fstat (fd, &file_stat) == 0) && (file_stat.st_size >= (off_t)sizeof (ModelFileHeader)))
+    {
+        void *addr = mmap (NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            data = (char *)addr;
+            size = (size_t)file_stat.st_size;
+            is_mapped = true;
+        }
+    }
+    // mapping stays valid after close
+    ::close (fd);
+#endif
+    if (data == NULL)
+    {
+        BaseClassifier::ml_logger->error ("Failed to read model file {}.", path);
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+
+    std::string error = validate ();
+    if ((error.empty ()) && (get_header ().classifier != (uint32_t)classifier))
+    {
+        error = "model is trained for another classifier";
+    }
+    if (!error.empty ())
+    {
+        BaseClassifier::ml_logger->error ("Invalid model file {}: {}.", path, error);
+        close ();
+        return (int)BrainFlowExitCodes::INVALID_ARGUMENTS_ERROR;
+    }
+    return (int)BrainFlowExitCodes::STATUS_OK;
+}
+
+void ModelFile::close ()
+{
+    if (data == NULL)
+    {
+        return;
+    }
+#ifndef _WIN32
+    if (is_mapped)
+    {
+        munmap (data, size);
+    }
+    else
+#endif
+    {
+        delete[] data;
+    }
+    data = NULL;
+    size = 0;
+    is_mapped = false;
+}
+
+uint64_t ModelFile::get_data_size (const ModelFileHeader &header)
+{
+    uint64_t num_features = header.num_features;
+    uint64_t num_rows = header.num_rows;
+    switch (header.classifier)
+    {
+        case (int)BrainFlowClassifiers::REGRESSION:
+        case (int)BrainFlowClassifiers::LDA:
+            return num_features * sizeof (double);
+        case (int)BrainFlowClassifiers::SVM:
+            return num_rows * (1 + num_features) * sizeof (double);
+        case (int)BrainFlowClassifiers::KNN:
+            return (1 + num_rows) * num_features * sizeof (double) + num_rows * sizeof (int32_t);
+        default:
+            return 0;
+    }
+}
+
+std::string ModelFile::validate () const
+{
+    const ModelFileHeader &header = get_header ();
+    if (memcmp (header.magic, MODEL_FILE_MAGIC, sizeof (MODEL_FILE_MAGIC)) != 0)
+    {
+        return "not a brainflow model file";
+    }
+    if (header.version != MODEL_FILE_VERSION)
+    {
+        return "unsupported version " + std::to_string (header.version);
+    }
+    if ((header.num_features < 1) || (header.num_features > MAX_MODEL_FEATURES))
+    {
+        return "num_features should be in range [1, " + std::to_string (MAX_MODEL_FEATURES) + "]";
+    }
+    switch (header.classifier)
+    {
+        case (int)BrainFlowClassifiers::REGRESSION:
+        case (int)BrainFlowClassifiers::LDA:
+            if (header.num_rows != 0)
+            {
+                return "num_rows should be 0 for linear models";
+            }
+            break;
+        case (int)BrainFlowClassifiers::SVM:
+            if ((header.num_sv[0] < 1) || (header.num_sv[1] < 1) ||
+                ((uint64_t)header.num_sv[0] + (uint64_t)header.num_sv[1] != header.num_rows))
+            {
+                return "num_sv should be positive and sum of num_sv should be equal to num_rows";
+            }
+            break;
+        case (int)BrainFlowClassifiers::KNN:
+            if (header.num_rows < 1)
+            {
+                return "knn model should have at least one point";
+            }
+            break;
+        default:
+            return "unknown classifier " + std::to_string (header.classifier);
+    }
+    if (header.data_size != get_data_size (header))
+    {
+        return "data_size doesnt match num_features and num_rows";
+    }
+    if ((uint64_t)size - sizeof (ModelFileHeader) != header.data_size)
+    {
+        return "file size doesnt match data_size";
+    }
+    return "";
+}
+
+const double *ModelFile::get_coefficients () const
+{
+    return get_section (0);
+}
+
+const double *ModelFile::get_sv_coef () const
+{
+    return get_section (0);
+}
+
+const double *ModelFile::get_support_vectors () const
+{
+    return get_section ((uint64_t)get_header ().num_rows * sizeof (double));
+}
+
+const double *ModelFile::get_feature_weights () const
+{
+    return get_section (0);
+}
+
+const double *ModelFile::get_points () const
+{
+    return get_section ((uint64_t)get_header ().num_features * sizeof (double));
+}
+
+const int32_t *ModelFile::get_labels () const
+{
+    const ModelFileHeader &header = get_header ();
+    return (const int32_t *)get_section (
+        (uint64_t)(1 + header.num_rows) * header.num_features * sizeof (double));
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "quantized_knn.h"
+#include "scratch_arena.h"
+
+// float accumulation in scan is not exact, keep candidates a bit further than the bound
+#define BOUND_SLACK 1e-4
+
+
+QuantizedKNN::QuantizedKNN (
+    const double *points, const int *labels, int num_points, int num_features)
+    : points (points, points + (size_t)num_points * num_features),
+      labels (labels, labels + num_points)
+{
+    this->num_points = num_points;
+    this->num_features = num_features;
+    num_blocks = (num_points + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    mins.resize (num_features);
+    scales.resize (num_features);
+    weights.resize (num_features);
+    for (int j = 0; j < num_features; j++)
+    {
+        double min_value = points[j];
+        double max_value = points[j];
+        for (int i = 1; i < num_points; i++)
+        {
+            min_value = std::min (min_value, points[(size_t)i * num_features + j]);
+            max_value = std::max (max_value, points[(size_t)i * num_features + j]);
+        }
+        mins[j] = (float)min_value;
+        scales[j] = (max_value > min_value) ? (float)((max_value - min_value) / 255.0) : 1.0f;
+        weights[j] = scales[j] * scales[j];
+    }
+
+    // tail of the last block is filled with zeros, its distances are never checked
+    codes.assign ((size_t)num_blocks * num_features * BLOCK_SIZE, 0);
+    max_error = 0.0;
+    for (int i = 0; i < num_points; i++)
+    {
+        uint8_t *block = &codes[(size_t)(i / BLOCK_SIZE) * num_features * BLOCK_SIZE];
+        double error = 0.0;
+        for (int j = 0; j < num_features; j++)
+        {
+            double value = points[(size_t)i * num_features + j];
+            double code = std::round ((value - mins[j]) / scales[j]);
+            code = std::min (std::max (code, 0.0), 255.0);
+            block[j * BLOCK_SIZE + i % BLOCK_SIZE] = (uint8_t)code;
+            double diff = value - ((double)mins[j] + code * (double)scales[j]);
+            error += diff * diff;
+        }
+        max_error = std::max (max_error, std::sqrt (error));
+    }
+}
+
+void QuantizedKNN::search (const double *query, int num_neighbors, int *ids) const
+{
+    ScratchScope scratch;
+    float *scaled_query = scratch.alloc<float> (num_features);
+    for (int j = 0; j < num_features; j++)
+    {
+        scaled_query[j] = (float)((query[j] - mins[j]) / scales[j]);
+    }
+    // max heap with num_neighbors smallest quantized distances
+    float *heap = scratch.alloc<float> (num_neighbors);
+    int heap_size = 0;
+    // quantized distance differs from exact one by at most max_error, so any of k nearest points
+    // is within k-th smallest quantized distance + 2 * max_error
+    float bound = INFINITY;
+    float *candidate_distances = scratch.alloc<float> (num_points);
+    int *candidate_ids = scratch.alloc<int> (num_points);
+    int num_candidates = 0;
+    float distances[BLOCK_SIZE];
+
+    for (int block = 0; block < num_blocks; block++)
+    {
+        const uint8_t *block_codes = &codes[(size_t)block * num_features * BLOCK_SIZE];
+        for (int i = 0; i < BLOCK_SIZE; i++)
+        {
+            distances[i] = 0.0f;
+        }
+        for (int j = 0; j < num_features; j++)
+        {
+            const uint8_t *feature_codes = block_codes + j * BLOCK_SIZE;
+            float value = scaled_query[j];
+            float weight = weights[j];
+            for (int i = 0; i < BLOCK_SIZE; i++)
+            {
+                float diff = value - (float)feature_codes[i];
+                distances[i] += weight * diff * diff;
+            }
+        }
+        int first_id = block * BLOCK_SIZE;
+        int block_len = std::min (BLOCK_SIZE, num_points - first_id);
+        for (int i = 0; i < block_len; i++)
+        {
+            float distance = distances[i];
+            if (distance > bound)
+            {
+                continue;
+            }
+            candidate_distances[num_candidates] = distance;
+            candidate_ids[num_candidates] = first_id + i;
+            num_candidates++;
+            if (heap_size < num_neighbors)
+            {
+                heap[heap_size++] = distance;
+                std::push_heap (heap, heap + heap_size);
+            }
+            else if (distance < heap[0])
+            {
+                std::pop_heap (heap, heap + heap_size);
+                heap[heap_size - 1] = distance;
+                std::push_heap (heap, heap + heap_size);
+            }
+            else
+            {
+                continue;
+            }
+            if (heap_size == num_neighbors)
+            {
+                double radius = std::sqrt ((double)heap[0]) + 2.0 * max_error;
+                bound = (float)(radius * radius * (1.0 + BOUND_SLACK));
+            }
+        }
+    }
+
+    // recheck candidates which are still within the final bound with exact distances, ties are
+    // ordered by id
+    std::pair<double, int> *exact = scratch.alloc<std::pair<double, int>> (num_candidates);
+    int num_exact = 0;
+    for (int i = 0; i < num_candidates; i++)
+    {
+        if (candidate_distances[i] > bound)
+        {
+            continue;
+        }
+        const double *point = &points[(size_t)candidate_ids[i] * num_features];
+        double distance = 0.0;
+        for (int j = 0; j < num_features; j++)
+        {
+            double diff = query[j] - point[j];
+            distance += diff * diff;
+        }
+        exact[num_exact++] = std::make_pair (distance, candidate_ids[i]);
+    }
+    std::partial_sort (exact, exact + num_neighbors, exact + num_exact);
+    for (int i = 0; i < num_neighbors; i++)
+    {
+        ids[i] = exact[i].second;
+    }
+}
@@ -1,4 +1,5 @@
 import os
+import struct
 
 
 def write_knn_model(data):
@@ -51,3 +52,54 @@ double %s_intercept = %lf;
     file_path = os.path.join(os.path.dirname(os.path.realpath(__file__)), '..', 'generated', file_name)
     with open(file_path, 'w') as f:
         f.write(file_content)
+
+
+# binary model format for BrainFlowModelParams.file, see src/ml/inc/model_file.h
+MODEL_FILE_VERSION = 1
+MODEL_FILE_HEADER_FORMAT = '<8s5I2i2i2iI5dQ24x'
+REGRESSION, KNN, SVM, LDA = 0, 1, 2, 3
+
+
+def write_model_file(file_path, classifier, num_features, sections, num_rows=0, num_neighbors=0, kernel_type=0,
+                     degree=0, labels=(0, 0), num_sv=(0, 0), intercept=0.0, gamma=0.0, coef0=0.0, prob_a=0.0,
+                     prob_b=0.0):
+    # sections is a list of (struct format char, values)
+    data = b''.join([struct.pack('<%d%s' % (len(values), fmt), *values) for fmt, values in sections])
+    header = struct.pack(MODEL_FILE_HEADER_FORMAT, b'BFMODEL', MODEL_FILE_VERSION, classifier, num_features,
+                         num_rows, num_neighbors, kernel_type, degree, labels[0], labels[1], num_sv[0], num_sv[1],
+                         0, intercept, gamma, coef0, prob_a, prob_b, len(data))
+    with open(file_path, 'wb') as f:
+        f.write(header)
+        f.write(data)
+
+
+def write_linear_model_file(file_path, intercept, coefs, classifier=REGRESSION):
+    # classifier is REGRESSION or LDA, intercept and coefs are the same as in write_model
+    coefs = [float(x) for x in coefs[0]]
+    write_model_file(file_path, classifier, len(coefs), [('d', coefs)], intercept=float(intercept[0]))
+
+
+def write_knn_model_file(file_path, data, num_neighbors=5, feature_weights=None):
+    # data is the same as in write_knn_model, labels are 0 or 1
+    num_features = len(data[0][0])
+    if feature_weights is None:
+        feature_weights = [1.0] * num_features
+    points = [float(y) for x in data[0] for y in x]
+    labels = [int(x) for x in data[1]]
+    write_model_file(file_path, KNN, num_features,
+                     [('d', [float(x) for x in feature_weights]), ('d', points), ('i', labels)],
+                     num_rows=len(labels), num_neighbors=num_neighbors)
+
+
+def write_svm_model_file(file_path, model, num_features=10):
+    # model is a binary libsvm model trained with probability estimates (-b 1)
+    num_sv = model.get_nr_sv()
+    sv_coef = [float(x[0]) for x in model.get_sv_coef()]
+    support_vectors = list()
+    for sv in model.get_SV():
+        support_vectors.extend([float(sv.get(i + 1, 0.0)) for i in range(num_features)])
+    write_model_file(file_path, SVM, num_features, [('d', sv_coef), ('d', support_vectors)], num_rows=num_sv,
+                     kernel_type=model.param.kernel_type, degree=model.param.degree,
+                     labels=(model.label[0], model.label[1]), num_sv=(model.nSV[0], model.nSV[1]),
+                     intercept=model.rho[0], gamma=model.param.gamma, coef0=model.param.coef0,
+                     prob_a=model.probA[0], prob_b=model.probB[0])
@@ -12,7 +12,7 @@
 #pragma comment(lib, "AdvApi32.lib")
 
 
-BroadCastClient::BroadCastClient (int port)
+BroadCastClient::BroadCastClient (int port) : capture (PacketTransports::DATAGRAM)
 {
     this->port = port;
     connect_socket = INVALID_SOCKET;
@@ -52,17 +52,24 @@ int BroadCastClient::init ()
 
 int BroadCastClient::recv (void *data, int size)
 {
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
     int len = sizeof (socket_addr);
-    int res = recvfrom (connect_socket, (char *)data, size, 0, (sockaddr *)&socket_addr, &len);
+    res = recvfrom (connect_socket, (char *)data, size, 0, (sockaddr *)&socket_addr, &len);
     if (res == SOCKET_ERROR)
     {
-        return -1;
+        res = -1;
     }
+    capture.record (data, res);
     return res;
 }
 
 void BroadCastClient::close ()
 {
+    capture.close ();
     closesocket (connect_socket);
     connect_socket = INVALID_SOCKET;
     WSACleanup ();
@@ -77,7 +84,7 @@ void BroadCastClient::close ()
 #include <netinet/tcp.h>
 
 
-BroadCastClient::BroadCastClient (int port)
+BroadCastClient::BroadCastClient (int port) : capture (PacketTransports::DATAGRAM)
 {
     this->port = port;
     connect_socket = -1;
@@ -114,13 +121,20 @@ int BroadCastClient::init ()
 
 int BroadCastClient::recv (void *data, int size)
 {
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
     socklen_t len = (socklen_t)sizeof (socket_addr);
-    int res = recvfrom (connect_socket, (char *)data, size, 0, (sockaddr *)&socket_addr, &len);
+    res = recvfrom (connect_socket, (char *)data, size, 0, (sockaddr *)&socket_addr, &len);
+    capture.record (data, res);
     return res;
 }
 
 void BroadCastClient::close ()
 {
+    capture.close ();
     ::close (connect_socket);
     connect_socket = -1;
 }
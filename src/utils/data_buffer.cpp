@@ -1,16 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "brainflow_constants.h"
 #include "data_buffer.h"
 
-DataBuffer::DataBuffer (int num_samples, size_t buffer_size)
+// hot ring consists of SPILL_CHUNKS chunks, while one of them is copied to spill file others
+// are available for new packages
+#define SPILL_CHUNKS 4
+// rings bigger than this use huge pages to reduce TLB misses
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define HUGE_PAGE_THRESHOLD (8 * HUGE_PAGE_SIZE)
+// smallest pyramid blocks have 2^MIN_SUMMARY_LEVEL packages
+#define MIN_SUMMARY_LEVEL 4
+// max number of packages copied under one lock hold by long reads
+#define READ_SLICE 4096
+
+
+DataBuffer::DataBuffer (int num_samples, size_t buffer_size, size_t hot_size,
+    const char *spill_file, const int *row_types, const double *row_scales)
 {
     this->buffer_size = buffer_size;
     this->num_samples = num_samples;
-    data = new double[buffer_size * num_samples];
-    first_free = first_used = count = 0;
+    first = total = spilled = 0;
+    num_dropped = 0;
+    spill_fd = -1;
+    spill_data = NULL;
+    spill_size = 0;
+    chunk_size = 0;
+    keep_spilling = false;
+    data = NULL;
+    data_bytes = 0;
+    is_data_mapped = false;
+    summary = NULL;
+    init_layout (row_types, row_scales);
+
+    bool use_spill = (spill_file != NULL) && (spill_file[0] != '\0') && (hot_size > 0) &&
+        (hot_size < buffer_size);
+    if (!use_spill)
+    {
+        this->hot_size = buffer_size;
+        data = allocate_ring (buffer_size);
+        return;
+    }
+    chunk_size = (hot_size + SPILL_CHUNKS - 1) / SPILL_CHUNKS;
+    this->hot_size = chunk_size * SPILL_CHUNKS;
+    // extra hot_size packages in spill file let slow tiered reads finish before spill thread
+    // reaches their pins
+    spill_size = ((buffer_size + this->hot_size + chunk_size - 1) / chunk_size) * chunk_size;
+    if (!open_spill_file (spill_file))
+    {
+        return;
+    }
+    data = allocate_ring (this->hot_size);
+    if (data == NULL)
+    {
+        close_spill_file ();
+        return;
+    }
+    keep_spilling = true;
+    spill_thread = std::thread ([this] { this->spill_worker (); });
 }
 
 DataBuffer::~DataBuffer ()
 {
-    delete[] data;
+    if (spill_thread.joinable ())
+    {
+        {
+            std::lock_guard<std::mutex> guard (spill_mutex);
+            keep_spilling = false;
+        }
+        spill_cv.notify_one ();
+        spill_thread.join ();
+    }
+    close_spill_file ();
+    free_ring ();
+    if (summary != NULL)
+    {
+        delete summary;
+        summary = NULL;
+    }
 }
 
 bool DataBuffer::is_ready ()
@@ -18,73 +94,764 @@ bool DataBuffer::is_ready ()
     return (data != NULL);
 }
 
-void DataBuffer::add_data (double *value)
+bool DataBuffer::enable_summary (size_t max_bytes)
+{
+    if ((summary != NULL) || (total > 0))
+    {
+        return false;
+    }
+    // rows stored in doubles keep double stats, so timestamps are not rounded
+    std::vector<int> summary_float_rows (float_rows);
+    summary_float_rows.insert (summary_float_rows.end (), int_rows.begin (), int_rows.end ());
+    // levels above base one take as much memory as base level together
+    size_t block_bytes =
+        SummaryPyramid::get_block_bytes ((int)num_samples, summary_float_rows.size ());
+    int base_level = MIN_SUMMARY_LEVEL;
+    while (((buffer_size >> base_level) > 1) &&
+        (2 * ((buffer_size >> base_level) + 2) * block_bytes > max_bytes))
+    {
+        base_level++;
+    }
+    summary =
+        new SummaryPyramid ((int)num_samples, buffer_size, base_level, summary_float_rows);
+    return true;
+}
+
+void DataBuffer::init_layout (const int *row_types, const double *row_scales)
+{
+    for (int i = 0; i < (int)num_samples; i++)
+    {
+        int row_type = (row_types == NULL) ? (int)BufferStorageModes::FLOAT64 : row_types[i];
+        if (row_type == (int)BufferStorageModes::FLOAT32)
+        {
+            float_rows.push_back (i);
+        }
+        else if ((row_type == (int)BufferStorageModes::INT32_RAW) && (row_scales != NULL) &&
+            (row_scales[i] != 0))
+        {
+            int_rows.push_back (i);
+            int_scales.push_back (row_scales[i]);
+        }
+        else
+        {
+            double_rows.push_back (i);
+        }
+    }
+    is_packed = (double_rows.size () != num_samples);
+    row_offsets.resize (num_samples);
+    row_storage.resize (num_samples);
+    size_t offset = 0;
+    for (size_t i = 0; i < double_rows.size (); i++, offset += sizeof (double))
+    {
+        row_offsets[double_rows[i]] = is_packed ? offset : double_rows[i] * sizeof (double);
+        row_storage[double_rows[i]] = (int)BufferStorageModes::FLOAT64;
+    }
+    for (size_t i = 0; i < float_rows.size (); i++, offset += sizeof (float))
+    {
+        row_offsets[float_rows[i]] = offset;
+        row_storage[float_rows[i]] = (int)BufferStorageModes::FLOAT32;
+    }
+    for (size_t i = 0; i < int_rows.size (); i++, offset += sizeof (int32_t))
+    {
+        row_offsets[int_rows[i]] = offset;
+        row_storage[int_rows[i]] = (int)BufferStorageModes::INT32_RAW;
+    }
+    package_bytes = offset;
+    // keep doubles aligned in the next package
+    package_bytes = ((package_bytes + sizeof (double) - 1) / sizeof (double)) * sizeof (double);
+}
+
+void DataBuffer::pack (const double *value, char *package)
+{
+    if (!is_packed)
+    {
+        memcpy (package, value, package_bytes);
+        return;
+    }
+    double *doubles = (double *)package;
+    for (size_t i = 0; i < double_rows.size (); i++)
+    {
+        doubles[i] = value[double_rows[i]];
+    }
+    float *floats = (float *)(doubles + double_rows.size ());
+    for (size_t i = 0; i < float_rows.size (); i++)
+    {
+        floats[i] = (float)value[float_rows[i]];
+    }
+    int32_t *counts = (int32_t *)(floats + float_rows.size ());
+    for (size_t i = 0; i < int_rows.size (); i++)
+    {
+        // values from ADC are exact multiples of scale, rounding removes floating point errors
+        double count = value[int_rows[i]] / int_scales[i];
+        if (count != count)
+        {
+            counts[i] = 0;
+        }
+        else if (count >= (double)INT32_MAX)
+        {
+            counts[i] = INT32_MAX;
+        }
+        else if (count <= (double)INT32_MIN)
+        {
+            counts[i] = INT32_MIN;
+        }
+        else
+        {
+            counts[i] = (int32_t)lrint (count);
+        }
+    }
+}
+
+void DataBuffer::unpack (const char *packages, size_t count, double *data_buf)
+{
+    if (!is_packed)
+    {
+        memcpy (data_buf, packages, count * package_bytes);
+        return;
+    }
+    for (size_t j = 0; j < count; j++)
+    {
+        const double *doubles = (const double *)(packages + j * package_bytes);
+        double *value = data_buf + j * num_samples;
+        for (size_t i = 0; i < double_rows.size (); i++)
+        {
+            value[double_rows[i]] = doubles[i];
+        }
+        const float *floats = (const float *)(doubles + double_rows.size ());
+        for (size_t i = 0; i < float_rows.size (); i++)
+        {
+            value[float_rows[i]] = (double)floats[i];
+        }
+        const int32_t *counts = (const int32_t *)(floats + float_rows.size ());
+        for (size_t i = 0; i < int_rows.size (); i++)
+        {
+            value[int_rows[i]] = counts[i] * int_scales[i];
+        }
+    }
+}
+
+char *DataBuffer::allocate_ring (size_t size)
+{
+    data_bytes = size * package_bytes;
+#ifdef _WIN32
+    return new char[data_bytes];
+#else
+    void *addr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    // explicit huge pages are available only if reserved by admin, fallback to regular pages
+    if (data_bytes >= HUGE_PAGE_THRESHOLD)
+    {
+        size_t huge_bytes = ((data_bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+        addr = mmap (NULL, huge_bytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED)
+        {
+            data_bytes = huge_bytes;
+        }
+    }
+#endif
+    if (addr == MAP_FAILED)
+    {
+        // anonymous pages are committed on first touch, so resident memory follows collected data
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+#endif
+        addr = mmap (NULL, data_bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (addr == MAP_FAILED)
+        {
+            return NULL;
+        }
+#ifdef MADV_HUGEPAGE
+        // transparent huge pages, works if THP is enabled in "madvise" or "always" mode
+        if (data_bytes >= HUGE_PAGE_THRESHOLD)
+        {
+            madvise (addr, data_bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    is_data_mapped = true;
+    return (char *)addr;
+#endif
+}
+
+void DataBuffer::free_ring ()
+{
+    if (data == NULL)
+    {
+        return;
+    }
+#ifndef _WIN32
+    if (is_data_mapped)
+    {
+        munmap (data, data_bytes);
+        data = NULL;
+        return;
+    }
+#endif
+    delete[] data;
+    data = NULL;
+}
+
+bool DataBuffer::open_spill_file (const char *path)
+{
+#ifdef _WIN32
+    return false;
+#else
+    int fd = open (path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    size_t bytes = spill_size * package_bytes;
+    // reserve disk space to get an error here instead of SIGBUS in the middle of session
+#ifdef __linux__
+    int res = posix_fallocate (fd, 0, (off_t)bytes);
+    if (res != 0)
+    {
+        res = ftruncate (fd, (off_t)bytes);
+    }
+#else
+    int res = ftruncate (fd, (off_t)bytes);
+#endif
+    void *addr = MAP_FAILED;
+    if (res == 0)
+    {
+        addr = mmap (NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (addr == MAP_FAILED)
+    {
+        close (fd);
+        unlink (path);
+        return false;
+    }
+    spill_fd = fd;
+    spill_data = (char *)addr;
+    spill_file = path;
+    return true;
+#endif
+}
+
+void DataBuffer::close_spill_file ()
+{
+#ifndef _WIN32
+    if (spill_data != NULL)
+    {
+        munmap (spill_data, spill_size * package_bytes);
+        spill_data = NULL;
+    }
+    if (spill_fd >= 0)
+    {
+        close (spill_fd);
+        unlink (spill_file.c_str ());
+        spill_fd = -1;
+    }
+#endif
+}
+
+void DataBuffer::release_spill_pages (char *start, size_t size)
+{
+#ifndef _WIN32
+    // pages of shared mapping stay in page cache and are written back by kernel, unmap them from
+    // the process to keep resident memory constant
+    uintptr_t page_size = (uintptr_t)sysconf (_SC_PAGESIZE);
+    uintptr_t begin = ((uintptr_t)start + page_size - 1) & ~(page_size - 1);
+    uintptr_t end = ((uintptr_t)(start + size * package_bytes)) & ~(page_size - 1);
+    if (end > begin)
+    {
+        madvise ((void *)begin, end - begin, MADV_DONTNEED);
+    }
+#endif
+}
+
+bool DataBuffer::spill_chunk ()
 {
     lock.lock ();
-    memcpy (this->data + first_free * num_samples, value, sizeof (double) * num_samples);
-    first_free = next (first_free);
-    count++;
-    if (first_free == first_used)
+    uint64_t start = spilled;
+    bool is_sealed = (total - spilled >= chunk_size);
+    lock.unlock ();
+    // chunk overwrites packages spill_size older than it in spill ring
+    bool is_pinned =
+        (!read_pins.empty ()) && (start + chunk_size > *read_pins.begin () + spill_size);
+    if ((!is_sealed) || (is_pinned))
+    {
+        return false;
+    }
+    // add_data doesnt overwrite packages above spilled, so chunk can be copied without lock,
+    // both ring sizes are multiples of chunk_size and chunk is contiguous in both of them
+    char *dst = spill_data + (size_t)(start % spill_size) * package_bytes;
+    memcpy (dst, data + (size_t)(start % hot_size) * package_bytes, chunk_size * package_bytes);
+    release_spill_pages (dst, chunk_size);
+    lock.lock ();
+    spilled = start + chunk_size;
+    lock.unlock ();
+    return true;
+}
+
+void DataBuffer::spill_worker ()
+{
+    std::unique_lock<std::mutex> guard (spill_mutex);
+    while (keep_spilling)
+    {
+        while (spill_chunk ())
+        {
+        }
+        // notification can be missed if chunk is sealed right before wait, so use timeout
+        spill_cv.wait_for (guard, std::chrono::milliseconds (100));
+    }
+}
+
+bool DataBuffer::add_data (double *value)
+{
+    lock.lock ();
+    // RAM ring is full of packages which are not spilled yet, spill thread doesnt keep up, spill a
+    // chunk here unless spill_mutex is busy, acquisition never waits for it and drops the package
+    if ((spill_data != NULL) && (total - spilled >= hot_size))
+    {
+        lock.unlock ();
+        if (spill_mutex.try_lock ())
+        {
+            spill_chunk ();
+            spill_mutex.unlock ();
+        }
+        lock.lock ();
+        if (total - spilled >= hot_size)
+        {
+            num_dropped++;
+            lock.unlock ();
+            return false;
+        }
+    }
+    pack (value, data + (size_t)(total % hot_size) * package_bytes);
+    total++;
+    if (total - first > buffer_size)
     {
-        first_used = next (first_used);
-        count--;
+        first = total - buffer_size;
     }
+    bool is_chunk_sealed = (spill_data != NULL) && (total % chunk_size == 0);
     lock.unlock ();
+    if (is_chunk_sealed)
+    {
+        spill_cv.notify_one ();
+    }
+    if (summary != NULL)
+    {
+        std::lock_guard<std::mutex> guard (summary_mutex);
+        summary->add (value);
+    }
+    return true;
+}
+
+void DataBuffer::copy_from_ring (
+    char *ring, size_t ring_size, uint64_t start, size_t size, double *data_buf)
+{
+    size_t pos = (size_t)(start % ring_size);
+    size_t first_half = std::min (size, ring_size - pos);
+    unpack (ring + pos * package_bytes, first_half, data_buf);
+    if (first_half < size)
+    {
+        unpack (ring, size - first_half, data_buf + first_half * num_samples);
+    }
+}
+
+void DataBuffer::get_chunk (uint64_t start, size_t size, double *data_buf)
+{
+    uint64_t end = start + size;
+    if ((spill_data != NULL) && (start < spilled))
+    {
+        size_t spill_count = (size_t)(std::min (end, spilled) - start);
+        copy_from_ring (spill_data, spill_size, start, spill_count, data_buf);
+        // read pages are clean, release them to keep resident memory constant
+        size_t pos = (size_t)(start % spill_size);
+        size_t first_half = std::min (spill_count, spill_size - pos);
+        release_spill_pages (spill_data + pos * package_bytes, first_half);
+        release_spill_pages (spill_data, spill_count - first_half);
+        data_buf += spill_count * num_samples;
+        start += spill_count;
+    }
+    if (start < end)
+    {
+        copy_from_ring (data, hot_size, start, (size_t)(end - start), data_buf);
+    }
 }
 
-void DataBuffer::get_chunk (size_t start, size_t size, double *data_buf)
+double DataBuffer::get_value (uint64_t index, int row)
 {
-    if (start + size < buffer_size)
+    const char *package = NULL;
+    if ((spill_data != NULL) && (index < spilled))
     {
-        memcpy (data_buf, data + start * num_samples, size * sizeof (double) * num_samples);
+        package = spill_data + (size_t)(index % spill_size) * package_bytes;
     }
     else
     {
-        size_t first_half = buffer_size - start;
-        size_t second_half = size - first_half;
-        memcpy (data_buf, data + start * num_samples, first_half * sizeof (double) * num_samples);
-        memcpy (
-            data_buf + first_half * num_samples, data, second_half * sizeof (double) * num_samples);
+        package = data + (size_t)(index % hot_size) * package_bytes;
+    }
+    package += row_offsets[row];
+    if (row_storage[row] == (int)BufferStorageModes::FLOAT32)
+    {
+        return (double)*(const float *)package;
     }
+    if (row_storage[row] == (int)BufferStorageModes::INT32_RAW)
+    {
+        size_t pos = std::find (int_rows.begin (), int_rows.end (), row) - int_rows.begin ();
+        return *(const int32_t *)package * int_scales[pos];
+    }
+    return *(const double *)package;
 }
 
-// removes data from buffer
-size_t DataBuffer::get_data (size_t max_count, double *data_buf)
+// first package in [start, end) with value in row >= value
+uint64_t DataBuffer::lower_bound (int row, uint64_t start, uint64_t end, double value)
 {
+    while (start < end)
+    {
+        uint64_t mid = start + (end - start) / 2;
+        if (get_value (mid, row) < value)
+        {
+            start = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    return start;
+}
+
+size_t DataBuffer::get_data_range (
+    int timestamp_row, double start_time, double end_time, size_t max_count, double *data_buf)
+{
+    if ((timestamp_row < 0) || (timestamp_row >= (int)num_samples))
+    {
+        return 0;
+    }
+    // the same locking as in read_data
+    std::unique_lock<std::mutex> guard (spill_mutex, std::defer_lock);
+    if (spill_data != NULL)
+    {
+        guard.lock ();
+    }
     lock.lock ();
-    size_t result_count = max_count;
-    if (result_count > count)
-        result_count = count;
-    if (result_count)
+    uint64_t range_first = first;
+    uint64_t range_total = total;
+    if (spill_data != NULL)
     {
-        get_chunk (first_used, result_count, data_buf);
-        first_used = (first_used + result_count) % buffer_size;
-        count -= result_count;
+        lock.unlock ();
+    }
+    uint64_t start = lower_bound (timestamp_row, range_first, range_total, start_time);
+    uint64_t end = lower_bound (timestamp_row, start, range_total, end_time);
+    size_t result_count = (size_t)std::min ((uint64_t)max_count, end - start);
+    if ((result_count) && (data_buf != NULL))
+    {
+        copy_locked (guard, start, result_count, data_buf);
+    }
+    if (spill_data == NULL)
+    {
+        lock.unlock ();
     }
-    lock.unlock ();
     return result_count;
 }
 
-// doesn't remove data from buffer
-size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
+void DataBuffer::copy_locked (
+    std::unique_lock<std::mutex> &guard, uint64_t start, size_t size, double *data_buf)
+{
+    if (spill_data == NULL)
+    {
+        get_chunk (start, size, data_buf);
+        return;
+    }
+    // pin is moved after each slice, so spill thread can spill chunks which dont overwrite the
+    // rest of range while spill_mutex is released
+    auto pin = read_pins.insert (start);
+    size_t copied = 0;
+    while (copied < size)
+    {
+        size_t slice = std::min (size - copied, (size_t)READ_SLICE);
+        get_chunk (start + copied, slice, data_buf + copied * num_samples);
+        copied += slice;
+        read_pins.erase (pin);
+        if (copied < size)
+        {
+            pin = read_pins.insert (start + copied);
+            guard.unlock ();
+            spill_cv.notify_one ();
+            guard.lock ();
+        }
+    }
+    spill_cv.notify_one ();
+}
+
+// packages overwritten before their slice is copied are skipped, slice is small enough to not
+// block add_data and spill thread for long
+size_t DataBuffer::copy_range (uint64_t start, size_t size, double *data_buf)
+{
+    uint64_t end = start + size;
+    size_t copied = 0;
+    while (start < end)
+    {
+        std::unique_lock<std::mutex> guard (spill_mutex, std::defer_lock);
+        if (spill_data != NULL)
+        {
+            guard.lock ();
+        }
+        lock.lock ();
+        start = std::max (start, get_oldest ());
+        if (spill_data != NULL)
+        {
+            lock.unlock ();
+        }
+        size_t slice = (start < end) ? (size_t)std::min (end - start, (uint64_t)READ_SLICE) : 0;
+        if (slice)
+        {
+            get_chunk (start, slice, data_buf + copied * num_samples);
+        }
+        if (spill_data == NULL)
+        {
+            lock.unlock ();
+        }
+        start += slice;
+        copied += slice;
+    }
+    return copied;
+}
+
+size_t DataBuffer::add_raw_envelope (uint64_t start, uint64_t end, std::vector<double> &packages,
+    double *min, double *max, double *sum, bool is_empty)
+{
+    size_t num_added = 0;
+    // without summary the whole range is scanned, so packages are copied in slices
+    while (start < end)
+    {
+        size_t count = (size_t)std::min (end - start, (uint64_t)READ_SLICE);
+        packages.resize (count * num_samples);
+        size_t copied = copy_range (start, count, packages.data ());
+        start += count;
+        if ((is_empty) && (copied > 0))
+        {
+            for (size_t i = 0; i < num_samples; i++)
+            {
+                min[i] = max[i] = packages[i];
+                sum[i] = 0.0;
+            }
+            is_empty = false;
+        }
+        num_added += copied;
+        for (size_t j = 0; j < copied; j++)
+        {
+            const double *value = packages.data () + j * num_samples;
+            for (size_t i = 0; i < num_samples; i++)
+            {
+                min[i] = std::min (min[i], value[i]);
+                max[i] = std::max (max[i], value[i]);
+                sum[i] += value[i];
+            }
+        }
+    }
+    return num_added;
+}
+
+size_t DataBuffer::get_data_envelope (int timestamp_row, double start_time, double end_time,
+    size_t num_points, double *min, double *max, double *mean)
+{
+    if ((timestamp_row < 0) || (timestamp_row >= (int)num_samples) || (num_points == 0))
+    {
+        return 0;
+    }
+    // locks are held only for the search, summary and packages are read per point and per slice
+    std::unique_lock<std::mutex> guard (spill_mutex, std::defer_lock);
+    if (spill_data != NULL)
+    {
+        guard.lock ();
+    }
+    lock.lock ();
+    uint64_t range_first = first;
+    uint64_t range_total = total;
+    if (spill_data != NULL)
+    {
+        lock.unlock ();
+    }
+    uint64_t start = lower_bound (timestamp_row, range_first, range_total, start_time);
+    uint64_t end = lower_bound (timestamp_row, start, range_total, end_time);
+    if (spill_data == NULL)
+    {
+        lock.unlock ();
+    }
+    else
+    {
+        guard.unlock ();
+    }
+    size_t result_count = (size_t)std::min ((uint64_t)num_points, end - start);
+
+    std::vector<double> packages;
+    std::vector<double> point (num_samples * SummaryPyramid::NUM_STATS);
+    double *point_min = point.data ();
+    double *point_max = point_min + num_samples;
+    double *point_sum = point_max + num_samples;
+    for (size_t p = 0; p < result_count; p++)
+    {
+        uint64_t point_start = start + (end - start) * p / result_count;
+        uint64_t point_end = start + (end - start) * (p + 1) / result_count;
+        // blocks cover everything except less than a block at each edge and the newest packages
+        uint64_t covered_start = point_end;
+        uint64_t covered_end = point_end;
+        bool is_covered = false;
+        if (summary != NULL)
+        {
+            std::lock_guard<std::mutex> summary_guard (summary_mutex);
+            is_covered = summary->query (point_start, point_end, covered_start, covered_end,
+                point_min, point_max, point_sum);
+        }
+        if (!is_covered)
+        {
+            covered_start = covered_end = point_end;
+        }
+        // raw packages overwritten during the read are skipped, so they are counted
+        size_t num_packages = (size_t)(covered_end - covered_start);
+        num_packages += add_raw_envelope (point_start, covered_start, packages, point_min,
+            point_max, point_sum, num_packages == 0);
+        num_packages += add_raw_envelope (
+            covered_end, point_end, packages, point_min, point_max, point_sum, num_packages == 0);
+        if (num_packages == 0)
+        {
+            for (size_t i = 0; i < num_samples; i++)
+            {
+                point_min[i] = point_max[i] = point_sum[i] = NAN;
+            }
+        }
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            min[i * result_count + p] = point_min[i];
+            max[i * result_count + p] = point_max[i];
+            mean[i * result_count + p] = point_sum[i] / (double)num_packages;
+        }
+    }
+    return result_count;
+}
+
+size_t DataBuffer::read_data (size_t max_count, double *data_buf, bool remove)
 {
+    // RAM only buffer is copied under spinlock, in tiered mode spill_mutex and pins protect both
+    // tiers from overwriting, so copy is done without spinlock and doesnt block add_data
+    std::unique_lock<std::mutex> guard (spill_mutex, std::defer_lock);
+    if (spill_data != NULL)
+    {
+        guard.lock ();
+    }
     lock.lock ();
-    size_t result_count = max_count;
-    if (result_count > count)
-        result_count = count;
+    size_t result_count = (size_t)std::min ((uint64_t)max_count, total - first);
+    uint64_t start = remove ? first : total - result_count;
+    if (remove)
+    {
+        first += result_count;
+    }
+    if (spill_data != NULL)
+    {
+        lock.unlock ();
+    }
     if (result_count)
     {
-        size_t first_return = (first_used + (count - result_count)) % buffer_size;
-        get_chunk (first_return, result_count, data_buf);
+        copy_locked (guard, start, result_count, data_buf);
+    }
+    if (spill_data == NULL)
+    {
+        lock.unlock ();
     }
-    lock.unlock ();
     return result_count;
 }
 
+// oldest package which is not overwritten yet, spill ring is not smaller than buffer_size
+uint64_t DataBuffer::get_oldest ()
+{
+    return (total > buffer_size) ? total - buffer_size : 0;
+}
+
+bool DataBuffer::add_cursor (const std::string &name)
+{
+    lock.lock ();
+    bool is_added = cursors.insert (std::make_pair (name, first)).second;
+    lock.unlock ();
+    return is_added;
+}
+
+bool DataBuffer::remove_cursor (const std::string &name)
+{
+    lock.lock ();
+    bool is_removed = (cursors.erase (name) > 0);
+    lock.unlock ();
+    return is_removed;
+}
+
+bool DataBuffer::get_cursor_data_count (const std::string &name, size_t *count)
+{
+    lock.lock ();
+    auto it = cursors.find (name);
+    if (it != cursors.end ())
+    {
+        *count = (size_t)(total - std::max (it->second, get_oldest ()));
+    }
+    lock.unlock ();
+    return (it != cursors.end ());
+}
+
+bool DataBuffer::get_cursor_data (
+    const std::string &name, size_t max_count, double *data_buf, size_t *count, size_t *lost)
+{
+    // the same locking as in read_data
+    std::unique_lock<std::mutex> guard (spill_mutex, std::defer_lock);
+    if (spill_data != NULL)
+    {
+        guard.lock ();
+    }
+    lock.lock ();
+    auto it = cursors.find (name);
+    if (it == cursors.end ())
+    {
+        lock.unlock ();
+        return false;
+    }
+    uint64_t start = std::max (it->second, get_oldest ());
+    *lost = (size_t)(start - it->second);
+    *count = (size_t)std::min ((uint64_t)max_count, total - start);
+    // map nodes are stable, cursor can be removed only by the same consumer
+    it->second = start + *count;
+    if (spill_data != NULL)
+    {
+        lock.unlock ();
+    }
+    if (*count)
+    {
+        copy_locked (guard, start, *count, data_buf);
+    }
+    if (spill_data == NULL)
+    {
+        lock.unlock ();
+    }
+    return true;
+}
+
+// removes data from buffer
+size_t DataBuffer::get_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, data_buf, true);
+}
+
+// doesn't remove data from buffer
+size_t DataBuffer::get_current_data (size_t max_count, double *data_buf)
+{
+    return read_data (max_count, data_buf, false);
+}
+
+size_t DataBuffer::get_dropped_count ()
+{
+    lock.lock ();
+    size_t result = num_dropped;
+    lock.unlock ();
+    return result;
+}
+
 size_t DataBuffer::get_data_count ()
 {
     lock.lock ();
-    size_t result = this->count;
+    size_t result = (size_t)(total - first);
     lock.unlock ();
     return result;
 }
@@ -85,6 +85,34 @@ enum class DetrendOperations : int
     LINEAR = 2
 };
 
+// bit flags, several artifacts can be detected for the same datapoint
+enum class ArtifactTypes : int
+{
+    NO_ARTIFACT = 0,
+    AMPLITUDE = 1,
+    FLATLINE = 2,
+    VARIANCE = 4,
+    LINE_NOISE = 8
+};
+
+// storage type for values in board buffer, values are converted back to double on read
+enum class BufferStorageModes : int
+{
+    FLOAT64 = 0,
+    FLOAT32 = 1,
+    // raw ADC counts with per channel scale, boards without known scale use FLOAT32 instead
+    INT32_RAW = 2
+};
+
+enum class PacketCaptureModes : int
+{
+    NONE = 0,
+    // raw bytes received by transports are written to files
+    CAPTURE = 1,
+    // transports return bytes from files instead of device
+    REPLAY = 2
+};
+
 enum class BrainFlowMetrics : int
 {
     RELAXATION = 0,
@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "packet_capture.h"
+
 
 enum class BroadCastClientReturnCodes : int
 {
@@ -39,6 +41,11 @@ public:
     {
         return port;
     }
+    // for polling in SocketReactor
+    int get_socket_fd ()
+    {
+        return (int)connect_socket;
+    }
 
 private:
     int port;
@@ -49,4 +56,5 @@ private:
     int connect_socket;
     struct sockaddr_in socket_addr;
 #endif
+    PacketCapture capture;
 };
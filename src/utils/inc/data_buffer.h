@@ -1,34 +1,148 @@
 #pragma once
 
-#include "spinlock.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spinlock.h"
+#include "summary_pyramid.h"
 
+
+// ring buffer for packages, optionally tiered: only the latest packages are kept in RAM, older ones
+// are sealed in chunks and copied to memory mapped spill file by background thread
 class DataBuffer
 {
 
     SpinLock lock;
-    double *data;
+    char *data;
+    size_t data_bytes;
+    bool is_data_mapped;
 
-    size_t buffer_size;
-    size_t first_used, first_free;
-    size_t count;
+    size_t buffer_size; // max number of packages in buffer, including spilled ones
+    size_t hot_size;    // number of packages in RAM ring
     size_t num_samples;
+    // absolute package indices, packages [first, total) are available,
+    // packages below spilled are in spill file, others are in RAM ring
+    uint64_t first;
+    uint64_t total;
+    uint64_t spilled;
+    // packages which add_data couldnt store
+    size_t num_dropped;
 
-    size_t next (size_t index)
-    {
-        return (index + 1) % buffer_size;
-    }
+    // packed package layout: doubles, then floats, then int32 counts, converted to doubles on read
+    bool is_packed;
+    size_t package_bytes;
+    std::vector<int> double_rows;
+    std::vector<int> float_rows;
+    std::vector<int> int_rows;
+    std::vector<double> int_scales;
+    // byte offset and BufferStorageModes type of each row in packed package
+    std::vector<size_t> row_offsets;
+    std::vector<int> row_storage;
 
-    void get_chunk (size_t start, size_t size, double *data_buf);
+    std::string spill_file;
+    int spill_fd;
+    char *spill_data;
+    size_t spill_size; // number of packages in spill file ring, multiple of chunk_size
+    size_t chunk_size;
+    // held while spill file is modified or read, so spilled doesnt change for readers
+    std::mutex spill_mutex;
+    std::condition_variable spill_cv;
+    // next packages of tiered reads in progress, spill_chunk doesnt overwrite them in spill ring,
+    // guarded by spill_mutex
+    std::multiset<uint64_t> read_pins;
+    std::thread spill_thread;
+    bool keep_spilling;
+
+    // name -> absolute index of the next package for this consumer, guarded by spinlock,
+    // independent from first, so get_data doesnt affect cursors
+    std::map<std::string, uint64_t> cursors;
+
+    // optional min/max/mean pyramid over all rows, has its own lock to not extend spinlock
+    SummaryPyramid *summary;
+    std::mutex summary_mutex;
+
+    void init_layout (const int *row_types, const double *row_scales);
+    void pack (const double *value, char *package);
+    void unpack (const char *packages, size_t count, double *data_buf);
+    // reserves address space for RAM ring, pages are committed on first write
+    char *allocate_ring (size_t size);
+    void free_ring ();
+    bool open_spill_file (const char *path);
+    void close_spill_file ();
+    void release_spill_pages (char *start, size_t size);
+    // copies one sealed chunk from RAM to spill file, spill_mutex should be held
+    bool spill_chunk ();
+    void spill_worker ();
+    void copy_from_ring (
+        char *ring, size_t ring_size, uint64_t start, size_t size, double *data_buf);
+    void get_chunk (uint64_t start, size_t size, double *data_buf);
+    // the same locking as for get_chunk is required
+    double get_value (uint64_t index, int row);
+    uint64_t lower_bound (int row, uint64_t start, uint64_t end, double value);
+    size_t read_data (size_t max_count, double *data_buf, bool remove);
+    uint64_t get_oldest ();
+    // copies packages which are available, called with locks of read_data held, in tiered mode
+    // spill_mutex is released between slices
+    void copy_locked (
+        std::unique_lock<std::mutex> &guard, uint64_t start, size_t size, double *data_buf);
+    // copies [start, start + size) in slices taking locks for each of them, skips packages which
+    // were overwritten, returns number of copied packages
+    size_t copy_range (uint64_t start, size_t size, double *data_buf);
+    // adds packages in [start, end) to min, max and sum of each row, initializes them if is_empty,
+    // returns number of added packages
+    size_t add_raw_envelope (uint64_t start, uint64_t end, std::vector<double> &packages,
+        double *min, double *max, double *sum, bool is_empty);
 
 public:
-    DataBuffer (int num_samples, size_t buffer_size);
+    // spill file is used only if hot_size is less than buffer_size, file is removed in destructor
+    // row_types are values from BufferStorageModes for each row, NULL keeps all rows as doubles,
+    // row_scales are used for INT32_RAW rows: value = count * scale
+    DataBuffer (int num_samples, size_t buffer_size, size_t hot_size = 0,
+        const char *spill_file = NULL, const int *row_types = NULL,
+        const double *row_scales = NULL);
     ~DataBuffer ();
 
-    void add_data (double *value);
+    // in RAM only mode waits for spinlock held by reads during their copy, in tiered mode doesnt
+    // wait for readers and drops the package if RAM ring is full and spill file is busy or pinned,
+    // returns false if package is dropped
+    bool add_data (double *value);
+    size_t get_dropped_count ();
+    // reads return all requested packages which are available when the read starts, tiered buffer
+    // keeps them in place with pins and doesnt block add_data while they are copied
     size_t get_data (size_t max_count, double *data_buf);
     size_t get_current_data (size_t max_count, double *data_buf);
     size_t get_data_count ();
+    // doesnt remove data, returns packages with timestamp in [start_time, end_time), timestamps
+    // should be non decreasing, if data_buf is NULL only returns number of such packages
+    size_t get_data_range (int timestamp_row, double start_time, double end_time,
+        size_t max_count, double *data_buf);
+    // min, max and mean per row for num_points equal parts of [start_time, end_time), returns
+    // number of points which is less than num_points if there are fewer packages, output is row
+    // major with this number of columns, without summary all packages are scanned
+    size_t get_data_envelope (int timestamp_row, double start_time, double end_time,
+        size_t num_points, double *min, double *max, double *mean);
+    // new cursor starts from the oldest available package, returns false if name is used
+    bool add_cursor (const std::string &name);
+    bool remove_cursor (const std::string &name);
+    // packages after the last read of this cursor, packages which were overwritten before they
+    // were read are skipped and their number is returned in lost, returns false for unknown name
+    bool get_cursor_data (const std::string &name, size_t max_count, double *data_buf,
+        size_t *count, size_t *lost);
+    bool get_cursor_data_count (const std::string &name, size_t *count);
+    // should be called before the first add_data, base level is selected to fit into max_bytes
+    bool enable_summary (size_t max_bytes);
     bool is_ready ();
+    // bytes per package in storage
+    size_t get_package_bytes ()
+    {
+        return package_bytes;
+    }
 };
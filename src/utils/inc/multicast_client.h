@@ -35,6 +35,11 @@ public:
     int init ();
     int recv (void *data, int size);
     void close ();
+    // for polling in SocketReactor
+    int get_socket_fd ()
+    {
+        return (int)client_socket;
+    }
 
 
 private:
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+// stores stateful objects created via C API and maps them to integer ids for bindings
+template <typename T> class ObjectRegistry
+{
+    std::mutex lock;
+    std::map<int, std::shared_ptr<T>> objects;
+    int next_id;
+
+public:
+    ObjectRegistry ()
+    {
+        next_id = 0;
+    }
+
+    int add (std::shared_ptr<T> object)
+    {
+        std::lock_guard<std::mutex> guard (lock);
+        int id = next_id++;
+        objects[id] = object;
+        return id;
+    }
+
+    // returned pointer keeps object alive even if it gets released from another thread
+    std::shared_ptr<T> get (int id)
+    {
+        std::lock_guard<std::mutex> guard (lock);
+        auto it = objects.find (id);
+        if (it == objects.end ())
+        {
+            return NULL;
+        }
+        return it->second;
+    }
+
+    bool remove (int id)
+    {
+        std::lock_guard<std::mutex> guard (lock);
+        return objects.erase (id) > 0;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "brainflow_constants.h"
+
+
+enum class PacketCaptureReturnCodes : int
+{
+    STATUS_OK = 0,
+    INVALID_ARGUMENT_ERROR = 1,
+    OPEN_FILE_ERROR = 2,
+    INVALID_FILE_ERROR = 3
+};
+
+enum class PacketTransports : int
+{
+    // serial ports, reads may return any part of the stream
+    STREAM = 0,
+    // udp sockets, each read returns one message
+    DATAGRAM = 1
+};
+
+
+// capture file: 16 bytes header, then records with receive timestamp, result of read call and
+// received bytes, failed and empty reads are recorded too to replay timeouts
+struct PacketCaptureHeader
+{
+    char magic[8]; // "BFCAP"
+    uint32_t version;
+    uint32_t transport; // PacketTransports
+};
+
+struct PacketRecordHeader
+{
+    double timestamp;
+    int32_t result;
+    uint32_t size;
+};
+
+
+// raw bytes received by a transport are written to a capture file or read from it instead of the
+// device depending on global mode, each transport uses its own file: the first one opened after
+// set_mode uses file, next ones use file.1, file.2 and so on, sends are not recorded and in replay
+// mode they are dropped
+class PacketCapture
+{
+public:
+    // applied to transports created after this call, mode is one of PacketCaptureModes, rate is
+    // replay speed relative to recorded timestamps, 0 means as fast as possible
+    static int set_mode (int mode, const std::string &file, double rate);
+    static int get_mode ();
+
+    PacketCapture (PacketTransports transport);
+    ~PacketCapture ()
+    {
+        close ();
+    }
+
+    PacketCapture (const PacketCapture &) = delete;
+    PacketCapture &operator= (const PacketCapture &) = delete;
+
+    // mode is taken when transport is created, open is called on the first read if needed
+    bool is_replay () const
+    {
+        return (mode == (int)PacketCaptureModes::REPLAY);
+    }
+    bool is_enabled () const
+    {
+        return (mode != (int)PacketCaptureModes::NONE);
+    }
+    int open ();
+    void close ();
+    // true if data was taken from replay file, res is the recorded result of read call
+    bool replay (void *data, int size, int &res);
+    void record (const void *data, int res);
+
+private:
+    static std::mutex settings_mutex;
+    static int global_mode;
+    static std::string global_file;
+    static double global_rate;
+    static int num_files;
+
+    PacketTransports transport;
+    int mode;
+    double rate;
+    bool is_opened;
+    bool open_failed;
+    // capture
+    FILE *fp;
+    PacketRecordHeader pending_header;
+    std::vector<char> pending_data;
+    // replay, whole file is loaded to replay at memory speed
+    std::vector<char> replay_data;
+    size_t replay_pos;
+    // bytes of the current record already returned by partial stream reads
+    uint32_t replay_consumed;
+    bool replay_started;
+    double first_timestamp;
+    std::chrono::steady_clock::time_point replay_start;
+
+    int open_capture (const std::string &file);
+    int open_replay (const std::string &file);
+    void flush_pending ();
+    // false at the end of file
+    bool get_record (PacketRecordHeader &header);
+    void next_record (const PacketRecordHeader &header);
+    void wait_for (const PacketRecordHeader &header);
+    int replay_stream (char *data, int size);
+    int replay_datagram (char *data, int size);
+};
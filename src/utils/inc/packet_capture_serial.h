@@ -0,0 +1,38 @@
+#pragma once
+
+#include "packet_capture.h"
+#include "serial.h"
+
+
+// records bytes read from serial port or replays them without opening the port, port settings
+// are ignored in replay mode
+class PacketCaptureSerial : public Serial
+{
+
+public:
+    // takes ownership of serial
+    PacketCaptureSerial (Serial *serial);
+    virtual ~PacketCaptureSerial ()
+    {
+        close_serial_port ();
+        delete serial;
+    }
+
+    int open_serial_port ();
+    bool is_port_open ();
+    int set_serial_port_settings (int ms_timeout = 1000, bool timeout_only = false);
+    int set_custom_baudrate (int baudrate);
+    int flush_buffer ();
+    int read_from_serial_port (void *bytes_to_read, int size);
+    int send_to_serial_port (const void *message, int length);
+    int close_serial_port ();
+    const char *get_port_name ()
+    {
+        return serial->get_port_name ();
+    }
+
+private:
+    Serial *serial;
+    PacketCapture capture;
+    bool replay_port_open;
+};
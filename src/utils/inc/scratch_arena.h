@@ -0,0 +1,211 @@
+#pragma once
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <type_traits>
+#include <vector>
+
+
+// per thread bump allocator for temporary buffers, memory is kept between calls and after the first
+// call everything is merged into a single block, so repeated calls of the same size dont touch heap,
+// should be used only via ScratchScope
+class ScratchArena
+{
+public:
+    static const size_t ALIGNMENT = 64;
+    static const size_t MIN_BLOCK_SIZE = 64 * 1024;
+    // bigger arena is freed when the outermost scope ends
+    static const size_t MAX_RETAINED_SIZE = 64 * 1024 * 1024;
+
+    struct Mark
+    {
+        size_t block;
+        size_t offset;
+    };
+
+    static ScratchArena &get_thread_arena ()
+    {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    ScratchArena ()
+    {
+        current = 0;
+        offset = 0;
+        total_size = 0;
+    }
+
+    ~ScratchArena ()
+    {
+        release_blocks ();
+    }
+
+    ScratchArena (const ScratchArena &) = delete;
+    ScratchArena &operator= (const ScratchArena &) = delete;
+
+    // throws std::bad_alloc like new[]
+    void *allocate (size_t bytes)
+    {
+        bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        while (current < blocks.size ())
+        {
+            if (offset + bytes <= blocks[current].size)
+            {
+                void *ptr = blocks[current].data + offset;
+                offset += bytes;
+                return ptr;
+            }
+            current++;
+            offset = 0;
+        }
+        // grow geometrically to need only a few blocks before they are merged
+        size_t size = total_size;
+        if (size < MIN_BLOCK_SIZE)
+        {
+            size = MIN_BLOCK_SIZE;
+        }
+        if (size < bytes)
+        {
+            size = bytes;
+        }
+        add_block (size);
+        current = blocks.size () - 1;
+        offset = bytes;
+        return blocks[current].data;
+    }
+
+    Mark get_mark () const
+    {
+        Mark mark;
+        mark.block = current;
+        mark.offset = offset;
+        return mark;
+    }
+
+    void rewind (const Mark &mark)
+    {
+        current = mark.block;
+        offset = mark.offset;
+        if ((current == 0) && (offset == 0) &&
+            ((blocks.size () > 1) || (total_size > MAX_RETAINED_SIZE)))
+        {
+            size_t size = total_size;
+            release_blocks ();
+            if (size <= MAX_RETAINED_SIZE)
+            {
+                add_block (size);
+            }
+        }
+    }
+
+private:
+    struct Block
+    {
+        void *raw;
+        char *data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current;
+    size_t offset;
+    size_t total_size;
+
+    void add_block (size_t size)
+    {
+        Block block;
+        block.raw = malloc (size + ALIGNMENT);
+        if (block.raw == NULL)
+        {
+            throw std::bad_alloc ();
+        }
+        uintptr_t address = ((uintptr_t)block.raw + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1);
+        block.data = (char *)address;
+        block.size = size;
+        blocks.push_back (block);
+        total_size += size;
+    }
+
+    void release_blocks ()
+    {
+        for (size_t i = 0; i < blocks.size (); i++)
+        {
+            free (blocks[i].raw);
+        }
+        blocks.clear ();
+        total_size = 0;
+    }
+};
+
+
+// everything allocated from the scope is released when it is destroyed, scopes can be nested but
+// should be destroyed in reverse order, so use them only as local variables
+class ScratchScope
+{
+public:
+    ScratchScope () : arena (ScratchArena::get_thread_arena ())
+    {
+        mark = arena.get_mark ();
+        objects = NULL;
+    }
+
+    ~ScratchScope ()
+    {
+        while (objects != NULL)
+        {
+            objects->destroy (objects->ptr);
+            objects = objects->next;
+        }
+        arena.rewind (mark);
+    }
+
+    ScratchScope (const ScratchScope &) = delete;
+    ScratchScope &operator= (const ScratchScope &) = delete;
+
+    // array of count elements, arithmetic types are not initialized like with new[]
+    template <typename T> T *alloc (size_t count)
+    {
+        static_assert (std::is_trivially_destructible<T>::value, "use create for such types");
+        T *ptr = static_cast<T *> (arena.allocate (sizeof (T) * count));
+        if (!std::is_arithmetic<T>::value)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                new (ptr + i) T ();
+            }
+        }
+        return ptr;
+    }
+
+    // object which is destroyed with the scope
+    template <typename T> T *create ()
+    {
+        Object *object = static_cast<Object *> (arena.allocate (sizeof (Object)));
+        T *ptr = new (arena.allocate (sizeof (T))) T ();
+        object->ptr = ptr;
+        object->destroy = &destroy_object<T>;
+        object->next = objects;
+        objects = object;
+        return ptr;
+    }
+
+private:
+    struct Object
+    {
+        void *ptr;
+        void (*destroy) (void *ptr);
+        Object *next;
+    };
+
+    ScratchArena &arena;
+    ScratchArena::Mark mark;
+    Object *objects;
+
+    template <typename T> static void destroy_object (void *ptr)
+    {
+        static_cast<T *> (ptr)->~T ();
+    }
+};
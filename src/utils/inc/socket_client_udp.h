@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "packet_capture.h"
+
 
 enum class SocketClientUDPReturnCodes : int
 {
@@ -51,6 +53,11 @@ public:
         return port;
     }
     int get_local_port ();
+    // for polling in SocketReactor
+    int get_socket_fd ()
+    {
+        return (int)connect_socket;
+    }
 
 private:
     char ip_addr[32];
@@ -62,4 +69,5 @@ private:
     int connect_socket;
     struct sockaddr_in socket_addr;
 #endif
+    PacketCapture capture;
 };
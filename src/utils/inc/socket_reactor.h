@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+
+enum class SocketReactorReturnCodes : int
+{
+    STATUS_OK = 0,
+    NOT_SUPPORTED_ERROR = 1,
+    CREATE_ERROR = 2,
+    SOCKETS_REGISTERED_ERROR = 3,
+    INVALID_ARGUMENT_ERROR = 4
+};
+
+
+// multiplexes sockets of many sessions on few threads, handler is called when its socket is
+// readable and should read one message, readiness is level triggered so the rest of data is
+// handled after one message from each other ready socket, epoll based and linux only
+class SocketReactor
+{
+
+public:
+    // 0 threads disables shared reactor, fails if there are registered sockets
+    static int set_num_threads (int num_threads);
+    // NULL if shared reactor is disabled or not supported
+    static SocketReactor *get_instance ();
+
+    int add_socket (int fd, std::function<void ()> handler);
+    // after return handler is not running and will not be called again
+    void remove_socket (int fd);
+
+private:
+    struct Handler
+    {
+        int fd;
+        std::function<void ()> callback;
+    };
+
+    struct Worker
+    {
+        int epoll_fd;
+        int wake_fd;
+        std::thread thread;
+        // registration id -> handler, ids are not reused unlike fds, so event for removed socket
+        // is never delivered to the new socket with the same fd
+        std::map<uint64_t, Handler> handlers;
+        uint64_t running_id;
+    };
+
+    static std::mutex instance_mutex;
+    static SocketReactor *instance;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Worker *> workers;
+    volatile bool keep_alive;
+    uint64_t next_id; // 0 is used for wake_fd
+
+    SocketReactor ();
+    ~SocketReactor ();
+
+    int start (int num_threads);
+    void stop ();
+    void run (Worker *worker);
+    size_t get_num_sockets ();
+};
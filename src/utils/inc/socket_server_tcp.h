@@ -38,6 +38,11 @@ public:
     int recv (void *data, int size);
     void close ();
     void accept_worker ();
+    // for polling in SocketReactor
+    int get_socket_fd ()
+    {
+        return (int)connected_socket;
+    }
 
     volatile bool client_connected; // idea - stop accept blocking call by calling close in
                                     // another thread
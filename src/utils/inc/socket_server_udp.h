@@ -10,6 +10,8 @@
 
 #include <string.h>
 
+#include "packet_capture.h"
+
 enum class SocketServerUDPReturnCodes
 {
     STATUS_OK = 0,
@@ -31,6 +33,11 @@ public:
     int bind ();
     int recv (void *data, int size);
     void close ();
+    // for polling in SocketReactor
+    int get_socket_fd ()
+    {
+        return (int)server_socket;
+    }
 
 private:
     int local_port;
@@ -41,4 +48,5 @@ private:
 #else
     int server_socket;
 #endif
+    PacketCapture capture;
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+
+
+// min/max/mean of blocks with 2^level packages for levels from base_level to top level, built
+// incrementally as packages arrive, each level is a ring which covers the last capacity packages
+// stats of float_rows are stored as floats, other rows (timestamps, markers) are kept in doubles
+class SummaryPyramid
+{
+public:
+    // values per block and row: min, max, mean
+    static const int NUM_STATS = 3;
+
+    SummaryPyramid (int num_rows, size_t capacity, int base_level,
+        const std::vector<int> &float_rows = std::vector<int> ());
+
+    // memory per block of one level
+    static size_t get_block_bytes (int num_rows, size_t num_float_rows)
+    {
+        return (num_float_rows * sizeof (float) + (num_rows - num_float_rows) * sizeof (double)) *
+            NUM_STATS;
+    }
+
+    void add (const double *package);
+
+    // aggregates complete blocks inside [start, end) for each row, packages at the edges which are
+    // not aligned to base level blocks and the newest ones are not included, returns range covered
+    // by blocks in covered_start and covered_end, false if there are no such blocks
+    bool query (uint64_t start, uint64_t end, uint64_t &covered_start, uint64_t &covered_end,
+        double *min, double *max, double *sum);
+
+    // splits [start, end) into O(log) biggest aligned blocks as (level, block index) pairs, both
+    // ends should be multiples of base level block size
+    static void split_range (uint64_t start, uint64_t end, int base_level, int top_level,
+        std::vector<std::pair<int, uint64_t>> &blocks);
+
+    int get_num_rows () const
+    {
+        return num_rows;
+    }
+
+    int get_base_level () const
+    {
+        return base_level;
+    }
+
+    int get_top_level () const
+    {
+        return top_level;
+    }
+
+    uint64_t get_total () const
+    {
+        return total;
+    }
+
+    // writes num_rows * NUM_STATS values of block k at level, block should be available
+    void get_block (int level, uint64_t k, double *stats) const;
+
+private:
+    int num_rows;
+    int base_level;
+    int top_level;
+    uint64_t total;
+
+    std::vector<int> float_rows;
+    std::vector<int> double_rows;
+    // rings of each level, block has NUM_STATS values for each row of the group
+    std::vector<std::vector<float>> float_levels;
+    std::vector<std::vector<double>> double_levels;
+    std::vector<size_t> ring_sizes;
+    // current incomplete block of base level
+    std::vector<double> acc_min;
+    std::vector<double> acc_max;
+    std::vector<double> acc_sum;
+    std::vector<std::pair<int, uint64_t>> query_blocks;
+
+    float *get_float_block (int level, uint64_t k);
+    double *get_double_block (int level, uint64_t k);
+    bool is_available (int level, uint64_t k) const;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+enum class ThreadPolicies : int
+{
+    // keep policy and priority of the parent thread
+    DEFAULT = -1,
+    OTHER = 0,
+    FIFO = 1,
+    RR = 2
+};
+
+
+// scheduling, affinity and name of the thread, unset fields keep values inherited from the parent
+// thread, settings are applied to the calling thread, linux only except name
+class ThreadSettings
+{
+public:
+    // empty means all cpus
+    std::vector<int> cpus;
+    int policy; // one of ThreadPolicies
+    // realtime priority for FIFO and RR
+    int priority;
+    bool set_nice;
+    int nice;
+    // up to 15 chars
+    std::string name;
+    // os thread id, filled by get_current
+    long thread_id;
+
+    ThreadSettings ()
+    {
+        policy = (int)ThreadPolicies::DEFAULT;
+        priority = 0;
+        set_nice = false;
+        nice = 0;
+        thread_id = -1;
+    }
+
+    // true if there is anything except name to apply
+    bool is_custom () const;
+    // empty string if settings are valid
+    std::string validate () const;
+    // applies settings to the calling thread, failed steps are described in errors and others are
+    // still applied, realtime policies usually need CAP_SYS_NICE or rtprio limit
+    void apply (std::vector<std::string> &errors) const;
+    // actual settings of the calling thread
+    static ThreadSettings get_current ();
+
+    static const char *policy_to_string (int policy);
+    // DEFAULT for unknown string
+    static int policy_from_string (const std::string &policy);
+};
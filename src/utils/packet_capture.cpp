@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <string.h>
+#include <thread>
+
+#include "packet_capture.h"
+#include "timestamp.h"
+
+#define PACKET_CAPTURE_MAGIC "BFCAP"
+#define PACKET_CAPTURE_VERSION 1
+// stream reads arriving within this interval are merged into one record
+#define MERGE_INTERVAL 0.001
+#define MAX_MERGED_SIZE 4096
+// at the end of replay file reads behave like timeouts but dont spin
+#define END_OF_REPLAY_SLEEP_MS 10
+
+static_assert (sizeof (PacketCaptureHeader) == 16, "capture header must be 16 bytes");
+static_assert (sizeof (PacketRecordHeader) == 16, "record header must be 16 bytes");
+
+
+std::mutex PacketCapture::settings_mutex;
+int PacketCapture::global_mode = (int)PacketCaptureModes::NONE;
+std::string PacketCapture::global_file = "";
+double PacketCapture::global_rate = 0.0;
+int PacketCapture::num_files = 0;
+
+int PacketCapture::set_mode (int mode, const std::string &file, double rate)
+{
+    if ((mode < (int)PacketCaptureModes::NONE) || (mode > (int)PacketCaptureModes::REPLAY) ||
+        (rate < 0.0) || ((mode != (int)PacketCaptureModes::NONE) && (file.empty ())))
+    {
+        return (int)PacketCaptureReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    std::lock_guard<std::mutex> lock (settings_mutex);
+    global_mode = mode;
+    global_file = file;
+    global_rate = rate;
+    num_files = 0;
+    return (int)PacketCaptureReturnCodes::STATUS_OK;
+}
+
+int PacketCapture::get_mode ()
+{
+    std::lock_guard<std::mutex> lock (settings_mutex);
+    return global_mode;
+}
+
+PacketCapture::PacketCapture (PacketTransports transport)
+{
+    std::lock_guard<std::mutex> lock (settings_mutex);
+    this->transport = transport;
+    mode = global_mode;
+    rate = global_rate;
+    is_opened = false;
+    open_failed = false;
+    fp = NULL;
+    memset (&pending_header, 0, sizeof (pending_header));
+    replay_pos = 0;
+    replay_consumed = 0;
+    replay_started = false;
+    first_timestamp = 0.0;
+}
+
+int PacketCapture::open ()
+{
+    if ((!is_enabled ()) || (is_opened))
+    {
+        return (int)PacketCaptureReturnCodes::STATUS_OK;
+    }
+    if (open_failed)
+    {
+        return (int)PacketCaptureReturnCodes::OPEN_FILE_ERROR;
+    }
+    std::string file;
+    {
+        std::lock_guard<std::mutex> lock (settings_mutex);
+        file = global_file;
+        if (num_files > 0)
+        {
+            file += "." + std::to_string (num_files);
+        }
+        num_files++;
+    }
+    int res = (is_replay ()) ? open_replay (file) : open_capture (file);
+    if (res != (int)PacketCaptureReturnCodes::STATUS_OK)
+    {
+        open_failed = true;
+        return res;
+    }
+    is_opened = true;
+    return res;
+}
+
+int PacketCapture::open_capture (const std::string &file)
+{
+    fp = fopen (file.c_str (), "wb");
+    if (fp == NULL)
+    {
+        return (int)PacketCaptureReturnCodes::OPEN_FILE_ERROR;
+    }
+    PacketCaptureHeader header;
+    memset (&header, 0, sizeof (header));
+    strcpy (header.magic, PACKET_CAPTURE_MAGIC);
+    header.version = PACKET_CAPTURE_VERSION;
+    header.transport = (uint32_t)transport;
+    if (fwrite (&header, sizeof (header), 1, fp) != 1)
+    {
+        fclose (fp);
+        fp = NULL;
+        return (int)PacketCaptureReturnCodes::OPEN_FILE_ERROR;
+    }
+    pending_data.clear ();
+    pending_header.size = 0;
+    return (int)PacketCaptureReturnCodes::STATUS_OK;
+}
+
+int PacketCapture::open_replay (const std::string &file)
+{
+    FILE *replay_fp = fopen (file.c_str (), "rb");
+    if (replay_fp == NULL)
+    {
+        return (int)PacketCaptureReturnCodes::OPEN_FILE_ERROR;
+    }
+    fseek (replay_fp, 0, SEEK_END);
+    long file_size = ftell (replay_fp);
+    fseek (replay_fp, 0, SEEK_SET);
+    if (file_size < (long)sizeof (PacketCaptureHeader))
+    {
+        fclose (replay_fp);
+        return (int)PacketCaptureReturnCodes::INVALID_FILE_ERROR;
+    }
+    replay_data.resize ((size_t)file_size);
+    size_t read_size = fread (replay_data.data (), 1, replay_data.size (), replay_fp);
+    fclose (replay_fp);
+    PacketCaptureHeader header;
+    memcpy (&header, replay_data.data (), sizeof (header));
+    if ((read_size != replay_data.size ()) ||
+        (memcmp (header.magic, PACKET_CAPTURE_MAGIC, sizeof (PACKET_CAPTURE_MAGIC)) != 0) ||
+        (header.version != PACKET_CAPTURE_VERSION) || (header.transport != (uint32_t)transport))
+    {
+        std::vector<char> ().swap (replay_data);
+        return (int)PacketCaptureReturnCodes::INVALID_FILE_ERROR;
+    }
+    replay_pos = sizeof (PacketCaptureHeader);
+    replay_consumed = 0;
+    replay_started = false;
+    return (int)PacketCaptureReturnCodes::STATUS_OK;
+}
+
+void PacketCapture::close ()
+{
+    if (fp != NULL)
+    {
+        flush_pending ();
+        fclose (fp);
+        fp = NULL;
+    }
+    std::vector<char> ().swap (replay_data);
+    is_opened = false;
+}
+
+void PacketCapture::record (const void *data, int res)
+{
+    if ((mode != (int)PacketCaptureModes::CAPTURE) ||
+        (open () != (int)PacketCaptureReturnCodes::STATUS_OK))
+    {
+        return;
+    }
+    double timestamp = get_timestamp ();
+    uint32_t size = (res > 0) ? (uint32_t)res : 0;
+    // partial reads of a stream are merged to keep file small for byte by byte readers
+    bool merge = (transport == PacketTransports::STREAM) && (res > 0) &&
+        (pending_header.size > 0) && (pending_header.size + size <= MAX_MERGED_SIZE) &&
+        (timestamp - pending_header.timestamp < MERGE_INTERVAL);
+    if (!merge)
+    {
+        flush_pending ();
+        pending_header.timestamp = timestamp;
+        pending_header.result = res;
+        pending_header.size = 0;
+    }
+    else
+    {
+        pending_header.result += res;
+    }
+    pending_data.insert (pending_data.end (), (const char *)data, (const char *)data + size);
+    pending_header.size += size;
+    if (transport == PacketTransports::DATAGRAM)
+    {
+        flush_pending ();
+    }
+}
+
+void PacketCapture::flush_pending ()
+{
+    if ((pending_header.size == 0) && (pending_header.timestamp == 0.0))
+    {
+        return;
+    }
+    fwrite (&pending_header, sizeof (pending_header), 1, fp);
+    if (!pending_data.empty ())
+    {
+        fwrite (pending_data.data (), 1, pending_data.size (), fp);
+    }
+    memset (&pending_header, 0, sizeof (pending_header));
+    pending_data.clear ();
+}
+
+bool PacketCapture::replay (void *data, int size, int &res)
+{
+    if (!is_replay ())
+    {
+        return false;
+    }
+    if (open () != (int)PacketCaptureReturnCodes::STATUS_OK)
+    {
+        res = -1;
+        return true;
+    }
+    if (transport == PacketTransports::STREAM)
+    {
+        res = replay_stream ((char *)data, size);
+    }
+    else
+    {
+        res = replay_datagram ((char *)data, size);
+    }
+    return true;
+}
+
+bool PacketCapture::get_record (PacketRecordHeader &header)
+{
+    if (replay_pos + sizeof (header) > replay_data.size ())
+    {
+        return false;
+    }
+    memcpy (&header, replay_data.data () + replay_pos, sizeof (header));
+    // truncated record is treated as the end of file
+    return (replay_pos + sizeof (header) + header.size <= replay_data.size ());
+}
+
+void PacketCapture::next_record (const PacketRecordHeader &header)
+{
+    replay_pos += sizeof (header) + header.size;
+    replay_consumed = 0;
+}
+
+void PacketCapture::wait_for (const PacketRecordHeader &header)
+{
+    if (!replay_started)
+    {
+        replay_started = true;
+        first_timestamp = header.timestamp;
+        replay_start = std::chrono::steady_clock::now ();
+    }
+    if (rate <= 0.0)
+    {
+        return;
+    }
+    std::chrono::duration<double> offset ((header.timestamp - first_timestamp) / rate);
+    std::this_thread::sleep_until (
+        replay_start + std::chrono::duration_cast<std::chrono::steady_clock::duration> (offset));
+}
+
+int PacketCapture::replay_stream (char *data, int size)
+{
+    int num_read = 0;
+    PacketRecordHeader header;
+    while ((num_read < size) && (get_record (header)))
+    {
+        // timeouts and errors end the read like in real port
+        if (header.result <= 0)
+        {
+            if (num_read > 0)
+            {
+                break;
+            }
+            wait_for (header);
+            next_record (header);
+            return header.result;
+        }
+        if (replay_consumed == 0)
+        {
+            wait_for (header);
+        }
+        int len = std::min ((int)(header.size - replay_consumed), size - num_read);
+        memcpy (data + num_read,
+            replay_data.data () + replay_pos + sizeof (header) + replay_consumed, len);
+        num_read += len;
+        replay_consumed += (uint32_t)len;
+        if (replay_consumed == header.size)
+        {
+            next_record (header);
+        }
+    }
+    if (num_read == 0)
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (END_OF_REPLAY_SLEEP_MS));
+    }
+    return num_read;
+}
+
+int PacketCapture::replay_datagram (char *data, int size)
+{
+    PacketRecordHeader header;
+    if (!get_record (header))
+    {
+        std::this_thread::sleep_for (std::chrono::milliseconds (END_OF_REPLAY_SLEEP_MS));
+        return -1;
+    }
+    wait_for (header);
+    int res = header.result;
+    if (res > 0)
+    {
+        // like recv, the rest of message is dropped
+        res = std::min (res, size);
+        memcpy (data, replay_data.data () + replay_pos + sizeof (header), res);
+    }
+    next_record (header);
+    return res;
+}
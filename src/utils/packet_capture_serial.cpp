@@ -0,0 +1,96 @@
+#include "packet_capture_serial.h"
+
+
+PacketCaptureSerial::PacketCaptureSerial (Serial *serial) : capture (PacketTransports::STREAM)
+{
+    this->serial = serial;
+    replay_port_open = false;
+}
+
+int PacketCaptureSerial::open_serial_port ()
+{
+    if (!capture.is_replay ())
+    {
+        int res = serial->open_serial_port ();
+        if (res != SerialExitCodes::OK)
+        {
+            return res;
+        }
+    }
+    if (capture.open () != (int)PacketCaptureReturnCodes::STATUS_OK)
+    {
+        serial->close_serial_port ();
+        return SerialExitCodes::OPEN_PORT_ERROR;
+    }
+    replay_port_open = capture.is_replay ();
+    return SerialExitCodes::OK;
+}
+
+bool PacketCaptureSerial::is_port_open ()
+{
+    if (capture.is_replay ())
+    {
+        return replay_port_open;
+    }
+    return serial->is_port_open ();
+}
+
+int PacketCaptureSerial::set_serial_port_settings (int ms_timeout, bool timeout_only)
+{
+    if (capture.is_replay ())
+    {
+        return SerialExitCodes::OK;
+    }
+    return serial->set_serial_port_settings (ms_timeout, timeout_only);
+}
+
+int PacketCaptureSerial::set_custom_baudrate (int baudrate)
+{
+    if (capture.is_replay ())
+    {
+        return SerialExitCodes::OK;
+    }
+    return serial->set_custom_baudrate (baudrate);
+}
+
+int PacketCaptureSerial::flush_buffer ()
+{
+    // bytes dropped by flush were not read, so they are not in capture file
+    if (capture.is_replay ())
+    {
+        return SerialExitCodes::OK;
+    }
+    return serial->flush_buffer ();
+}
+
+int PacketCaptureSerial::read_from_serial_port (void *bytes_to_read, int size)
+{
+    int res = 0;
+    if (capture.replay (bytes_to_read, size, res))
+    {
+        return res;
+    }
+    res = serial->read_from_serial_port (bytes_to_read, size);
+    capture.record (bytes_to_read, res);
+    return res;
+}
+
+int PacketCaptureSerial::send_to_serial_port (const void *message, int length)
+{
+    if (capture.is_replay ())
+    {
+        return length;
+    }
+    return serial->send_to_serial_port (message, length);
+}
+
+int PacketCaptureSerial::close_serial_port ()
+{
+    capture.close ();
+    if (capture.is_replay ())
+    {
+        replay_port_open = false;
+        return SerialExitCodes::OK;
+    }
+    return serial->close_serial_port ();
+}
@@ -1,16 +1,26 @@
 #include "serial.h"
 #include "libftdi_serial.h"
 #include "os_serial.h"
+#include "packet_capture_serial.h"
 
 
 Serial *Serial::create (const char *port_name, Board *board)
 {
+    Serial *serial = NULL;
 #ifdef USE_LIBFTDI
     if (LibFTDISerial::is_libftdi (port_name))
     {
-        return new LibFTDISerial (port_name, board);
+        serial = new LibFTDISerial (port_name, board);
     }
 #endif
+    if (serial == NULL)
+    {
+        serial = new OSSerial (port_name);
+    }
 
-    return new OSSerial (port_name);
+    if (PacketCapture::get_mode () != (int)PacketCaptureModes::NONE)
+    {
+        return new PacketCaptureSerial (serial);
+    }
+    return serial;
 }
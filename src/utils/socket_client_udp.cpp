@@ -83,6 +83,7 @@ int SocketClientUDP::get_local_ip_addr (const char *connect_ip, int port, char *
 }
 
 SocketClientUDP::SocketClientUDP (const char *ip_addr, int port)
+    : capture (PacketTransports::DATAGRAM)
 {
     strcpy (this->ip_addr, ip_addr);
     this->port = port;
@@ -189,16 +190,23 @@ int SocketClientUDP::send (const char *data, int size)
 
 int SocketClientUDP::recv (void *data, int size)
 {
-    int res = recvfrom (connect_socket, (char *)data, size, 0, NULL, NULL);
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
+    res = recvfrom (connect_socket, (char *)data, size, 0, NULL, NULL);
     if (res == SOCKET_ERROR)
     {
-        return -1;
+        res = -1;
     }
+    capture.record (data, res);
     return res;
 }
 
 void SocketClientUDP::close ()
 {
+    capture.close ();
     closesocket (connect_socket);
     connect_socket = INVALID_SOCKET;
     WSACleanup ();
@@ -276,6 +284,7 @@ int SocketClientUDP::get_local_ip_addr (const char *connect_ip, int port, char *
 }
 
 SocketClientUDP::SocketClientUDP (const char *ip_addr, int port)
+    : capture (PacketTransports::DATAGRAM)
 {
     strcpy (this->ip_addr, ip_addr);
     this->port = port;
@@ -377,12 +386,19 @@ int SocketClientUDP::send (const char *data, int size)
 
 int SocketClientUDP::recv (void *data, int size)
 {
-    int res = recvfrom (connect_socket, (char *)data, size, 0, NULL, NULL);
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
+    res = recvfrom (connect_socket, (char *)data, size, 0, NULL, NULL);
+    capture.record (data, res);
     return res;
 }
 
 void SocketClientUDP::close ()
 {
+    capture.close ();
     ::close (connect_socket);
     connect_socket = -1;
 }
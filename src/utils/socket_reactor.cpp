@@ -0,0 +1,268 @@
+#include <string>
+
+#include "socket_reactor.h"
+#include "thread_settings.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+// events returned by one epoll_wait, each ready socket gets one handler call per round
+#define MAX_REACTOR_EVENTS 64
+
+
+std::mutex SocketReactor::instance_mutex;
+SocketReactor *SocketReactor::instance = NULL;
+
+int SocketReactor::set_num_threads (int num_threads)
+{
+    if (num_threads < 0)
+    {
+        return (int)SocketReactorReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+#ifndef __linux__
+    return (num_threads == 0) ? (int)SocketReactorReturnCodes::STATUS_OK :
+                                (int)SocketReactorReturnCodes::NOT_SUPPORTED_ERROR;
+#else
+    std::lock_guard<std::mutex> guard (instance_mutex);
+    if (instance != NULL)
+    {
+        if (instance->get_num_sockets () > 0)
+        {
+            return (int)SocketReactorReturnCodes::SOCKETS_REGISTERED_ERROR;
+        }
+        delete instance;
+        instance = NULL;
+    }
+    if (num_threads == 0)
+    {
+        return (int)SocketReactorReturnCodes::STATUS_OK;
+    }
+    SocketReactor *reactor = new SocketReactor ();
+    int res = reactor->start (num_threads);
+    if (res != (int)SocketReactorReturnCodes::STATUS_OK)
+    {
+        delete reactor;
+        return res;
+    }
+    instance = reactor;
+    return (int)SocketReactorReturnCodes::STATUS_OK;
+#endif
+}
+
+SocketReactor *SocketReactor::get_instance ()
+{
+    std::lock_guard<std::mutex> guard (instance_mutex);
+    return instance;
+}
+
+SocketReactor::SocketReactor ()
+{
+    keep_alive = false;
+    next_id = 1;
+}
+
+SocketReactor::~SocketReactor ()
+{
+    stop ();
+}
+
+size_t SocketReactor::get_num_sockets ()
+{
+    std::lock_guard<std::mutex> guard (mutex);
+    size_t num_sockets = 0;
+    for (size_t i = 0; i < workers.size (); i++)
+    {
+        num_sockets += workers[i]->handlers.size ();
+    }
+    return num_sockets;
+}
+
+#ifdef __linux__
+int SocketReactor::start (int num_threads)
+{
+    keep_alive = true;
+    for (int i = 0; i < num_threads; i++)
+    {
+        Worker *worker = new Worker ();
+        worker->running_id = 0;
+        worker->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+        worker->wake_fd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = 0;
+        if ((worker->epoll_fd < 0) || (worker->wake_fd < 0) ||
+            (epoll_ctl (worker->epoll_fd, EPOLL_CTL_ADD, worker->wake_fd, &event) != 0))
+        {
+            if (worker->epoll_fd >= 0)
+            {
+                close (worker->epoll_fd);
+            }
+            if (worker->wake_fd >= 0)
+            {
+                close (worker->wake_fd);
+            }
+            delete worker;
+            return (int)SocketReactorReturnCodes::CREATE_ERROR;
+        }
+        workers.push_back (worker);
+        ThreadSettings settings;
+        settings.name = "bf_reactor_" + std::to_string (i);
+        worker->thread = std::thread ([this, worker, settings] {
+            std::vector<std::string> errors;
+            settings.apply (errors);
+            this->run (worker);
+        });
+    }
+    return (int)SocketReactorReturnCodes::STATUS_OK;
+}
+
+void SocketReactor::stop ()
+{
+    keep_alive = false;
+    for (size_t i = 0; i < workers.size (); i++)
+    {
+        uint64_t value = 1;
+        if (write (workers[i]->wake_fd, &value, sizeof (value)) < 0)
+        {
+            // eventfd counter is already non zero, worker will wake up anyway
+        }
+        workers[i]->thread.join ();
+        close (workers[i]->epoll_fd);
+        close (workers[i]->wake_fd);
+        delete workers[i];
+    }
+    workers.clear ();
+}
+
+int SocketReactor::add_socket (int fd, std::function<void ()> handler)
+{
+    if ((fd < 0) || (!handler))
+    {
+        return (int)SocketReactorReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    std::lock_guard<std::mutex> guard (mutex);
+    // sessions are spread over workers by number of sockets
+    Worker *worker = workers[0];
+    for (size_t i = 1; i < workers.size (); i++)
+    {
+        if (workers[i]->handlers.size () < worker->handlers.size ())
+        {
+            worker = workers[i];
+        }
+    }
+    uint64_t id = next_id++;
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = id;
+    if (epoll_ctl (worker->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        return (int)SocketReactorReturnCodes::INVALID_ARGUMENT_ERROR;
+    }
+    Handler &entry = worker->handlers[id];
+    entry.fd = fd;
+    entry.callback = handler;
+    return (int)SocketReactorReturnCodes::STATUS_OK;
+}
+
+void SocketReactor::remove_socket (int fd)
+{
+    std::unique_lock<std::mutex> lock (mutex);
+    for (size_t i = 0; i < workers.size (); i++)
+    {
+        Worker *worker = workers[i];
+        auto it = worker->handlers.begin ();
+        while ((it != worker->handlers.end ()) && (it->second.fd != fd))
+        {
+            ++it;
+        }
+        if (it == worker->handlers.end ())
+        {
+            continue;
+        }
+        uint64_t id = it->first;
+        worker->handlers.erase (it);
+        epoll_ctl (worker->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+        // handler can remove its own socket, dont wait for itself
+        if (std::this_thread::get_id () != worker->thread.get_id ())
+        {
+            cv.wait (lock, [worker, id] { return worker->running_id != id; });
+        }
+        return;
+    }
+}
+
+void SocketReactor::run (Worker *worker)
+{
+    struct epoll_event events[MAX_REACTOR_EVENTS];
+    while (keep_alive)
+    {
+        int num_events = epoll_wait (worker->epoll_fd, events, MAX_REACTOR_EVENTS, -1);
+        if (num_events < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; (i < num_events) && (keep_alive); i++)
+        {
+            uint64_t id = events[i].data.u64;
+            if (id == 0)
+            {
+                continue;
+            }
+            std::function<void ()> handler;
+            {
+                std::lock_guard<std::mutex> guard (mutex);
+                auto it = worker->handlers.find (id);
+                // socket was removed after epoll_wait
+                if (it == worker->handlers.end ())
+                {
+                    continue;
+                }
+                handler = it->second.callback;
+                worker->running_id = id;
+                // closed connection stays readable forever, handle it once and stop polling
+                if (events[i].events & (EPOLLHUP | EPOLLERR))
+                {
+                    epoll_ctl (worker->epoll_fd, EPOLL_CTL_DEL, it->second.fd, NULL);
+                }
+            }
+            handler ();
+            {
+                std::lock_guard<std::mutex> guard (mutex);
+                worker->running_id = 0;
+            }
+            cv.notify_all ();
+        }
+    }
+}
+#else
+int SocketReactor::start (int num_threads)
+{
+    return (int)SocketReactorReturnCodes::NOT_SUPPORTED_ERROR;
+}
+
+void SocketReactor::stop ()
+{
+}
+
+int SocketReactor::add_socket (int fd, std::function<void ()> handler)
+{
+    return (int)SocketReactorReturnCodes::NOT_SUPPORTED_ERROR;
+}
+
+void SocketReactor::remove_socket (int fd)
+{
+}
+
+void SocketReactor::run (Worker *worker)
+{
+}
+#endif
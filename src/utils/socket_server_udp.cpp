@@ -10,7 +10,7 @@
 #pragma comment(lib, "Mswsock.lib")
 #pragma comment(lib, "AdvApi32.lib")
 
-SocketServerUDP::SocketServerUDP (int local_port)
+SocketServerUDP::SocketServerUDP (int local_port) : capture (PacketTransports::DATAGRAM)
 {
     this->local_port = local_port;
     server_socket = INVALID_SOCKET;
@@ -50,20 +50,26 @@ int SocketServerUDP::bind ()
 
 int SocketServerUDP::recv (void *data, int size)
 {
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
     struct sockaddr_in client_addr;
     memset (&client_addr, 0, sizeof (client_addr));
     socklen_t len = sizeof (client_addr);
-    int res =
-        recvfrom (server_socket, (char *)data, size, 0, (struct sockaddr *)&client_addr, &len);
+    res = recvfrom (server_socket, (char *)data, size, 0, (struct sockaddr *)&client_addr, &len);
     if (res == SOCKET_ERROR)
     {
-        return -1;
+        res = -1;
     }
+    capture.record (data, res);
     return res;
 }
 
 void SocketServerUDP::close ()
 {
+    capture.close ();
     if (server_socket != INVALID_SOCKET)
     {
         closesocket (server_socket);
@@ -81,7 +87,7 @@ void SocketServerUDP::close ()
 #include <netinet/tcp.h>
 
 
-SocketServerUDP::SocketServerUDP (int local_port)
+SocketServerUDP::SocketServerUDP (int local_port) : capture (PacketTransports::DATAGRAM)
 {
     this->local_port = local_port;
     server_socket = -1;
@@ -116,14 +122,22 @@ int SocketServerUDP::bind ()
 
 int SocketServerUDP::recv (void *data, int size)
 {
+    int res = 0;
+    if (capture.replay (data, size, res))
+    {
+        return res;
+    }
     struct sockaddr_in client_addr;
     memset (&client_addr, 0, sizeof (client_addr));
     socklen_t len = (socklen_t)sizeof (client_addr);
-    return recvfrom (server_socket, (char *)data, size, 0, (struct sockaddr *)&client_addr, &len);
+    res = recvfrom (server_socket, (char *)data, size, 0, (struct sockaddr *)&client_addr, &len);
+    capture.record (data, res);
+    return res;
 }
 
 void SocketServerUDP::close ()
 {
+    capture.close ();
     if (server_socket != -1)
     {
         ::close (server_socket);
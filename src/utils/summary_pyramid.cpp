@@ -0,0 +1,226 @@
+#include <algorithm>
+
+#include "summary_pyramid.h"
+
+
+template <typename T>
+static void merge_blocks (const T *left, const T *right, T *parent, size_t len)
+{
+    for (size_t i = 0; i < len; i += SummaryPyramid::NUM_STATS)
+    {
+        parent[i] = std::min (left[i], right[i]);
+        parent[i + 1] = std::max (left[i + 1], right[i + 1]);
+        parent[i + 2] = (T)0.5 * (left[i + 2] + right[i + 2]);
+    }
+}
+
+template <typename T>
+static void add_block (const T *block, const std::vector<int> &rows, double size, bool is_first,
+    double *min, double *max, double *sum)
+{
+    for (size_t r = 0; r < rows.size (); r++)
+    {
+        const T *stats = block + r * SummaryPyramid::NUM_STATS;
+        int i = rows[r];
+        if (is_first)
+        {
+            min[i] = (double)stats[0];
+            max[i] = (double)stats[1];
+            sum[i] = (double)stats[2] * size;
+        }
+        else
+        {
+            min[i] = std::min (min[i], (double)stats[0]);
+            max[i] = std::max (max[i], (double)stats[1]);
+            sum[i] += (double)stats[2] * size;
+        }
+    }
+}
+
+
+SummaryPyramid::SummaryPyramid (
+    int num_rows, size_t capacity, int base_level, const std::vector<int> &float_rows)
+{
+    this->num_rows = num_rows;
+    std::vector<bool> is_float (num_rows, false);
+    for (size_t i = 0; i < float_rows.size (); i++)
+    {
+        is_float[float_rows[i]] = true;
+    }
+    for (int i = 0; i < num_rows; i++)
+    {
+        if (is_float[i])
+        {
+            this->float_rows.push_back (i);
+        }
+        else
+        {
+            double_rows.push_back (i);
+        }
+    }
+    this->base_level = base_level;
+    top_level = base_level;
+    while (((size_t)2 << top_level) <= capacity)
+    {
+        top_level++;
+    }
+    total = 0;
+    for (int level = base_level; level <= top_level; level++)
+    {
+        // extra blocks for the block which is being built and for the partially evicted one
+        size_t ring_size = (capacity >> level) + 2;
+        ring_sizes.push_back (ring_size);
+        float_levels.push_back (
+            std::vector<float> (ring_size * this->float_rows.size () * NUM_STATS, 0.0f));
+        double_levels.push_back (
+            std::vector<double> (ring_size * double_rows.size () * NUM_STATS, 0.0));
+    }
+    acc_min.resize (num_rows, 0.0);
+    acc_max.resize (num_rows, 0.0);
+    acc_sum.resize (num_rows, 0.0);
+}
+
+void SummaryPyramid::split_range (uint64_t start, uint64_t end, int base_level, int top_level,
+    std::vector<std::pair<int, uint64_t>> &blocks)
+{
+    blocks.clear ();
+    while (start < end)
+    {
+        int level = base_level;
+        while ((level < top_level) && ((start & (((uint64_t)2 << level) - 1)) == 0) &&
+            (start + ((uint64_t)2 << level) <= end))
+        {
+            level++;
+        }
+        blocks.push_back (std::make_pair (level, start >> level));
+        start += (uint64_t)1 << level;
+    }
+}
+
+float *SummaryPyramid::get_float_block (int level, uint64_t k)
+{
+    int pos = level - base_level;
+    return float_levels[pos].data () +
+        (size_t)(k % ring_sizes[pos]) * float_rows.size () * NUM_STATS;
+}
+
+double *SummaryPyramid::get_double_block (int level, uint64_t k)
+{
+    int pos = level - base_level;
+    return double_levels[pos].data () +
+        (size_t)(k % ring_sizes[pos]) * double_rows.size () * NUM_STATS;
+}
+
+void SummaryPyramid::get_block (int level, uint64_t k, double *stats) const
+{
+    int pos = level - base_level;
+    size_t slot = (size_t)(k % ring_sizes[pos]);
+    const float *float_block = float_levels[pos].data () + slot * float_rows.size () * NUM_STATS;
+    const double *double_block =
+        double_levels[pos].data () + slot * double_rows.size () * NUM_STATS;
+    for (size_t r = 0; r < float_rows.size (); r++)
+    {
+        for (int j = 0; j < NUM_STATS; j++)
+        {
+            stats[float_rows[r] * NUM_STATS + j] = (double)float_block[r * NUM_STATS + j];
+        }
+    }
+    for (size_t r = 0; r < double_rows.size (); r++)
+    {
+        for (int j = 0; j < NUM_STATS; j++)
+        {
+            stats[double_rows[r] * NUM_STATS + j] = double_block[r * NUM_STATS + j];
+        }
+    }
+}
+
+bool SummaryPyramid::is_available (int level, uint64_t k) const
+{
+    uint64_t num_complete = total >> level;
+    uint64_t ring_size = ring_sizes[level - base_level];
+    return (k < num_complete) && (k + ring_size > num_complete);
+}
+
+void SummaryPyramid::add (const double *package)
+{
+    uint64_t block_mask = ((uint64_t)1 << base_level) - 1;
+    if ((total & block_mask) == 0)
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            acc_min[i] = package[i];
+            acc_max[i] = package[i];
+            acc_sum[i] = package[i];
+        }
+    }
+    else
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            acc_min[i] = std::min (acc_min[i], package[i]);
+            acc_max[i] = std::max (acc_max[i], package[i]);
+            acc_sum[i] += package[i];
+        }
+    }
+    total++;
+    if ((total & block_mask) != 0)
+    {
+        return;
+    }
+
+    // base block is complete, propagate it to upper levels while they are complete too
+    uint64_t k = (total >> base_level) - 1;
+    float *float_block = get_float_block (base_level, k);
+    double *double_block = get_double_block (base_level, k);
+    double block_size = (double)((uint64_t)1 << base_level);
+    for (size_t r = 0; r < float_rows.size (); r++)
+    {
+        int i = float_rows[r];
+        float_block[r * NUM_STATS] = (float)acc_min[i];
+        float_block[r * NUM_STATS + 1] = (float)acc_max[i];
+        float_block[r * NUM_STATS + 2] = (float)(acc_sum[i] / block_size);
+    }
+    for (size_t r = 0; r < double_rows.size (); r++)
+    {
+        int i = double_rows[r];
+        double_block[r * NUM_STATS] = acc_min[i];
+        double_block[r * NUM_STATS + 1] = acc_max[i];
+        double_block[r * NUM_STATS + 2] = acc_sum[i] / block_size;
+    }
+    for (int level = base_level; (level < top_level) && (k % 2 == 1); level++, k /= 2)
+    {
+        merge_blocks (get_float_block (level, k - 1), get_float_block (level, k),
+            get_float_block (level + 1, k / 2), float_rows.size () * NUM_STATS);
+        merge_blocks (get_double_block (level, k - 1), get_double_block (level, k),
+            get_double_block (level + 1, k / 2), double_rows.size () * NUM_STATS);
+    }
+}
+
+bool SummaryPyramid::query (uint64_t start, uint64_t end, uint64_t &covered_start,
+    uint64_t &covered_end, double *min, double *max, double *sum)
+{
+    uint64_t block_size = (uint64_t)1 << base_level;
+    covered_start = ((start + block_size - 1) >> base_level) << base_level;
+    covered_end = (std::min (end, total) >> base_level) << base_level;
+    if (covered_end <= covered_start)
+    {
+        return false;
+    }
+    split_range (covered_start, covered_end, base_level, top_level, query_blocks);
+    for (size_t j = 0; j < query_blocks.size (); j++)
+    {
+        if (!is_available (query_blocks[j].first, query_blocks[j].second))
+        {
+            return false;
+        }
+    }
+    for (size_t j = 0; j < query_blocks.size (); j++)
+    {
+        int level = query_blocks[j].first;
+        uint64_t k = query_blocks[j].second;
+        double size = (double)((uint64_t)1 << level);
+        add_block (get_float_block (level, k), float_rows, size, j == 0, min, max, sum);
+        add_block (get_double_block (level, k), double_rows, size, j == 0, min, max, sum);
+    }
+    return true;
+}
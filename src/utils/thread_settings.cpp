@@ -0,0 +1,226 @@
+#include <string.h>
+
+#include "thread_settings.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#define MAX_THREAD_NAME_LEN 15
+#define MIN_NICE -20
+#define MAX_NICE 19
+
+
+bool ThreadSettings::is_custom () const
+{
+    return (!cpus.empty ()) || (policy != (int)ThreadPolicies::DEFAULT) || (set_nice);
+}
+
+const char *ThreadSettings::policy_to_string (int policy)
+{
+    switch (policy)
+    {
+        case (int)ThreadPolicies::OTHER:
+            return "other";
+        case (int)ThreadPolicies::FIFO:
+            return "fifo";
+        case (int)ThreadPolicies::RR:
+            return "rr";
+        default:
+            return "default";
+    }
+}
+
+int ThreadSettings::policy_from_string (const std::string &policy)
+{
+    if (policy == "other")
+    {
+        return (int)ThreadPolicies::OTHER;
+    }
+    if (policy == "fifo")
+    {
+        return (int)ThreadPolicies::FIFO;
+    }
+    if (policy == "rr")
+    {
+        return (int)ThreadPolicies::RR;
+    }
+    return (int)ThreadPolicies::DEFAULT;
+}
+
+std::string ThreadSettings::validate () const
+{
+    if (name.length () > MAX_THREAD_NAME_LEN)
+    {
+        return "thread name should be up to 15 chars";
+    }
+    if ((set_nice) && ((nice < MIN_NICE) || (nice > MAX_NICE)))
+    {
+        return "nice should be in range [-20, 19]";
+    }
+    for (size_t i = 0; i < cpus.size (); i++)
+    {
+        if (cpus[i] < 0)
+        {
+            return "cpu index should be >= 0";
+        }
+    }
+    if ((policy == (int)ThreadPolicies::FIFO) || (policy == (int)ThreadPolicies::RR))
+    {
+        if ((priority < 1) || (priority > 99))
+        {
+            return "priority for realtime policies should be in range [1, 99]";
+        }
+    }
+    else if (priority != 0)
+    {
+        return "priority can be set only for realtime policies, use nice instead";
+    }
+#ifndef __linux__
+    if (is_custom ())
+    {
+        return "only thread name is supported on this platform";
+    }
+#endif
+    return "";
+}
+
+#ifdef __linux__
+void ThreadSettings::apply (std::vector<std::string> &errors) const
+{
+    pthread_t self = pthread_self ();
+    if (!name.empty ())
+    {
+        int res = pthread_setname_np (self, name.c_str ());
+        if (res != 0)
+        {
+            errors.push_back (std::string ("failed to set name: ") + strerror (res));
+        }
+    }
+    if (!cpus.empty ())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO (&cpu_set);
+        for (size_t i = 0; i < cpus.size (); i++)
+        {
+            if (cpus[i] < CPU_SETSIZE)
+            {
+                CPU_SET (cpus[i], &cpu_set);
+            }
+        }
+        int res = pthread_setaffinity_np (self, sizeof (cpu_set), &cpu_set);
+        if (res != 0)
+        {
+            errors.push_back (std::string ("failed to set affinity: ") + strerror (res));
+        }
+    }
+    if (policy != (int)ThreadPolicies::DEFAULT)
+    {
+        int os_policy = SCHED_OTHER;
+        if (policy == (int)ThreadPolicies::FIFO)
+        {
+            os_policy = SCHED_FIFO;
+        }
+        else if (policy == (int)ThreadPolicies::RR)
+        {
+            os_policy = SCHED_RR;
+        }
+        struct sched_param param;
+        memset (&param, 0, sizeof (param));
+        param.sched_priority = priority;
+        int res = pthread_setschedparam (self, os_policy, &param);
+        if (res != 0)
+        {
+            errors.push_back (std::string ("failed to set policy: ") + strerror (res));
+        }
+    }
+    if (set_nice)
+    {
+        // on linux nice value belongs to the thread, not to the process
+        if (setpriority (PRIO_PROCESS, (id_t)syscall (SYS_gettid), nice) != 0)
+        {
+            errors.push_back (std::string ("failed to set nice: ") + strerror (errno));
+        }
+    }
+}
+
+ThreadSettings ThreadSettings::get_current ()
+{
+    ThreadSettings current;
+    pthread_t self = pthread_self ();
+    current.thread_id = (long)syscall (SYS_gettid);
+
+    char name[MAX_THREAD_NAME_LEN + 1];
+    if (pthread_getname_np (self, name, sizeof (name)) == 0)
+    {
+        current.name = name;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO (&cpu_set);
+    if (pthread_getaffinity_np (self, sizeof (cpu_set), &cpu_set) == 0)
+    {
+        for (int i = 0; i < CPU_SETSIZE; i++)
+        {
+            if (CPU_ISSET (i, &cpu_set))
+            {
+                current.cpus.push_back (i);
+            }
+        }
+    }
+    int os_policy = SCHED_OTHER;
+    struct sched_param param;
+    memset (&param, 0, sizeof (param));
+    if (pthread_getschedparam (self, &os_policy, &param) == 0)
+    {
+        if (os_policy == SCHED_FIFO)
+        {
+            current.policy = (int)ThreadPolicies::FIFO;
+        }
+        else if (os_policy == SCHED_RR)
+        {
+            current.policy = (int)ThreadPolicies::RR;
+        }
+        else
+        {
+            current.policy = (int)ThreadPolicies::OTHER;
+        }
+        current.priority = param.sched_priority;
+    }
+    // -1 is a valid nice value, errno is the only way to detect error
+    errno = 0;
+    int nice = getpriority (PRIO_PROCESS, (id_t)current.thread_id);
+    if (errno == 0)
+    {
+        current.set_nice = true;
+        current.nice = nice;
+    }
+    return current;
+}
+#else
+void ThreadSettings::apply (std::vector<std::string> &errors) const
+{
+    if (is_custom ())
+    {
+        errors.push_back ("thread settings are not supported on this platform");
+    }
+#ifdef __APPLE__
+    if (!name.empty ())
+    {
+        pthread_setname_np (name.c_str ());
+    }
+#endif
+}
+
+ThreadSettings ThreadSettings::get_current ()
+{
+    ThreadSettings current;
+    return current;
+}
+#endif
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "brainflow_constants.h"
+#include "data_buffer.h"
+
+#define NUM_ROWS 32
+#define BUFFER_SIZE 450000
+#define NUM_COPIES 20
+
+
+// resident memory in MB, -1 if unknown
+double get_rss ()
+{
+#ifdef __linux__
+    long pages = 0;
+    long resident = 0;
+    FILE *f = fopen ("/proc/self/statm", "r");
+    if (f == NULL)
+    {
+        return -1;
+    }
+    int res = fscanf (f, "%ld %ld", &pages, &resident);
+    fclose (f);
+    if (res != 2)
+    {
+        return -1;
+    }
+    return (double)resident * sysconf (_SC_PAGESIZE) / (1024.0 * 1024.0);
+#else
+    return -1;
+#endif
+}
+
+double seconds_since (std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+        .count ();
+}
+
+// reference: ring allocated with new[] and filled in the same way as before
+void benchmark_heap_ring (double *package, double *output)
+{
+    double rss_start = get_rss ();
+    double *ring = new double[(size_t)BUFFER_SIZE * NUM_ROWS];
+    double rss_alloc = get_rss () - rss_start;
+    for (size_t i = 0; i < BUFFER_SIZE / 10; i++)
+    {
+        memcpy (ring + i * NUM_ROWS, package, sizeof (double) * NUM_ROWS);
+    }
+    double rss_partial = get_rss () - rss_start;
+    for (size_t i = BUFFER_SIZE / 10; i < BUFFER_SIZE; i++)
+    {
+        memcpy (ring + i * NUM_ROWS, package, sizeof (double) * NUM_ROWS);
+    }
+    double rss_full = get_rss () - rss_start;
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < NUM_COPIES; i++)
+    {
+        memcpy (output, ring, sizeof (double) * BUFFER_SIZE * NUM_ROWS);
+    }
+    double elapsed = seconds_since (start);
+    delete[] ring;
+    printf ("%-12s %12.1f %12.1f %12.1f %12.2f\n", "heap new[]", rss_alloc, rss_partial, rss_full,
+        (double)NUM_COPIES * BUFFER_SIZE * NUM_ROWS * sizeof (double) / elapsed / 1e9);
+}
+
+void benchmark_data_buffer (const char *name, int storage_mode, double *package, double *output)
+{
+    // the last row is a timestamp and is stored as double in all modes
+    std::vector<int> row_types (NUM_ROWS, storage_mode);
+    std::vector<double> row_scales (NUM_ROWS, 1.0);
+    row_types[NUM_ROWS - 1] = (int)BufferStorageModes::FLOAT64;
+    double rss_start = get_rss ();
+    DataBuffer *db =
+        new DataBuffer (NUM_ROWS, BUFFER_SIZE, 0, NULL, row_types.data (), row_scales.data ());
+    double rss_alloc = get_rss () - rss_start;
+    for (size_t i = 0; i < BUFFER_SIZE / 10; i++)
+    {
+        db->add_data (package);
+    }
+    double rss_partial = get_rss () - rss_start;
+    for (size_t i = BUFFER_SIZE / 10; i < BUFFER_SIZE; i++)
+    {
+        db->add_data (package);
+    }
+    double rss_full = get_rss () - rss_start;
+    auto start = std::chrono::high_resolution_clock::now ();
+    for (int i = 0; i < NUM_COPIES; i++)
+    {
+        db->get_current_data (BUFFER_SIZE, output);
+    }
+    double elapsed = seconds_since (start);
+    delete db;
+    printf ("%-12s %12.1f %12.1f %12.1f %12.2f\n", name, rss_alloc, rss_partial, rss_full,
+        (double)NUM_COPIES * BUFFER_SIZE * NUM_ROWS * sizeof (double) / elapsed / 1e9);
+}
+
+int main (int argc, char *argv[])
+{
+    std::vector<double> package (NUM_ROWS, 1.0);
+    // output is touched before measurements to exclude its page faults
+    std::vector<double> output ((size_t)BUFFER_SIZE * NUM_ROWS, 0.0);
+
+    printf ("ring of %d packages x %d rows, %.1f MB\n", BUFFER_SIZE, NUM_ROWS,
+        (double)BUFFER_SIZE * NUM_ROWS * sizeof (double) / (1024.0 * 1024.0));
+    printf ("%-12s %12s %12s %12s %12s\n", "", "rss alloc MB", "rss 10% MB", "rss full MB",
+        "copy GB/s");
+    benchmark_heap_ring (package.data (), output.data ());
+    benchmark_data_buffer (
+        "DataBuffer", (int)BufferStorageModes::FLOAT64, package.data (), output.data ());
+    benchmark_data_buffer (
+        "float32", (int)BufferStorageModes::FLOAT32, package.data (), output.data ());
+    benchmark_data_buffer (
+        "int32 raw", (int)BufferStorageModes::INT32_RAW, package.data (), output.data ());
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <iostream>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "data_filter.h"
+
+#define SAMPLING_RATE 250
+#define NUM_DATAPOINTS 2048
+#define NUM_REPEATS 5
+
+
+double seconds_since (std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double> (std::chrono::high_resolution_clock::now () - start)
+        .count ();
+}
+
+// best of NUM_REPEATS runs in ms for each multichannel method
+void benchmark (double **data, int *channels, int num_channels, double *results)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        results[i] = 1e10;
+    }
+    for (int repeat = 0; repeat < NUM_REPEATS; repeat++)
+    {
+        auto start = std::chrono::high_resolution_clock::now ();
+        std::pair<double *, double *> bands = DataFilter::get_avg_band_powers (
+            data, NUM_DATAPOINTS, channels, num_channels, SAMPLING_RATE, true);
+        results[0] = std::min (results[0], seconds_since (start) * 1000);
+        delete[] bands.first;
+        delete[] bands.second;
+
+        start = std::chrono::high_resolution_clock::now ();
+        std::pair<double *, double *> psd = DataFilter::get_multichannel_psd_multitaper (
+            data, NUM_DATAPOINTS, channels, num_channels, SAMPLING_RATE, 4.0, 7);
+        results[1] = std::min (results[1], seconds_since (start) * 1000);
+        delete[] psd.first;
+        delete[] psd.second;
+
+        start = std::chrono::high_resolution_clock::now ();
+        double *covariance =
+            DataFilter::get_covariance_matrix (data, NUM_DATAPOINTS, channels, num_channels);
+        results[2] = std::min (results[2], seconds_since (start) * 1000);
+        delete[] covariance;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    int channel_counts[] = {8, 32, 128};
+    int max_channels = 128;
+    double **data = new double *[max_channels];
+    std::vector<int> channels (max_channels);
+    srand (42);
+    for (int i = 0; i < max_channels; i++)
+    {
+        channels[i] = i;
+        data[i] = new double[NUM_DATAPOINTS];
+        for (int j = 0; j < NUM_DATAPOINTS; j++)
+        {
+            data[i][j] = 10.0 * sin (2 * M_PI * (5 + i % 30) * j / SAMPLING_RATE) +
+                (double)rand () / RAND_MAX;
+        }
+    }
+
+    int num_cores = (int)std::thread::hardware_concurrency ();
+    std::vector<int> thread_counts;
+    for (int num_threads = 1; num_threads < num_cores; num_threads *= 2)
+    {
+        thread_counts.push_back (num_threads);
+    }
+    thread_counts.push_back ((num_cores > 0) ? num_cores : 1);
+
+    printf ("%d cores, %d datapoints, best of %d runs in ms, speedup against 1 thread\n",
+        num_cores, NUM_DATAPOINTS, NUM_REPEATS);
+    printf ("%8s %8s %18s %18s %18s\n", "channels", "threads", "avg_band_powers",
+        "psd_multitaper", "covariance");
+    for (int channel_count : channel_counts)
+    {
+        double single[3];
+        for (size_t t = 0; t < thread_counts.size (); t++)
+        {
+            double results[3];
+            DataFilter::set_num_threads (thread_counts[t]);
+            benchmark (data, channels.data (), channel_count, results);
+            if (t == 0)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    single[i] = results[i];
+                }
+            }
+            printf ("%8d %8d", channel_count, thread_counts[t]);
+            for (int i = 0; i < 3; i++)
+            {
+                printf (" %10.2f (x%4.1f)", results[i], single[i] / results[i]);
+            }
+            printf ("\n");
+        }
+    }
+
+    for (int i = 0; i < max_channels; i++)
+    {
+        delete[] data[i];
+    }
+    delete[] data;
+    return 0;
+}
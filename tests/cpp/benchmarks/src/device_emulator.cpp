@@ -0,0 +1,880 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <errno.h>
+#include <math.h>
+#include <random>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <oscpp/client.hpp>
+
+#include "emulated_devices.h"
+
+#define GALEA_PACKAGE_SIZE 72
+#define GALEA_NUM_PACKAGES 19
+#define CYTON_PACKAGE_SIZE 33
+// notion osc reads up to 8192 bytes per datagram
+#define OSC_BUFFER_SIZE 8192
+#define MAX_OSC_BUNDLE_SIZE 32
+#define MAX_WIFI_BATCH 1024
+// devices check for commands and stop requests at least this often
+#define MAX_WAIT_MS 100
+#define HTTP_TIMEOUT_MS 1000
+
+
+std::atomic<bool> keep_alive (true);
+
+void stop_emulator (int signal)
+{
+    keep_alive = false;
+}
+
+// sleeps in short intervals to stop quickly, false if emulator is stopped
+bool wait_until (std::chrono::steady_clock::time_point time_point)
+{
+    while (keep_alive)
+    {
+        auto now = std::chrono::steady_clock::now ();
+        if (now >= time_point)
+        {
+            return true;
+        }
+        std::this_thread::sleep_until (
+            std::min (time_point, now + std::chrono::milliseconds (MAX_WAIT_MS)));
+    }
+    return false;
+}
+
+bool fill_address (const std::string &ip, int port, struct sockaddr_in &address)
+{
+    memset (&address, 0, sizeof (address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons (port);
+    return (inet_pton (AF_INET, ip.c_str (), &address.sin_addr) == 1);
+}
+
+bool send_all (int fd, const char *data, int size)
+{
+    while (size > 0)
+    {
+        int res = (int)::send (fd, data, size, 0);
+        if (res <= 0)
+        {
+            return false;
+        }
+        data += res;
+        size -= res;
+    }
+    return true;
+}
+
+void write_24bit (unsigned char *b, int32_t value)
+{
+    b[0] = (unsigned char)(value >> 16);
+    b[1] = (unsigned char)(value >> 8);
+    b[2] = (unsigned char)value;
+}
+
+
+// schedules packets of samples_per_packet samples at options.rate, a packet is due when its last
+// sample is acquired plus random jitter, samples are numbered from start
+class Pacer
+{
+public:
+    Pacer (const EmulatorOptions &options, int device)
+        : options (options), generator (device + 1), uniform (0.0, 1.0)
+    {
+        start (1);
+    }
+
+    void start (int samples_per_packet)
+    {
+        this->samples_per_packet = samples_per_packet;
+        steady_start = std::chrono::steady_clock::now ();
+        wall_start = wall_time ();
+        packet = 0;
+        due = steady_start;
+        update_due ();
+    }
+
+    void next ()
+    {
+        packet++;
+        update_due ();
+    }
+
+    std::chrono::steady_clock::time_point get_due () const
+    {
+        return due;
+    }
+
+    int64_t get_sample_num (int sample) const
+    {
+        return packet * samples_per_packet + sample;
+    }
+
+    // wall time when sample of current packet was acquired
+    double get_sample_time (int sample) const
+    {
+        return wall_start + (double)get_sample_num (sample) / options.rate;
+    }
+
+    bool is_lost ()
+    {
+        return (options.loss > 0.0) && (uniform (generator) < options.loss);
+    }
+
+private:
+    const EmulatorOptions &options;
+    std::mt19937 generator;
+    std::uniform_real_distribution<double> uniform;
+    int samples_per_packet;
+    int64_t packet;
+    std::chrono::steady_clock::time_point steady_start;
+    double wall_start;
+    std::chrono::steady_clock::time_point due;
+
+    void update_due ()
+    {
+        double offset = (double)(get_sample_num (samples_per_packet - 1)) / options.rate;
+        if (options.jitter > 0.0)
+        {
+            offset += uniform (generator) * options.jitter / 1000.0;
+        }
+        // jitter doesnt reorder packets
+        due = std::max (due,
+            steady_start +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+                    std::chrono::duration<double> (offset)));
+    }
+};
+
+
+class EmulatedDevice
+{
+public:
+    EmulatedDevice (const EmulatorOptions &options, int device)
+        : options (options), pacer (options, device)
+    {
+        this->device = device;
+        num_sent = 0;
+        num_lost = 0;
+        num_errors = 0;
+    }
+
+    virtual ~EmulatedDevice ()
+    {
+    }
+
+    // opens sockets, returns false on error
+    virtual bool init () = 0;
+    // works until emulator is stopped
+    virtual void run () = 0;
+    virtual std::string get_address () = 0;
+
+    void print_stats ()
+    {
+        printf ("device %d %s: sent %lld samples, lost %lld, send errors %lld\n", device,
+            get_address ().c_str (), (long long)num_sent, (long long)num_lost,
+            (long long)num_errors);
+    }
+
+    int64_t get_num_sent ()
+    {
+        return num_sent;
+    }
+
+    int64_t get_num_lost ()
+    {
+        return num_lost;
+    }
+
+protected:
+    const EmulatorOptions &options;
+    int device;
+    Pacer pacer;
+    // sent and lost are in samples, errors are in packets
+    int64_t num_sent;
+    int64_t num_lost;
+    int64_t num_errors;
+};
+
+
+// replies to commands like galea firmware, after 'b' sends transactions of 19 packages
+class GaleaDevice : public EmulatedDevice
+{
+public:
+    GaleaDevice (const EmulatorOptions &options, int device) : EmulatedDevice (options, device)
+    {
+        fd = -1;
+        is_streaming = false;
+        memset (&client_address, 0, sizeof (client_address));
+    }
+
+    ~GaleaDevice ()
+    {
+        if (fd >= 0)
+        {
+            close (fd);
+        }
+    }
+
+    bool init ()
+    {
+        struct sockaddr_in address;
+        if (!fill_address (get_device_ip (options.ip, device), options.port, address))
+        {
+            return false;
+        }
+        fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        return (fd >= 0) && (bind (fd, (struct sockaddr *)&address, sizeof (address)) == 0);
+    }
+
+    void run ()
+    {
+        while (keep_alive)
+        {
+            int timeout = MAX_WAIT_MS;
+            if (is_streaming)
+            {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds> (
+                    pacer.get_due () - std::chrono::steady_clock::now ());
+                timeout = std::max (0, std::min ((int)wait.count (), MAX_WAIT_MS));
+            }
+            struct pollfd poll_fd = {fd, POLLIN, 0};
+            if (poll (&poll_fd, 1, timeout) > 0)
+            {
+                handle_command ();
+                continue;
+            }
+            // poll has ms resolution
+            if ((is_streaming) && (pacer.get_due () - std::chrono::steady_clock::now () <
+                                      std::chrono::milliseconds (1)))
+            {
+                std::this_thread::sleep_until (pacer.get_due ());
+                if (pacer.is_lost ())
+                {
+                    num_lost += GALEA_NUM_PACKAGES;
+                }
+                else
+                {
+                    send_transaction (false);
+                }
+                pacer.next ();
+            }
+        }
+    }
+
+    std::string get_address ()
+    {
+        return get_device_ip (options.ip, device) + ":" + std::to_string (options.port);
+    }
+
+private:
+    int fd;
+    struct sockaddr_in client_address;
+    bool is_streaming;
+
+    void handle_command ()
+    {
+        char b[128];
+        socklen_t len = sizeof (client_address);
+        int res =
+            (int)recvfrom (fd, b, sizeof (b), 0, (struct sockaddr *)&client_address, &len);
+        if (res <= 0)
+        {
+            return;
+        }
+        std::string command (b, res);
+        if (command == "b")
+        {
+            is_streaming = true;
+            pacer.start (GALEA_NUM_PACKAGES);
+        }
+        else if (command == "s")
+        {
+            is_streaming = false;
+        }
+        else if (command == "F4")
+        {
+            // single transaction to calc time delay
+            send_transaction (true);
+        }
+        else if (!is_streaming)
+        {
+            // config commands dont change package format
+            sendto (fd, "A", 1, 0, (struct sockaddr *)&client_address, sizeof (client_address));
+        }
+    }
+
+    void send_transaction (bool now)
+    {
+        unsigned char b[GALEA_PACKAGE_SIZE * GALEA_NUM_PACKAGES];
+        double current_time = wall_time ();
+        for (int i = 0; i < GALEA_NUM_PACKAGES; i++)
+        {
+            unsigned char *package = b + i * GALEA_PACKAGE_SIZE;
+            int64_t sample_num = pacer.get_sample_num (i);
+            double sample_time = (now) ? current_time : pacer.get_sample_time (i);
+            package[0] = (unsigned char)sample_num; // has gaps for lost packages
+            float eda = 1.0f + (float)(sample_num % 100) / 100.0f;
+            memcpy (package + 1, &eda, 4);
+            for (int channel = 0; channel < 16; channel++)
+            {
+                write_24bit (package + 5 + 3 * channel,
+                    (int32_t)((sample_num * (channel + 1)) % 8388608));
+            }
+            package[53] = 95; // battery
+            uint16_t temperature = 3650;
+            memcpy (package + 54, &temperature, 2);
+            int32_t seconds = (int32_t)floor (sample_time);
+            int32_t microseconds = (int32_t)((sample_time - seconds) * 1e6);
+            memcpy (package + 56, &seconds, 4);
+            memcpy (package + 60, &microseconds, 4);
+            double device_timestamp = sample_time * 1e6;
+            memcpy (package + 64, &device_timestamp, 8);
+        }
+        int res = (int)sendto (fd, (const char *)b, sizeof (b), 0,
+            (struct sockaddr *)&client_address, sizeof (client_address));
+        if (now)
+        {
+            return;
+        }
+        if (res == (int)sizeof (b))
+        {
+            num_sent += GALEA_NUM_PACKAGES;
+        }
+        else
+        {
+            num_errors++;
+        }
+    }
+};
+
+
+// http server of wifi shield, after POST /tcp connects to brainflow and streams cyton packages
+// in chunks collected for "latency" microseconds from /tcp request
+class WifiShieldDevice : public EmulatedDevice
+{
+public:
+    WifiShieldDevice (const EmulatorOptions &options, int device)
+        : EmulatedDevice (options, device)
+    {
+        http_fd = -1;
+        data_fd = -1;
+        is_streaming = false;
+        batch = 1;
+    }
+
+    ~WifiShieldDevice ()
+    {
+        stop_streaming ();
+        if (http_fd >= 0)
+        {
+            close (http_fd);
+        }
+        if (data_fd >= 0)
+        {
+            close (data_fd);
+        }
+    }
+
+    bool init ()
+    {
+        struct sockaddr_in address;
+        if (!fill_address (get_device_ip (options.ip, device), options.port, address))
+        {
+            return false;
+        }
+        http_fd = socket (AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (http_fd < 0)
+        {
+            return false;
+        }
+        int value = 1;
+        setsockopt (http_fd, SOL_SOCKET, SO_REUSEADDR, (char *)&value, sizeof (value));
+        return (bind (http_fd, (struct sockaddr *)&address, sizeof (address)) == 0) &&
+            (listen (http_fd, 8) == 0);
+    }
+
+    void run ()
+    {
+        while (keep_alive)
+        {
+            struct pollfd poll_fd = {http_fd, POLLIN, 0};
+            if (poll (&poll_fd, 1, MAX_WAIT_MS) <= 0)
+            {
+                continue;
+            }
+            int client_fd = accept (http_fd, NULL, NULL);
+            if (client_fd >= 0)
+            {
+                handle_request (client_fd);
+                close (client_fd);
+            }
+        }
+        stop_streaming ();
+    }
+
+    std::string get_address ()
+    {
+        return get_device_ip (options.ip, device) + ":" + std::to_string (options.port);
+    }
+
+private:
+    int http_fd;
+    int data_fd;
+    std::atomic<bool> is_streaming;
+    std::thread streaming_thread;
+    int batch;
+
+    static std::string get_json_value (const std::string &body, const std::string &key)
+    {
+        size_t pos = body.find ("\"" + key + "\"");
+        if (pos == std::string::npos)
+        {
+            return "";
+        }
+        pos = body.find_first_not_of (" :\"", pos + key.size () + 2);
+        if (pos == std::string::npos)
+        {
+            return "";
+        }
+        return body.substr (pos, body.find_first_of (",}\"", pos) - pos);
+    }
+
+    // reads headers and body, returns false on timeout
+    static bool read_request (int client_fd, std::string &request, std::string &body)
+    {
+        char b[1024];
+        size_t body_size = 0;
+        size_t header_end = std::string::npos;
+        while ((header_end == std::string::npos) || (request.size () < header_end + body_size))
+        {
+            struct pollfd poll_fd = {client_fd, POLLIN, 0};
+            if (poll (&poll_fd, 1, HTTP_TIMEOUT_MS) <= 0)
+            {
+                return false;
+            }
+            int res = (int)recv (client_fd, b, sizeof (b), 0);
+            if (res <= 0)
+            {
+                return false;
+            }
+            request.append (b, res);
+            if (header_end == std::string::npos)
+            {
+                size_t pos = request.find ("\r\n\r\n");
+                if (pos != std::string::npos)
+                {
+                    header_end = pos + 4;
+                    pos = request.find ("Content-Length:");
+                    if ((pos != std::string::npos) && (pos < header_end))
+                    {
+                        body_size = (size_t)atoi (request.c_str () + pos + 15);
+                    }
+                }
+            }
+        }
+        body = request.substr (header_end);
+        return true;
+    }
+
+    void handle_request (int client_fd)
+    {
+        std::string request;
+        std::string body;
+        if (!read_request (client_fd, request, body))
+        {
+            return;
+        }
+        std::string path = request.substr (0, request.find ("\r\n"));
+        path = path.substr (path.find (' ') + 1);
+        path = path.substr (0, path.find (' '));
+        std::string status = "200 OK";
+        std::string response = "";
+        if (path == "/board")
+        {
+            response = "{\"board_connected\": true, \"board_type\": \"cyton\", \"gains\": "
+                       "[24, 24, 24, 24, 24, 24, 24, 24], \"num_channels\": 8}";
+        }
+        else if (path == "/tcp")
+        {
+            if (!connect_data_socket (body))
+            {
+                status = "500 Internal Server Error";
+            }
+        }
+        else if (path == "/stream/start")
+        {
+            start_streaming ();
+        }
+        else if (path == "/stream/stop")
+        {
+            stop_streaming ();
+        }
+        else if (path != "/command")
+        {
+            status = "404 Not Found";
+        }
+        // client reads response until connection is closed
+        std::string header = "HTTP/1.1 " + status +
+            "\r\nContent-Type: application/json\r\nContent-Length: " +
+            std::to_string (response.size ()) + "\r\nConnection: close\r\n\r\n";
+        std::string message = header + response;
+        send_all (client_fd, message.c_str (), (int)message.size ());
+        shutdown (client_fd, SHUT_WR);
+    }
+
+    bool connect_data_socket (const std::string &body)
+    {
+        stop_streaming ();
+        if (data_fd >= 0)
+        {
+            close (data_fd);
+        }
+        double latency = atof (get_json_value (body, "latency").c_str ());
+        batch = std::max (1, std::min ((int)(options.rate * latency / 1e6), MAX_WIFI_BATCH));
+        struct sockaddr_in address;
+        int port = atoi (get_json_value (body, "port").c_str ());
+        if (!fill_address (get_json_value (body, "ip"), port, address))
+        {
+            return false;
+        }
+        data_fd = socket (AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        return (data_fd >= 0) &&
+            (connect (data_fd, (struct sockaddr *)&address, sizeof (address)) == 0);
+    }
+
+    void start_streaming ()
+    {
+        if ((is_streaming) || (data_fd < 0))
+        {
+            return;
+        }
+        is_streaming = true;
+        streaming_thread = std::thread ([this] { this->stream (); });
+    }
+
+    void stop_streaming ()
+    {
+        if (is_streaming)
+        {
+            is_streaming = false;
+            streaming_thread.join ();
+        }
+    }
+
+    void stream ()
+    {
+        std::vector<unsigned char> b (CYTON_PACKAGE_SIZE * batch);
+        pacer.start (batch);
+        while ((is_streaming) && (wait_until (pacer.get_due ())))
+        {
+            if (pacer.is_lost ())
+            {
+                num_lost += batch;
+                pacer.next ();
+                continue;
+            }
+            for (int i = 0; i < batch; i++)
+            {
+                unsigned char *package = b.data () + i * CYTON_PACKAGE_SIZE;
+                int64_t sample_num = pacer.get_sample_num (i);
+                package[0] = 0xA0;
+                package[1] = (unsigned char)sample_num;
+                for (int channel = 0; channel < 8; channel++)
+                {
+                    write_24bit (package + 2 + 3 * channel,
+                        (int32_t)((sample_num * (channel + 1)) % 8388608));
+                }
+                uint64_t microseconds = (uint64_t)(pacer.get_sample_time (i) * 1e6);
+                for (int j = 0; j < 6; j++)
+                {
+                    package[26 + j] = (unsigned char)(microseconds >> (8 * (5 - j)));
+                }
+                package[32] = 0xC0;
+            }
+            if (send_all (data_fd, (const char *)b.data (), (int)b.size ()))
+            {
+                num_sent += batch;
+            }
+            else
+            {
+                num_errors++;
+            }
+            pacer.next ();
+        }
+    }
+};
+
+
+// sends notion raw messages, several samples are sent as a bundle
+class OscDevice : public EmulatedDevice
+{
+public:
+    OscDevice (const EmulatorOptions &options, int device) : EmulatedDevice (options, device)
+    {
+        fd = -1;
+        address = "/neurosity/notion/emulator_" + std::to_string (device) + "/raw";
+    }
+
+    ~OscDevice ()
+    {
+        if (fd >= 0)
+        {
+            close (fd);
+        }
+    }
+
+    bool init ()
+    {
+        fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        return (fd >= 0) && (fill_address (options.ip, options.port + device, destination));
+    }
+
+    void run ()
+    {
+        // oscpp requires aligned buffer
+        std::vector<uint32_t> buffer (OSC_BUFFER_SIZE / sizeof (uint32_t));
+        OSCPP::Client::Packet packet (buffer.data (), OSC_BUFFER_SIZE);
+        pacer.start (options.batch);
+        while (wait_until (pacer.get_due ()))
+        {
+            if (pacer.is_lost ())
+            {
+                num_lost += options.batch;
+                pacer.next ();
+                continue;
+            }
+            packet.reset ();
+            if (options.batch > 1)
+            {
+                packet.openBundle (1); // immediately
+            }
+            for (int i = 0; i < options.batch; i++)
+            {
+                int64_t sample_num = pacer.get_sample_num (i);
+                char timestamp[32];
+                snprintf (timestamp, sizeof (timestamp), "%.6f", pacer.get_sample_time (i));
+                // eeg array, timestamp, package num and marker
+                packet.openMessage (address.c_str (), 13).openArray ();
+                for (int channel = 0; channel < 8; channel++)
+                {
+                    packet.float32 ((float)((sample_num * (channel + 1)) % 1000));
+                }
+                packet.closeArray ()
+                    .string (timestamp)
+                    .int32 ((int32_t)sample_num)
+                    .string ("")
+                    .closeMessage ();
+            }
+            if (options.batch > 1)
+            {
+                packet.closeBundle ();
+            }
+            int res = (int)sendto (fd, (const char *)buffer.data (), packet.size (), 0,
+                (struct sockaddr *)&destination, sizeof (destination));
+            if (res == (int)packet.size ())
+            {
+                num_sent += options.batch;
+            }
+            else
+            {
+                num_errors++;
+            }
+            pacer.next ();
+        }
+    }
+
+    std::string get_address ()
+    {
+        return options.ip + ":" + std::to_string (options.port + device);
+    }
+
+private:
+    int fd;
+    struct sockaddr_in destination;
+    std::string address;
+};
+
+
+// sends packages of synthetic board to multicast group like streamer of master board, one
+// package per datagram, batch of them is sent at once
+class StreamingDevice : public EmulatedDevice
+{
+public:
+    StreamingDevice (const EmulatorOptions &options, int device)
+        : EmulatedDevice (options, device)
+    {
+        fd = -1;
+    }
+
+    ~StreamingDevice ()
+    {
+        if (fd >= 0)
+        {
+            close (fd);
+        }
+    }
+
+    bool init ()
+    {
+        fd = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (fd < 0)
+        {
+            return false;
+        }
+        unsigned char ttl = 1;
+        unsigned char loop = 1;
+        setsockopt (fd, IPPROTO_IP, IP_MULTICAST_TTL, (char *)&ttl, sizeof (ttl));
+        setsockopt (fd, IPPROTO_IP, IP_MULTICAST_LOOP, (char *)&loop, sizeof (loop));
+        return fill_address (options.ip, options.port + device, destination);
+    }
+
+    void run ()
+    {
+        double package[EMULATED_STREAMING_NUM_ROWS];
+        pacer.start (options.batch);
+        while (wait_until (pacer.get_due ()))
+        {
+            for (int i = 0; i < options.batch; i++)
+            {
+                if (pacer.is_lost ())
+                {
+                    num_lost++;
+                    continue;
+                }
+                int64_t sample_num = pacer.get_sample_num (i);
+                for (int row = 0; row < EMULATED_STREAMING_NUM_ROWS; row++)
+                {
+                    package[row] = (double)((sample_num * (row + 1)) % 1000);
+                }
+                package[EMULATED_STREAMING_PACKAGE_NUM_ROW] = (double)(sample_num % 256);
+                package[EMULATED_STREAMING_TIMESTAMP_ROW] = pacer.get_sample_time (i);
+                int res = (int)sendto (fd, (const char *)package, sizeof (package), 0,
+                    (struct sockaddr *)&destination, sizeof (destination));
+                if (res == (int)sizeof (package))
+                {
+                    num_sent++;
+                }
+                else
+                {
+                    num_errors++;
+                }
+            }
+            pacer.next ();
+        }
+    }
+
+    std::string get_address ()
+    {
+        return options.ip + ":" + std::to_string (options.port + device);
+    }
+
+private:
+    int fd;
+    struct sockaddr_in destination;
+};
+
+
+EmulatedDevice *create_device (const EmulatorOptions &options, int device)
+{
+    switch (options.protocol)
+    {
+        case EmulatedProtocols::GALEA:
+            return new GaleaDevice (options, device);
+        case EmulatedProtocols::WIFI_SHIELD:
+            return new WifiShieldDevice (options, device);
+        case EmulatedProtocols::OSC:
+            return new OscDevice (options, device);
+        default:
+            return new StreamingDevice (options, device);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    EmulatorOptions options;
+    if (!parse_emulator_options (argc, argv, options))
+    {
+        print_emulator_usage (argv[0]);
+        return -1;
+    }
+    if ((options.protocol == EmulatedProtocols::OSC) && (options.batch > MAX_OSC_BUNDLE_SIZE))
+    {
+        printf ("max batch for osc is %d\n", MAX_OSC_BUNDLE_SIZE);
+        return -1;
+    }
+    signal (SIGINT, stop_emulator);
+    signal (SIGTERM, stop_emulator);
+    // brainflow may close tcp connection of wifi shield at any time
+    signal (SIGPIPE, SIG_IGN);
+
+    int res = 0;
+    std::vector<EmulatedDevice *> devices;
+    for (int i = 0; i < options.num_devices; i++)
+    {
+        devices.push_back (create_device (options, i));
+        if (!devices[i]->init ())
+        {
+            printf ("failed to init device %d %s: %s\n", i, devices[i]->get_address ().c_str (),
+                strerror (errno));
+            res = -1;
+            break;
+        }
+    }
+    if (res == 0)
+    {
+        printf ("emulating %d devices at %.1f Hz, loss %.3f, jitter %.1f ms\n",
+            options.num_devices, options.rate, options.loss, options.jitter);
+        fflush (stdout);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < devices.size (); i++)
+        {
+            threads.push_back (std::thread ([&devices, i] { devices[i]->run (); }));
+        }
+        auto start = std::chrono::steady_clock::now ();
+        while (keep_alive)
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (MAX_WAIT_MS));
+            if ((options.duration > 0.0) &&
+                (std::chrono::steady_clock::now () - start >
+                    std::chrono::duration<double> (options.duration)))
+            {
+                keep_alive = false;
+            }
+        }
+        for (size_t i = 0; i < threads.size (); i++)
+        {
+            threads[i].join ();
+        }
+        int64_t total = 0;
+        int64_t total_lost = 0;
+        for (size_t i = 0; i < devices.size (); i++)
+        {
+            devices[i]->print_stats ();
+            total += devices[i]->get_num_sent ();
+            total_lost += devices[i]->get_num_lost ();
+        }
+        printf ("total: sent %lld samples, lost %lld\n", (long long)total, (long long)total_lost);
+    }
+
+    for (size_t i = 0; i < devices.size (); i++)
+    {
+        delete devices[i];
+    }
+    return res;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+
+// protocols of network boards spoken by device_emulator, network_load_benchmark connects brainflow
+// sessions to the same devices
+enum class EmulatedProtocols : int
+{
+    GALEA = 0,       // udp, 19 packages of 72 bytes per transaction, replies to commands
+    WIFI_SHIELD = 1, // http control on port 80, 33 bytes cyton packages over tcp
+    OSC = 2,         // notion osc messages over udp
+    STREAMING = 3    // packages of master board (synthetic) sent to multicast group
+};
+
+// master board for streaming protocol is synthetic board
+#define EMULATED_STREAMING_NUM_ROWS 32
+#define EMULATED_STREAMING_PACKAGE_NUM_ROW 0
+#define EMULATED_STREAMING_TIMESTAMP_ROW 30
+
+// to measure latency each sample carries its acquisition time, wall clock is used because
+// emulator and benchmark are different processes:
+//   galea - ppg red channel has seconds, ppg ir channel has microseconds
+//   wifi shield - 6 aux bytes have microseconds modulo 2^48, big endian
+//   osc and streaming - timestamp channel
+#define EMULATED_TIME_BITS 48
+
+
+struct EmulatorOptions
+{
+    EmulatedProtocols protocol;
+    int num_devices;
+    // samples per second for each device
+    double rate;
+    // probability to drop a packet
+    double loss;
+    // max random delay of a packet in ms, packets are not reordered
+    double jitter;
+    // 0 means until interrupted
+    double duration;
+    // device ip for galea and wifi shield, next devices use next addresses
+    // destination ip for osc and streaming, next devices use next ports
+    std::string ip;
+    int port;
+    // samples per osc bundle or streaming burst
+    int batch;
+    // first tcp port of brainflow sessions for wifi shield
+    int local_port;
+    // how often benchmark reads data in ms
+    int poll_interval;
+};
+
+
+inline double wall_time ()
+{
+    return std::chrono::duration<double> (std::chrono::system_clock::now ().time_since_epoch ())
+        .count ();
+}
+
+// 127.0.0.1 and 2 gives 127.0.0.3
+inline std::string get_device_ip (const std::string &base_ip, int device)
+{
+    int octets[4];
+    if (sscanf (base_ip.c_str (), "%d.%d.%d.%d", &octets[0], &octets[1], &octets[2], &octets[3]) !=
+        4)
+    {
+        return base_ip;
+    }
+    return std::to_string (octets[0]) + "." + std::to_string (octets[1]) + "." +
+        std::to_string (octets[2]) + "." + std::to_string (octets[3] + device);
+}
+
+inline void print_emulator_usage (const char *name)
+{
+    printf ("usage: %s galea|wifi|osc|streaming [--devices N] [--rate HZ] [--loss P] "
+            "[--jitter MS] [--duration S] [--ip IP] [--port PORT] [--batch N] [--local-port PORT] "
+            "[--poll MS]\n",
+        name);
+}
+
+// defaults depend on protocol, returns false for invalid options
+inline bool parse_emulator_options (int argc, char *argv[], EmulatorOptions &options)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+    std::string protocol = argv[1];
+    options.num_devices = 1;
+    options.rate = 250.0;
+    options.loss = 0.0;
+    options.jitter = 0.0;
+    options.duration = 0.0;
+    options.ip = "127.0.0.1";
+    options.batch = 1;
+    options.local_port = 6987;
+    options.poll_interval = 1;
+    if (protocol == "galea")
+    {
+        options.protocol = EmulatedProtocols::GALEA;
+        options.port = 2390;
+    }
+    else if (protocol == "wifi")
+    {
+        options.protocol = EmulatedProtocols::WIFI_SHIELD;
+        options.port = 80;
+        options.rate = 1000.0;
+    }
+    else if (protocol == "osc")
+    {
+        options.protocol = EmulatedProtocols::OSC;
+        options.port = 9000;
+    }
+    else if (protocol == "streaming")
+    {
+        options.protocol = EmulatedProtocols::STREAMING;
+        options.ip = "225.1.1.1";
+        options.port = 6677;
+    }
+    else
+    {
+        return false;
+    }
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string name = argv[i];
+        const char *value = argv[i + 1];
+        if (name == "--devices")
+        {
+            options.num_devices = atoi (value);
+        }
+        else if (name == "--rate")
+        {
+            options.rate = atof (value);
+        }
+        else if (name == "--loss")
+        {
+            options.loss = atof (value);
+        }
+        else if (name == "--jitter")
+        {
+            options.jitter = atof (value);
+        }
+        else if (name == "--duration")
+        {
+            options.duration = atof (value);
+        }
+        else if (name == "--ip")
+        {
+            options.ip = value;
+        }
+        else if (name == "--port")
+        {
+            options.port = atoi (value);
+        }
+        else if (name == "--batch")
+        {
+            options.batch = atoi (value);
+        }
+        else if (name == "--local-port")
+        {
+            options.local_port = atoi (value);
+        }
+        else if (name == "--poll")
+        {
+            options.poll_interval = atoi (value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    // each option has a value
+    if (argc % 2 != 0)
+    {
+        return false;
+    }
+    return (options.num_devices > 0) && (options.rate > 0.0) && (options.loss >= 0.0) &&
+        (options.loss <= 1.0) && (options.jitter >= 0.0) && (options.duration >= 0.0) &&
+        (options.batch > 0) && (options.poll_interval > 0);
+}
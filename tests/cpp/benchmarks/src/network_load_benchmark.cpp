@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_shim.h"
+#include "emulated_devices.h"
+
+#define DEFAULT_DURATION 10.0
+#define BUFFER_SIZE 450000
+
+
+struct DeviceSession
+{
+    BoardShim *board;
+    // board which defines package format
+    int data_board_id;
+    int package_num_channel;
+    // channels with acquisition time of sample, see emulated_devices.h
+    std::vector<int> time_channels;
+    // package num wraps at this value
+    int64_t package_num_range;
+    int64_t last_package_num;
+    int64_t num_samples;
+    int64_t num_lost;
+};
+
+
+void init_session (const EmulatorOptions &options, int device, DeviceSession &session)
+{
+    struct BrainFlowInputParams params;
+    int board_id = (int)BoardIds::STREAMING_BOARD;
+    session.package_num_range = 256;
+    int len = 0;
+    int *channels = NULL;
+    switch (options.protocol)
+    {
+        case EmulatedProtocols::GALEA:
+            board_id = (int)BoardIds::GALEA_BOARD;
+            session.data_board_id = board_id;
+            params.ip_address = get_device_ip (options.ip, device);
+            channels = BoardShim::get_ppg_channels (board_id, &len);
+            session.time_channels.assign (channels, channels + 2);
+            break;
+        case EmulatedProtocols::WIFI_SHIELD:
+            board_id = (int)BoardIds::CYTON_WIFI_BOARD;
+            session.data_board_id = board_id;
+            params.ip_address = get_device_ip (options.ip, device);
+            params.ip_port = options.local_port + device;
+            // other channels 1-6 are raw aux bytes
+            channels = BoardShim::get_other_channels (board_id, &len);
+            session.time_channels.assign (channels + 1, channels + 7);
+            break;
+        case EmulatedProtocols::OSC:
+            board_id = (int)BoardIds::NOTION_1_BOARD;
+            session.data_board_id = board_id;
+            params.ip_port = options.port + device;
+            params.serial_number = "emulator_" + std::to_string (device);
+            session.package_num_range = (int64_t)1 << 32;
+            session.time_channels.push_back (BoardShim::get_timestamp_channel (board_id));
+            break;
+        default:
+            session.data_board_id = (int)BoardIds::SYNTHETIC_BOARD;
+            params.ip_address = options.ip;
+            params.ip_port = options.port + device;
+            params.other_info = std::to_string ((int)BoardIds::SYNTHETIC_BOARD);
+            session.time_channels.push_back (
+                BoardShim::get_timestamp_channel (session.data_board_id));
+            break;
+    }
+    delete[] channels;
+    session.package_num_channel = BoardShim::get_package_num_channel (session.data_board_id);
+    session.last_package_num = -1;
+    session.num_samples = 0;
+    session.num_lost = 0;
+    session.board = new BoardShim (board_id, params);
+}
+
+double get_sample_time (
+    const EmulatorOptions &options, DeviceSession &session, double **data, int sample, double now)
+{
+    const std::vector<int> &channels = session.time_channels;
+    if (options.protocol == EmulatedProtocols::GALEA)
+    {
+        return data[channels[0]][sample] + data[channels[1]][sample] / 1e6;
+    }
+    if (options.protocol == EmulatedProtocols::WIFI_SHIELD)
+    {
+        uint64_t code = 0;
+        for (int i = 0; i < 6; i++)
+        {
+            code = (code << 8) | (uint64_t)data[channels[i]][sample];
+        }
+        uint64_t mask = ((uint64_t)1 << EMULATED_TIME_BITS) - 1;
+        uint64_t now_code = (uint64_t)(now * 1e6) & mask;
+        return now - (double)((now_code - code) & mask) / 1e6;
+    }
+    return data[channels[0]][sample];
+}
+
+// reads all new samples, returns number of them
+int read_session (const EmulatorOptions &options, DeviceSession &session,
+    std::vector<double> *latencies)
+{
+    int num_samples = 0;
+    double **data = session.board->get_board_data (&num_samples);
+    double now = wall_time ();
+    for (int i = 0; (latencies != NULL) && (i < num_samples); i++)
+    {
+        latencies->push_back (now - get_sample_time (options, session, data, i, now));
+        int64_t package_num = (int64_t)data[session.package_num_channel][i];
+        if (session.last_package_num >= 0)
+        {
+            session.num_lost += (package_num - session.last_package_num - 1 +
+                                    session.package_num_range) %
+                session.package_num_range;
+        }
+        session.last_package_num = package_num;
+    }
+    if (latencies != NULL)
+    {
+        session.num_samples += num_samples;
+    }
+    int num_rows = BoardShim::get_num_rows (session.data_board_id);
+    for (int i = 0; i < num_rows; i++)
+    {
+        delete[] data[i];
+    }
+    delete[] data;
+    return num_samples;
+}
+
+double get_percentile (std::vector<double> &values, double percentile)
+{
+    if (values.empty ())
+    {
+        return 0.0;
+    }
+    size_t index = std::min (values.size () - 1, (size_t)(percentile * values.size ()));
+    std::nth_element (values.begin (), values.begin () + index, values.end ());
+    return values[index];
+}
+
+// connects brainflow sessions to devices of device_emulator started with the same options,
+// reports throughput, lost samples and latency from acquisition in emulator to get_board_data
+int main (int argc, char *argv[])
+{
+    EmulatorOptions options;
+    if (!parse_emulator_options (argc, argv, options))
+    {
+        print_emulator_usage (argv[0]);
+        return -1;
+    }
+    if (options.duration == 0.0)
+    {
+        options.duration = DEFAULT_DURATION;
+    }
+    BoardShim::set_log_level ((int)LogLevels::LEVEL_WARN);
+
+    int res = 0;
+    std::vector<DeviceSession> sessions (options.num_devices);
+    std::vector<double> latencies;
+    double seconds = 0.0;
+    try
+    {
+        for (int i = 0; i < options.num_devices; i++)
+        {
+            init_session (options, i, sessions[i]);
+            sessions[i].board->prepare_session ();
+            sessions[i].board->start_stream (BUFFER_SIZE);
+        }
+        // skip samples received before all sessions are started
+        for (int i = 0; i < options.num_devices; i++)
+        {
+            read_session (options, sessions[i], NULL);
+        }
+        auto start = std::chrono::steady_clock::now ();
+        while (std::chrono::steady_clock::now () - start <
+            std::chrono::duration<double> (options.duration))
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (options.poll_interval));
+            for (int i = 0; i < options.num_devices; i++)
+            {
+                read_session (options, sessions[i], &latencies);
+            }
+        }
+        seconds =
+            std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+        for (int i = 0; i < options.num_devices; i++)
+        {
+            sessions[i].board->stop_stream ();
+            sessions[i].board->release_session ();
+        }
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        for (size_t i = 0; i < sessions.size (); i++)
+        {
+            if ((sessions[i].board != NULL) && (sessions[i].board->is_prepared ()))
+            {
+                sessions[i].board->release_session ();
+            }
+        }
+    }
+
+    if (res == 0)
+    {
+        int64_t total = 0;
+        int64_t total_lost = 0;
+        for (int i = 0; i < options.num_devices; i++)
+        {
+            printf ("device %d: %lld samples, lost %lld\n", i, (long long)sessions[i].num_samples,
+                (long long)sessions[i].num_lost);
+            total += sessions[i].num_samples;
+            total_lost += sessions[i].num_lost;
+        }
+        double lost_percent = 100.0 * total_lost / std::max ((int64_t)1, total + total_lost);
+        printf ("total: %lld samples in %.1f s, %.0f samples/s, lost %.3f%%\n", (long long)total,
+            seconds, total / seconds, lost_percent);
+        printf ("latency ms: p50 %.2f p90 %.2f p99 %.2f p99.9 %.2f max %.2f\n",
+            1000 * get_percentile (latencies, 0.5), 1000 * get_percentile (latencies, 0.9),
+            1000 * get_percentile (latencies, 0.99), 1000 * get_percentile (latencies, 0.999),
+            1000 * get_percentile (latencies, 1.0));
+    }
+    for (size_t i = 0; i < sessions.size (); i++)
+    {
+        delete sessions[i].board;
+    }
+    return res;
+}
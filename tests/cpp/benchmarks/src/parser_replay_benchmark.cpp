@@ -0,0 +1,134 @@
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board_shim.h"
+#include "packet_capture.h"
+
+#define NUM_PACKAGES 200000
+#define PACKAGE_SIZE 33
+#define SAMPLING_RATE 250
+#define RECORD_SIZE 4096
+
+
+void write_record (FILE *fp, double timestamp, int result, const char *data)
+{
+    PacketRecordHeader header;
+    header.timestamp = timestamp;
+    header.result = result;
+    header.size = (result > 0) ? (uint32_t)result : 0;
+    fwrite (&header, sizeof (header), 1, fp);
+    if (header.size > 0)
+    {
+        fwrite (data, 1, header.size, fp);
+    }
+}
+
+// capture of cyton serial port: responses for prepare_session and NUM_PACKAGES packages
+bool write_cyton_capture (const char *file)
+{
+    FILE *fp = fopen (file, "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    PacketCaptureHeader header;
+    memset (&header, 0, sizeof (header));
+    strcpy (header.magic, "BFCAP");
+    header.version = 1;
+    header.transport = (uint32_t)PacketTransports::STREAM;
+    fwrite (&header, sizeof (header), 1, fp);
+
+    std::string welcome = "OpenBCI V3 8-16 channel\nOn Board ADS1299 Device ID: 0x3E\n$$$";
+    std::string response = "Success: default$$$";
+    write_record (fp, 0.0, (int)welcome.size (), welcome.c_str ());
+    write_record (fp, 0.1, (int)response.size (), response.c_str ());
+    write_record (fp, 1.1, 0, "");
+
+    std::vector<char> data;
+    double timestamp = 2.0;
+    for (int i = 0; i < NUM_PACKAGES; i++)
+    {
+        unsigned char package[PACKAGE_SIZE] = {0};
+        package[0] = 0xA0;
+        package[1] = (unsigned char)i;
+        for (int channel = 0; channel < 8; channel++)
+        {
+            int value = (i * (channel + 1)) % 8388608;
+            package[2 + 3 * channel] = (unsigned char)(value >> 16);
+            package[3 + 3 * channel] = (unsigned char)(value >> 8);
+            package[4 + 3 * channel] = (unsigned char)value;
+        }
+        package[PACKAGE_SIZE - 1] = 0xC0;
+        data.insert (data.end (), package, package + PACKAGE_SIZE);
+        if ((data.size () + PACKAGE_SIZE > RECORD_SIZE) || (i == NUM_PACKAGES - 1))
+        {
+            write_record (fp, timestamp, (int)data.size (), data.data ());
+            timestamp += (double)data.size () / PACKAGE_SIZE / SAMPLING_RATE;
+            data.clear ();
+        }
+    }
+    fclose (fp);
+    return true;
+}
+
+int main (int argc, char *argv[])
+{
+    const char *file = "cyton_capture.bfcap";
+    // 0 replays as fast as possible
+    double rate = (argc > 1) ? atof (argv[1]) : 0.0;
+    if (!write_cyton_capture (file))
+    {
+        printf ("failed to write %s\n", file);
+        return -1;
+    }
+
+    int res = 0;
+    BoardShim::set_log_level ((int)LogLevels::LEVEL_WARN);
+    struct BrainFlowInputParams params;
+    params.serial_port = "replay";
+    BoardShim *board = new BoardShim ((int)BoardIds::CYTON_BOARD, params);
+    try
+    {
+        BoardShim::set_packet_capture ((int)PacketCaptureModes::REPLAY, file, rate);
+        board->prepare_session ();
+        auto start = std::chrono::high_resolution_clock::now ();
+        auto last_change = start;
+        board->start_stream (NUM_PACKAGES + 1000);
+        int count = 0;
+        // replay is done when there are no new packages for a while
+        while (std::chrono::high_resolution_clock::now () - last_change < std::chrono::seconds (1))
+        {
+            std::this_thread::sleep_for (std::chrono::milliseconds (1));
+            int new_count = board->get_board_data_count ();
+            if (new_count != count)
+            {
+                count = new_count;
+                last_change = std::chrono::high_resolution_clock::now ();
+            }
+        }
+        double seconds = std::chrono::duration<double> (last_change - start).count ();
+        board->stop_stream ();
+        board->release_session ();
+        printf ("rate %.1f: %d of %d packages in %.3f s, %.0f packages/s, %.1f MB/s\n", rate,
+            count, NUM_PACKAGES, seconds, count / seconds,
+            (double)count * PACKAGE_SIZE / seconds / (1024 * 1024));
+        if (count != NUM_PACKAGES)
+        {
+            res = -1;
+        }
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+    BoardShim::set_packet_capture ((int)PacketCaptureModes::NONE);
+    delete board;
+    remove (file);
+    return res;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+
+using namespace std;
+
+bool check_average (double **data, int *eeg_channels, int num_channels, int num_data_points);
+
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int res = 0;
+    int num_rows = BoardShim::get_num_rows (board_id);
+    int num_channels = 0;
+    int *eeg_channels = BoardShim::get_eeg_channels (board_id, &num_channels);
+
+    try
+    {
+        board->prepare_session ();
+        // eeg channels are re-referenced before packages go to ringbuffer
+        board->set_common_average_reference (true);
+        board->start_stream ();
+#ifdef _WIN32
+        Sleep (3000);
+#else
+        sleep (3);
+#endif
+        board->stop_stream ();
+
+        int num_data_points = 0;
+        double **data = board->get_board_data (&num_data_points);
+        if ((num_data_points == 0) ||
+            (!check_average (data, eeg_channels, num_channels, num_data_points)))
+        {
+            res = -1;
+        }
+        std::cout << "re-referenced data points: " << num_data_points << std::endl;
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+        delete[] data;
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (board->is_prepared ())
+        {
+            board->release_session ();
+        }
+    }
+
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
+
+bool check_average (double **data, int *eeg_channels, int num_channels, int num_data_points)
+{
+    // after common average reference eeg channels sum to zero in each package
+    for (int i = 0; i < num_data_points; i++)
+    {
+        double sum = 0.0;
+        double max_value = 0.0;
+        for (int j = 0; j < num_channels; j++)
+        {
+            sum += data[eeg_channels[j]][i];
+            max_value = std::max (max_value, fabs (data[eeg_channels[j]][i]));
+        }
+        if (fabs (sum) > 1e-9 * num_channels * (max_value + 1.0))
+        {
+            std::cout << "average is not zero at " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+
+using namespace std;
+
+void sleep_ms (int ms);
+
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int res = 0;
+
+    try
+    {
+        board->prepare_session ();
+        // realtime policy needs CAP_SYS_NICE or rtprio limit, if it fails acquisition still works
+        // and the reason is reported in errors
+        board->set_acquisition_thread_settings ((char *)"{\"cpus\": [0], \"policy\": \"fifo\", "
+                                                        "\"priority\": 10, \"name\": \"bf_eeg\"}");
+        board->start_stream ();
+        sleep_ms (1000);
+        std::cout << board->get_acquisition_thread_settings () << std::endl;
+        board->stop_stream ();
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (board->is_prepared ())
+        {
+            board->release_session ();
+        }
+    }
+
+    delete board;
+
+    return res;
+}
+
+void sleep_ms (int ms)
+{
+#ifdef _WIN32
+    Sleep (ms);
+#else
+    usleep (ms * 1000);
+#endif
+}
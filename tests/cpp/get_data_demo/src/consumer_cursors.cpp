@@ -0,0 +1,95 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+
+using namespace std;
+
+void sleep_ms (int ms);
+
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int res = 0;
+    int num_rows = BoardShim::get_num_rows (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        // recorder and classifier read the same stream independently
+        board->add_consumer_cursor ((char *)"recorder");
+        board->add_consumer_cursor ((char *)"classifier");
+        board->start_stream ();
+
+        int recorded = 0;
+        int classified = 0;
+        for (int i = 0; i < 5; i++)
+        {
+            sleep_ms (1000);
+            int num_data_points = 0;
+            int lost_samples = 0;
+            double **data =
+                board->get_cursor_data ((char *)"recorder", &num_data_points, &lost_samples);
+            recorded += num_data_points;
+            for (int j = 0; j < num_rows; j++)
+            {
+                delete[] data[j];
+            }
+            delete[] data;
+            // classifier is slower, it still gets all packages
+            if (i % 2 == 1)
+            {
+                data = board->get_cursor_data ((char *)"classifier", &num_data_points,
+                    &lost_samples);
+                classified += num_data_points;
+                for (int j = 0; j < num_rows; j++)
+                {
+                    delete[] data[j];
+                }
+                delete[] data;
+            }
+        }
+        board->stop_stream ();
+        std::cout << "recorder got " << recorded << " packages, classifier got " << classified
+                  << " packages and " << board->get_cursor_data_count ((char *)"classifier")
+                  << " are not read yet" << std::endl;
+        board->remove_consumer_cursor ((char *)"classifier");
+        board->remove_consumer_cursor ((char *)"recorder");
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (board->is_prepared ())
+        {
+            board->release_session ();
+        }
+    }
+
+    delete board;
+
+    return res;
+}
+
+void sleep_ms (int ms)
+{
+#ifdef _WIN32
+    Sleep (ms);
+#else
+    usleep (ms * 1000);
+#endif
+}
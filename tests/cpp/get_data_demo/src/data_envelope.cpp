@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+void print_envelope (double **envelope, int row, int num_rows, int num_points);
+int check_timestamps (double **envelope, int num_rows, int num_points, int timestamp_channel,
+    double *timestamps, int start, int end, int block_size, double tolerance);
+
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int res = 0;
+    int num_rows = BoardShim::get_num_rows (board_id);
+    int timestamp_channel = BoardShim::get_timestamp_channel (board_id);
+    int eeg_num_channels = 0;
+    int *eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+    int eeg_channel = eeg_channels[0];
+    delete[] eeg_channels;
+    int num_points = 0;
+    double **envelope = NULL;
+
+    try
+    {
+        board->prepare_session ();
+        // pyramid is built while data arrives, envelope of a long range reads only few blocks
+        board->set_buffer_summary (true);
+        board->start_stream (45000);
+#ifdef _WIN32
+        Sleep (5000);
+#else
+        sleep (5);
+#endif
+        board->stop_stream ();
+
+        int num_data_points = 0;
+        double **data = board->get_current_board_data (45000, &num_data_points);
+        double start_time = data[timestamp_channel][0];
+        double end_time = data[timestamp_channel][num_data_points - 1];
+        envelope = board->get_board_data_envelope (start_time, end_time, 10, &num_points);
+        std::cout << "envelope of " << num_data_points << " packages from board" << std::endl;
+        print_envelope (envelope, eeg_channel, num_rows, num_points);
+        // timestamps of envelope should match data, end_time itself is not included
+        if (check_timestamps (envelope, num_rows, num_points, timestamp_channel,
+                data[timestamp_channel], 0, num_data_points - 1, 1, 1e-9) != 0)
+        {
+            res = -1;
+        }
+        for (int i = 0; i < 3 * num_rows; i++)
+        {
+            delete[] envelope[i];
+        }
+        delete[] envelope;
+
+        // the same for recorded file, summary is created once and can be reused
+        DataFilter::write_file (data, num_rows, num_data_points, (char *)"envelope_test.csv",
+            (char *)"w");
+        DataFilter::create_file_summary (
+            (char *)"envelope_test.csv", (char *)"envelope_test.summary");
+        int file_rows = 0;
+        envelope = DataFilter::get_file_envelope ((char *)"envelope_test.summary", 0,
+            num_data_points, 10, &file_rows, &num_points);
+        std::cout << "envelope of " << num_data_points << " packages from file" << std::endl;
+        print_envelope (envelope, eeg_channel, file_rows, num_points);
+        // file has 6 digits after the point and edges are rounded to 16 packages
+        if (check_timestamps (envelope, file_rows, num_points, timestamp_channel,
+                data[timestamp_channel], 0, num_data_points, 16, 1e-5) != 0)
+        {
+            res = -1;
+        }
+        for (int i = 0; i < 3 * file_rows; i++)
+        {
+            delete[] envelope[i];
+        }
+        delete[] envelope;
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+        delete[] data;
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (board->is_prepared ())
+        {
+            board->release_session ();
+        }
+    }
+
+    delete board;
+
+    return res;
+}
+
+void print_envelope (double **envelope, int row, int num_rows, int num_points)
+{
+    for (int i = 0; i < num_points; i++)
+    {
+        std::cout << "min " << envelope[row][i] << " max " << envelope[num_rows + row][i]
+                  << " mean " << envelope[2 * num_rows + row][i] << std::endl;
+    }
+}
+
+// compares min and max of timestamp row with packages of each point, returns number of errors
+int check_timestamps (double **envelope, int num_rows, int num_points, int timestamp_channel,
+    double *timestamps, int start, int end, int block_size, double tolerance)
+{
+    int num_errors = 0;
+    end = (end / block_size) * block_size;
+    for (int i = 0; i < num_points; i++)
+    {
+        int point_start = start + (end - start) * i / num_points;
+        int point_end = start + (end - start) * (i + 1) / num_points;
+        point_start = (point_start / block_size) * block_size;
+        point_end = std::min (((point_end + block_size - 1) / block_size) * block_size, end);
+        double min_error = fabs (envelope[timestamp_channel][i] - timestamps[point_start]);
+        double max_error =
+            fabs (envelope[num_rows + timestamp_channel][i] - timestamps[point_end - 1]);
+        if ((min_error > tolerance) || (max_error > tolerance))
+        {
+            std::cout << "wrong timestamps for point " << i << ": min error " << min_error
+                      << " max error " << max_error << std::endl;
+            num_errors++;
+        }
+    }
+    return num_errors;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+
+using namespace std;
+
+void sleep_ms (int ms);
+
+
+int main (int argc, char *argv[])
+{
+    BoardShim::enable_dev_board_logger ();
+
+    // synthetic board streams to multicast group, several streaming boards read it
+    struct BrainFlowInputParams master_params;
+    BoardShim *master = new BoardShim ((int)BoardIds::SYNTHETIC_BOARD, master_params);
+    std::vector<BoardShim *> readers;
+    int num_readers = 8;
+    int res = 0;
+
+    try
+    {
+        // all readers share one thread instead of a thread per session
+        BoardShim::set_shared_reactor_threads (1);
+        for (int i = 0; i < num_readers; i++)
+        {
+            struct BrainFlowInputParams params;
+            params.ip_address = "225.1.1.1";
+            params.ip_port = 6677;
+            params.other_info = std::to_string ((int)BoardIds::SYNTHETIC_BOARD);
+            // the same params would be the same session, streaming board doesnt use mac address
+            params.mac_address = "reader_" + std::to_string (i);
+            readers.push_back (new BoardShim ((int)BoardIds::STREAMING_BOARD, params));
+            readers[i]->prepare_session ();
+            readers[i]->start_stream ();
+        }
+        master->prepare_session ();
+        master->start_stream (45000, (char *)"streaming_board://225.1.1.1:6677");
+        sleep_ms (5000);
+        master->stop_stream ();
+        master->release_session ();
+        sleep_ms (100);
+
+        for (int i = 0; i < num_readers; i++)
+        {
+            readers[i]->stop_stream ();
+            std::cout << "reader " << i << " got " << readers[i]->get_board_data_count ()
+                      << " packages" << std::endl;
+            readers[i]->release_session ();
+        }
+        BoardShim::set_shared_reactor_threads (0);
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (master->is_prepared ())
+        {
+            master->release_session ();
+        }
+        for (size_t i = 0; i < readers.size (); i++)
+        {
+            if (readers[i]->is_prepared ())
+            {
+                readers[i]->release_session ();
+            }
+        }
+    }
+
+    delete master;
+    for (size_t i = 0; i < readers.size (); i++)
+    {
+        delete readers[i];
+    }
+
+    return res;
+}
+
+void sleep_ms (int ms)
+{
+#ifdef _WIN32
+    Sleep (ms);
+#else
+    usleep (ms * 1000);
+#endif
+}
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+
+using namespace std;
+
+bool check_package_nums (double **data, int package_num_channel, int num_data_points);
+
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int res = 0;
+    int num_rows = BoardShim::get_num_rows (board_id);
+    int package_num_channel = BoardShim::get_package_num_channel (board_id);
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        // keep only one second of data in RAM, older packages are moved to the file
+        board->set_buffer_spill_file ((char *)"spill_buffer_test.bin", sampling_rate);
+        board->start_stream (sampling_rate * 3600);
+#ifdef _WIN32
+        Sleep (5000);
+#else
+        sleep (5);
+#endif
+        board->stop_stream ();
+        // spill thread should keep up with synthetic board
+        int num_dropped = board->get_dropped_data_count ();
+        std::cout << "dropped data points: " << num_dropped << std::endl;
+        if (num_dropped != 0)
+        {
+            res = -1;
+        }
+
+        // latest 4 seconds are read from both RAM and spill file
+        int num_data_points = 0;
+        double **data = board->get_current_board_data (sampling_rate * 4, &num_data_points);
+        if (!check_package_nums (data, package_num_channel, num_data_points))
+        {
+            res = -1;
+        }
+        std::cout << "current data points: " << num_data_points << std::endl;
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+        delete[] data;
+
+        data = board->get_board_data (&num_data_points);
+        if (!check_package_nums (data, package_num_channel, num_data_points))
+        {
+            res = -1;
+        }
+        std::cout << "board data points: " << num_data_points << std::endl;
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+        delete[] data;
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+        if (board->is_prepared ())
+        {
+            board->release_session ();
+        }
+    }
+
+    delete board;
+
+    return res;
+}
+
+bool check_package_nums (double **data, int package_num_channel, int num_data_points)
+{
+    // synthetic board increments package num for each package, so there should be no gaps
+    for (int i = 1; i < num_data_points; i++)
+    {
+        int expected = ((int)data[package_num_channel][i - 1] + 1) % 256;
+        if ((int)data[package_num_channel][i] != expected)
+        {
+            std::cout << "package num mismatch at " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
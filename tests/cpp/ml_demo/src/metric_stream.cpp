@@ -0,0 +1,74 @@
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "ml_model.h"
+
+using namespace std;
+
+
+int main (int argc, char *argv[])
+{
+    BoardShim::enable_dev_board_logger ();
+
+    struct BrainFlowInputParams params;
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+    BoardShim *board = new BoardShim (board_id, params);
+    int *eeg_channels = NULL;
+    int res = 0;
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+
+        int sampling_rate = BoardShim::get_sampling_rate (board_id);
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+
+        struct BrainFlowModelParams model_params (
+            (int)BrainFlowMetrics::CONCENTRATION, (int)BrainFlowClassifiers::REGRESSION);
+        MLModel model (model_params);
+        model.prepare ();
+        // score for the latest 4 seconds every 500 ms, first scores appear when there is enough
+        // data in the board buffer
+        model.start_metric_stream (
+            board_id, params, eeg_channels, eeg_num_channels, sampling_rate * 4, 500);
+        for (int i = 0; i < 10; i++)
+        {
+#ifdef _WIN32
+            Sleep (1000);
+#else
+            sleep (1);
+#endif
+            double scores[10];
+            double timestamps[10];
+            int num_scores = model.get_metric_stream_scores (scores, timestamps, 10);
+            for (int j = 0; j < num_scores; j++)
+            {
+                std::cout << std::fixed << timestamps[j] << " Concentration: " << scores[j]
+                          << std::endl;
+            }
+        }
+        model.stop_metric_stream ();
+        model.release ();
+
+        board->stop_stream ();
+        board->release_session ();
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
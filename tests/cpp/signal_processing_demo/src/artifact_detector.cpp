@@ -0,0 +1,98 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int *eeg_channels = NULL;
+    int num_rows = 0;
+    int res = 0;
+    int detector_id = -1;
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+        num_rows = BoardShim::get_num_rows (board_id);
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+        // half second window, flag datapoints with huge amplitude or flatline, no line noise check
+        detector_id = DataFilter::create_artifact_detector (eeg_num_channels, sampling_rate,
+            sampling_rate / 2, 1000.0, 0.01, 0.0, 0.0, 0.0, true);
+
+        int total_flagged = 0;
+        for (int i = 0; i < 5; i++)
+        {
+#ifdef _WIN32
+            Sleep (1000);
+#else
+            sleep (1);
+#endif
+            int data_count = 0;
+            double **data = board->get_board_data (&data_count);
+            // inject a spike into the first channel, it will be replaced by mean of other channels
+            if (data_count > 0)
+            {
+                data[eeg_channels[0]][data_count / 2] += 5000.0;
+            }
+            int *flags = DataFilter::update_artifact_detector (
+                detector_id, data, data_count, eeg_channels, eeg_num_channels);
+            int flagged = 0;
+            for (int j = 0; j < data_count * eeg_num_channels; j++)
+            {
+                if (flags[j] != (int)ArtifactTypes::NO_ARTIFACT)
+                {
+                    flagged++;
+                }
+            }
+            std::cout << "flagged datapoints: " << flagged << " of "
+                      << data_count * eeg_num_channels << std::endl;
+            total_flagged += flagged;
+            delete[] flags;
+            for (int j = 0; j < num_rows; j++)
+            {
+                delete[] data[j];
+            }
+            delete[] data;
+        }
+        board->stop_stream ();
+        board->release_session ();
+        // fail test if spikes were not detected
+        if (total_flagged == 0)
+        {
+            res = -1;
+        }
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    if (detector_id >= 0)
+    {
+        DataFilter::release_artifact_detector (detector_id);
+    }
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
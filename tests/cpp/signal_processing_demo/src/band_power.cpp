@@ -62,6 +62,29 @@ int main (int argc, char *argv[])
         {
             res = -1;
         }
+        // the same bands in a single call
+        double freq_starts[2] = {7.0, 14.0};
+        double freq_ends[2] = {13.0, 30.0};
+        double *band_powers =
+            DataFilter::get_band_powers (psd, fft_len / 2 + 1, freq_starts, freq_ends, 2);
+        if ((band_powers[0] != band_power_alpha) || (band_powers[1] != band_power_beta))
+        {
+            res = -1;
+        }
+        delete[] band_powers;
+        // multitaper psd for the last 2 seconds, time-halfbandwidth product 4 and 7 tapers
+        int window_len = 2 * sampling_rate;
+        std::pair<double *, double *> mt_psd = DataFilter::get_psd_multitaper (
+            data[channel] + data_count - window_len, window_len, sampling_rate, 4.0, 7);
+        double mt_alpha = DataFilter::get_band_power (mt_psd, window_len / 2 + 1, 7.0, 13.0);
+        double mt_beta = DataFilter::get_band_power (mt_psd, window_len / 2 + 1, 14.0, 30.0);
+        std::cout << "multitaper alpha/beta:" << mt_alpha / mt_beta << std::endl;
+        if (mt_alpha / mt_beta < 10)
+        {
+            res = -1;
+        }
+        delete[] mt_psd.first;
+        delete[] mt_psd.second;
         delete[] psd.first;
         delete[] psd.second;
     }
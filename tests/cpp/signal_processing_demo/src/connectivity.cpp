@@ -0,0 +1,94 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    double **data = NULL;
+    int *eeg_channels = NULL;
+    int num_rows = 0;
+    int res = 0;
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+        BoardShim::log_message ((int)LogLevels::LEVEL_INFO, "Start sleeping in the main thread");
+#ifdef _WIN32
+        Sleep (5000);
+#else
+        sleep (5);
+#endif
+
+        board->stop_stream ();
+        int data_count = 0;
+        data = board->get_board_data (&data_count);
+        board->release_session ();
+        num_rows = BoardShim::get_num_rows (board_id);
+
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+        // 1 second windows with 50% overlap
+        double *coherence = DataFilter::get_coherence (data, data_count, eeg_channels,
+            eeg_num_channels, sampling_rate, sampling_rate / 2, sampling_rate,
+            (int)WindowFunctions::HANNING, 8.0, 13.0);
+        double *covariance =
+            DataFilter::get_covariance_matrix (data, data_count, eeg_channels, eeg_num_channels);
+        for (int i = 0; i < eeg_num_channels; i++)
+        {
+            for (int j = 0; j < eeg_num_channels; j++)
+            {
+                std::cout << coherence[i * eeg_num_channels + j] << " ";
+            }
+            std::cout << std::endl;
+        }
+        for (int i = 0; i < eeg_num_channels; i++)
+        {
+            // channel is fully coherent with itself and has positive variance
+            double self_coherence = coherence[i * eeg_num_channels + i];
+            if ((self_coherence < 0.99) || (self_coherence > 1.01) ||
+                (covariance[i * eeg_num_channels + i] <= 0))
+            {
+                res = -1;
+            }
+        }
+        delete[] coherence;
+        delete[] covariance;
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    if (data != NULL)
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+    }
+    delete[] data;
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    double **data = NULL;
+    int *eeg_channels = NULL;
+    int num_rows = 0;
+    int res = 0;
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+        for (int i = 1; i < 6; i++)
+        {
+#ifdef _WIN32
+            Sleep (1000);
+#else
+            sleep (1);
+#endif
+            board->insert_marker (i);
+        }
+#ifdef _WIN32
+        Sleep (1000);
+#else
+        sleep (1);
+#endif
+        board->stop_stream ();
+        int data_count = 0;
+        data = board->get_board_data (&data_count);
+        board->release_session ();
+        num_rows = BoardShim::get_num_rows (board_id);
+
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+        int marker_channel = BoardShim::get_marker_channel (board_id);
+        // 200 ms before marker and 500 ms after, baseline is the mean of pre-marker datapoints
+        int pre_samples = sampling_rate / 5;
+        int post_samples = sampling_rate / 2;
+        int num_epochs = 0;
+        std::pair<double *, double *> epochs = DataFilter::get_epochs (data, data_count,
+            marker_channel, eeg_channels, eeg_num_channels, pre_samples, post_samples, true,
+            &num_epochs);
+        std::cout << "found " << num_epochs << " epochs" << std::endl;
+        int epoch_len = pre_samples + post_samples;
+        for (int i = 0; i < num_epochs; i++)
+        {
+            // first channel of each epoch
+            double *first_channel = epochs.first + i * eeg_num_channels * epoch_len;
+            std::cout << "marker " << epochs.second[i] << ": ";
+            for (int j = 0; j < 5; j++)
+            {
+                std::cout << first_channel[j] << ",";
+            }
+            std::cout << std::endl;
+        }
+        // fail test if markers are lost
+        if (num_epochs != 5)
+        {
+            res = -1;
+        }
+        delete[] epochs.first;
+        delete[] epochs.second;
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    if (data != NULL)
+    {
+        for (int i = 0; i < num_rows; i++)
+        {
+            delete[] data[i];
+        }
+    }
+    delete[] data;
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
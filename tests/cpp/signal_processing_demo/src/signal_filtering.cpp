@@ -83,6 +83,30 @@ int main (int argc, char *argv[])
         }
         std::cout << std::endl << "Data after processing" << std::endl << std::endl;
         print_head (data, num_rows, data_count);
+
+        // spatial filters work across channels, common average reference is inplace
+        DataFilter::perform_common_average_reference (
+            data, data_count, eeg_channels, eeg_num_channels);
+        // bipolar derivation of first two channels as a spatial filter with a single output
+        double *bipolar_filter = new double[eeg_num_channels];
+        for (int i = 0; i < eeg_num_channels; i++)
+        {
+            bipolar_filter[i] = 0.0;
+        }
+        bipolar_filter[0] = 1.0;
+        bipolar_filter[1] = -1.0;
+        double *bipolar = DataFilter::apply_spatial_filter (
+            bipolar_filter, 1, data, data_count, eeg_channels, eeg_num_channels);
+        std::cout << std::endl << "Data after common average reference" << std::endl << std::endl;
+        print_head (data, num_rows, data_count);
+        std::cout << "Bipolar derivation: ";
+        for (int i = 0; i < ((data_count < 5) ? data_count : 5); i++)
+        {
+            std::cout << bipolar[i] << ",";
+        }
+        std::cout << std::endl;
+        delete[] bipolar_filter;
+        delete[] bipolar;
     }
     catch (const BrainFlowException &err)
     {
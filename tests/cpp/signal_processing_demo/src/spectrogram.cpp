@@ -0,0 +1,109 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int *eeg_channels = NULL;
+    int num_rows = 0;
+    int res = 0;
+    int spectrogram_id = -1;
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+        num_rows = BoardShim::get_num_rows (board_id);
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+
+        // 1 second window, new column every 0.25 seconds
+        spectrogram_id = DataFilter::create_spectrogram (eeg_num_channels, sampling_rate,
+            sampling_rate / 4, sampling_rate, (int)WindowFunctions::HANNING, false);
+
+        int total_columns = 0;
+        for (int i = 0; i < 10; i++)
+        {
+#ifdef _WIN32
+            Sleep (1000);
+#else
+            sleep (1);
+#endif
+            int data_count = 0;
+            double **data = board->get_board_data (&data_count);
+            int num_columns = 0;
+            int num_bins = 0;
+            // only new datapoints are processed
+            double *columns = DataFilter::update_spectrogram (spectrogram_id, data, data_count,
+                eeg_channels, eeg_num_channels, &num_columns, &num_bins);
+            if (num_columns > 0)
+            {
+                // for synthetic board second channel is a sine wave at 10 Hz
+                int offset = ((num_columns - 1) * eeg_num_channels + 1) * num_bins;
+                double *last_column = columns + offset;
+                int peak = 0;
+                for (int j = 0; j < num_bins; j++)
+                {
+                    if (last_column[j] > last_column[peak])
+                    {
+                        peak = j;
+                    }
+                }
+                // nfft is equal to sampling rate, so resolution is 1 Hz
+                double peak_freq = (double)peak;
+                std::cout << "new columns: " << num_columns << " peak freq: " << peak_freq
+                          << std::endl;
+                if ((peak_freq < 9.0) || (peak_freq > 11.0))
+                {
+                    res = -1;
+                }
+            }
+            total_columns += num_columns;
+            delete[] columns;
+            for (int j = 0; j < num_rows; j++)
+            {
+                delete[] data[j];
+            }
+            delete[] data;
+        }
+        board->stop_stream ();
+        board->release_session ();
+        // fail test if no columns were emitted
+        if (total_columns == 0)
+        {
+            res = -1;
+        }
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    if (spectrogram_id >= 0)
+    {
+        DataFilter::release_spectrogram (spectrogram_id);
+    }
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
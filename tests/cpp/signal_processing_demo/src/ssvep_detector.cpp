@@ -0,0 +1,92 @@
+#include <iostream>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "board_shim.h"
+#include "data_filter.h"
+
+using namespace std;
+
+int main (int argc, char *argv[])
+{
+    struct BrainFlowInputParams params;
+    // use synthetic board for demo
+    int board_id = (int)BoardIds::SYNTHETIC_BOARD;
+
+    BoardShim::enable_dev_board_logger ();
+
+    BoardShim *board = new BoardShim (board_id, params);
+    int *eeg_channels = NULL;
+    int num_rows = 0;
+    int res = 0;
+    int detector_id = -1;
+    int sampling_rate = BoardShim::get_sampling_rate (board_id);
+
+    try
+    {
+        board->prepare_session ();
+        board->start_stream ();
+        num_rows = BoardShim::get_num_rows (board_id);
+        int eeg_num_channels = 0;
+        eeg_channels = BoardShim::get_eeg_channels (board_id, &eeg_num_channels);
+        // for synthetic board second channel is a sine wave at 10 Hz
+        int channel = eeg_channels[1];
+        double target_freqs[4] = {8.0, 10.0, 12.0, 15.0};
+        // 2 harmonics, scores are calculated over the last second
+        detector_id =
+            DataFilter::create_ssvep_detector (1, sampling_rate, target_freqs, 4, 2, sampling_rate);
+
+        double scores[4] = {0.0, 0.0, 0.0, 0.0};
+        for (int i = 0; i < 5; i++)
+        {
+#ifdef _WIN32
+            Sleep (1000);
+#else
+            sleep (1);
+#endif
+            int data_count = 0;
+            double **data = board->get_board_data (&data_count);
+            // only new datapoints are processed
+            DataFilter::update_ssvep_detector (detector_id, data, data_count, &channel, 1, scores);
+            for (int j = 0; j < 4; j++)
+            {
+                std::cout << target_freqs[j] << " Hz: " << scores[j] << " ";
+            }
+            std::cout << std::endl;
+            for (int j = 0; j < num_rows; j++)
+            {
+                delete[] data[j];
+            }
+            delete[] data;
+        }
+        board->stop_stream ();
+        board->release_session ();
+        // fail test if 10 Hz is not detected
+        for (int j = 0; j < 4; j++)
+        {
+            if (scores[j] > scores[1])
+            {
+                res = -1;
+            }
+        }
+    }
+    catch (const BrainFlowException &err)
+    {
+        BoardShim::log_message ((int)LogLevels::LEVEL_ERROR, err.what ());
+        res = err.exit_code;
+    }
+
+    if (detector_id >= 0)
+    {
+        DataFilter::release_ssvep_detector (detector_id);
+    }
+    delete[] eeg_channels;
+    delete board;
+
+    return res;
+}
@@ -91,7 +91,7 @@ int main (int argc, char *argv[])
             delete[] wavelet_output.second;
 
             // demo for fft
-            // data count must be power of 2 for fft!
+            // any data count works, sizes with prime factors 2, 3 and 5 are the fastest
             std::complex<double> *fft_data = DataFilter::perform_fft (
                 data[eeg_channels[i]], data_count, (int)WindowFunctions::NO_WINDOW);
             // len of fft_data array is N / 2 + 1
@@ -107,6 +107,17 @@ int main (int argc, char *argv[])
 
             delete[] fft_data;
             delete[] restored_from_fft_data;
+
+            // demo for hilbert transform, phase is in radians
+            std::pair<double *, double *> hilbert_data =
+                DataFilter::perform_hilbert_transform (data[eeg_channels[i]], data_count);
+            std::cout << "Envelope:" << std::endl;
+            print_one_row (hilbert_data.first, data_count);
+            std::cout << "Instantaneous phase:" << std::endl;
+            print_one_row (hilbert_data.second, data_count);
+
+            delete[] hilbert_data.first;
+            delete[] hilbert_data.second;
         }
     }
     catch (const BrainFlowException &err)
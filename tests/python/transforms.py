@@ -41,10 +41,9 @@ def main():
         print('Restored data after wavelet transform for channel %d:' % channel)
         print(restored_data)
 
-        # demo for fft, len of data must be a power of 2
+        # demo for fft, len of fft_data is N / 2 + 1, so perform_ifft needs N for odd lengths
         fft_data = DataFilter.perform_fft(data[channel], WindowFunctions.NO_WINDOW.value)
-        # len of fft_data is N / 2 + 1
-        restored_fft_data = DataFilter.perform_ifft(fft_data)
+        restored_fft_data = DataFilter.perform_ifft(fft_data, data[channel].shape[0])
         print('Restored data after fft for channel %d:' % channel)
         print(restored_fft_data)
 